@@ -0,0 +1,567 @@
+/*
+ * SUM Chain Host Library - APDU Client Implementation
+ */
+
+#include "apdu_client.h"
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <poll.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+
+/*
+ * Frame building
+ */
+
+size_t apdu_serialize_path(const bip32_path_t *path, uint8_t *out, size_t out_len) {
+    if (path == NULL || out == NULL ||
+        path->length == 0 || path->length > MAX_BIP32_PATH_LEN) {
+        return 0;
+    }
+
+    size_t required = 1 + (size_t)path->length * 4;
+    if (out_len < required) {
+        return 0;
+    }
+
+    out[0] = path->length;
+    if (path->scheme == PATH_SCHEME_BIP32_ED25519) {
+        out[0] |= PATH_LEN_FLAG_BIP32_ED25519;
+    }
+    for (uint8_t i = 0; i < path->length; i++) {
+        uint8_t *p = &out[1 + i * 4];
+        p[0] = (uint8_t)(path->path[i] >> 24);
+        p[1] = (uint8_t)(path->path[i] >> 16);
+        p[2] = (uint8_t)(path->path[i] >> 8);
+        p[3] = (uint8_t)(path->path[i]);
+    }
+
+    return required;
+}
+
+bool apdu_frame_build(apdu_frame_t *frame, uint8_t cla, uint8_t ins, uint8_t p1, uint8_t p2,
+                      const uint8_t *data, size_t lc) {
+    if (frame == NULL || lc > APDU_MAX_DATA_LEN || (data == NULL && lc > 0)) {
+        return false;
+    }
+
+    frame->bytes[0] = cla;
+    frame->bytes[1] = ins;
+    frame->bytes[2] = p1;
+    frame->bytes[3] = p2;
+    frame->bytes[4] = (uint8_t)lc;
+    if (lc > 0) {
+        memcpy(&frame->bytes[APDU_HEADER_LEN], data, lc);
+    }
+    frame->len = APDU_HEADER_LEN + lc;
+
+    return true;
+}
+
+bool apdu_sign_tx_plan_init(apdu_sign_tx_plan_t *plan, const bip32_path_t *path,
+                            const uint8_t *tx, size_t tx_len, size_t tx_offset) {
+    if (plan == NULL || path == NULL || (tx == NULL && tx_len > 0) || tx_offset > tx_len) {
+        return false;
+    }
+
+    memset(plan, 0, sizeof(*plan));
+    plan->path_len = apdu_serialize_path(path, plan->path_buf, sizeof(plan->path_buf));
+    if (plan->path_len == 0) {
+        return false;
+    }
+    plan->tx = tx;
+    plan->tx_len = tx_len;
+    plan->ins = INS_SIGN_TX;
+
+    if (tx_offset == 0) {
+        /* Fill the first APDU with the path and as many tx bytes as fit */
+        size_t room = APDU_MAX_DATA_LEN - plan->path_len;
+        plan->with_path = true;
+        plan->first_take = (tx_len < room) ? tx_len : room;
+        plan->cont_offset = plan->first_take;
+        plan->frame_count = 1 + (tx_len - plan->first_take + APDU_MAX_DATA_LEN - 1) / APDU_MAX_DATA_LEN;
+    } else {
+        /* Resume: continuation frames only, at least one to close the session */
+        size_t remaining = tx_len - tx_offset;
+        plan->with_path = false;
+        plan->cont_offset = tx_offset;
+        plan->frame_count = (remaining + APDU_MAX_DATA_LEN - 1) / APDU_MAX_DATA_LEN;
+        if (plan->frame_count == 0) {
+            plan->frame_count = 1;
+        }
+    }
+
+    return true;
+}
+
+bool apdu_sign_tx_plan_frame(const apdu_sign_tx_plan_t *plan, size_t index, apdu_frame_t *frame) {
+    if (plan == NULL || frame == NULL || index >= plan->frame_count) {
+        return false;
+    }
+
+    uint8_t p2 = (index + 1 == plan->frame_count) ? P2_LAST_CHUNK : P2_MORE_CHUNKS;
+
+    if (plan->with_path && index == 0) {
+        if (!apdu_frame_build(frame, CLA_SUMCHAIN, plan->ins, P1_FIRST_CHUNK, p2,
+                              plan->path_buf, plan->path_len)) {
+            return false;
+        }
+        if (plan->first_take > 0) {
+            memcpy(&frame->bytes[frame->len], plan->tx, plan->first_take);
+        }
+        frame->len += plan->first_take;
+        frame->bytes[4] = (uint8_t)(plan->path_len + plan->first_take);
+        return true;
+    }
+
+    size_t cont_index = plan->with_path ? index - 1 : index;
+    size_t offset = plan->cont_offset + cont_index * APDU_MAX_DATA_LEN;
+    size_t take = plan->tx_len - offset;
+    if (take > APDU_MAX_DATA_LEN) {
+        take = APDU_MAX_DATA_LEN;
+    }
+
+    return apdu_frame_build(frame, CLA_SUMCHAIN, plan->ins, P1_MORE_CHUNK, p2,
+                            plan->tx + offset, take);
+}
+
+/*
+ * TCP (Speculos) transport
+ */
+
+static int tcp_send(apdu_transport_t *base, const uint8_t *apdu, size_t len) {
+    apdu_transport_tcp_t *t = (apdu_transport_tcp_t *)base;
+    uint8_t buf[4 + APDU_MAX_FRAME_LEN];
+
+    if (len > APDU_MAX_FRAME_LEN) {
+        return -1;
+    }
+
+    buf[0] = (uint8_t)(len >> 24);
+    buf[1] = (uint8_t)(len >> 16);
+    buf[2] = (uint8_t)(len >> 8);
+    buf[3] = (uint8_t)(len);
+    memcpy(&buf[4], apdu, len);
+
+    t->rx_len = 0;
+
+    size_t sent = 0;
+    while (sent < 4 + len) {
+        ssize_t n = send(t->sock, &buf[sent], 4 + len - sent, MSG_NOSIGNAL);
+        if (n > 0) {
+            sent += (size_t)n;
+        } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+            struct pollfd pfd = { .fd = t->sock, .events = POLLOUT };
+            if (poll(&pfd, 1, -1) < 0 && errno != EINTR) {
+                return -1;
+            }
+        } else {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+static int tcp_recv(apdu_transport_t *base, uint8_t *resp, size_t resp_cap, size_t *resp_len) {
+    apdu_transport_tcp_t *t = (apdu_transport_tcp_t *)base;
+
+    for (;;) {
+        /* Header first, then exactly data + SW */
+        size_t want = 4;
+        if (t->rx_len >= 4) {
+            size_t data_len = ((size_t)t->rx[0] << 24) | ((size_t)t->rx[1] << 16) |
+                              ((size_t)t->rx[2] << 8) | (size_t)t->rx[3];
+            if (data_len + 2 > APDU_MAX_RESP_LEN) {
+                return -1;
+            }
+            want = 4 + data_len + 2;
+        }
+
+        if (t->rx_len == want && want > 4) {
+            size_t total = want - 4;
+            if (total > resp_cap) {
+                return -1;
+            }
+            memcpy(resp, &t->rx[4], total);
+            *resp_len = total;
+            t->rx_len = 0;
+            return 1;
+        }
+
+        ssize_t n = recv(t->sock, &t->rx[t->rx_len], want - t->rx_len, 0);
+        if (n > 0) {
+            t->rx_len += (size_t)n;
+        } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+            return 0;
+        } else {
+            return -1;     /* Peer closed or hard error */
+        }
+    }
+}
+
+static int tcp_fd(apdu_transport_t *base) {
+    return ((apdu_transport_tcp_t *)base)->sock;
+}
+
+static void tcp_close(apdu_transport_t *base) {
+    apdu_transport_tcp_t *t = (apdu_transport_tcp_t *)base;
+    if (t->sock >= 0) {
+        close(t->sock);
+        t->sock = -1;
+    }
+}
+
+int apdu_transport_tcp_open(apdu_transport_tcp_t *t, const char *host, uint16_t port) {
+    struct addrinfo hints;
+    struct addrinfo *res = NULL;
+    char port_str[8];
+
+    if (t == NULL || host == NULL) {
+        return -1;
+    }
+
+    memset(t, 0, sizeof(*t));
+    t->sock = -1;
+    t->base.send = tcp_send;
+    t->base.recv = tcp_recv;
+    t->base.fd = tcp_fd;
+    t->base.close = tcp_close;
+
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    snprintf(port_str, sizeof(port_str), "%u", (unsigned)port);
+    if (getaddrinfo(host, port_str, &hints, &res) != 0) {
+        return -1;
+    }
+
+    for (struct addrinfo *ai = res; ai != NULL; ai = ai->ai_next) {
+        int s = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+        if (s < 0) {
+            continue;
+        }
+        if (connect(s, ai->ai_addr, ai->ai_addrlen) == 0) {
+            t->sock = s;
+            break;
+        }
+        close(s);
+    }
+    freeaddrinfo(res);
+
+    if (t->sock < 0) {
+        return -1;
+    }
+
+    /* Small frames, strict request/response: never wait for coalescing */
+    int one = 1;
+    setsockopt(t->sock, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    fcntl(t->sock, F_SETFL, fcntl(t->sock, F_GETFL, 0) | O_NONBLOCK);
+
+    return 0;
+}
+
+/*
+ * Requests and devices
+ */
+
+bool apdu_request_init_sign_tx(apdu_request_t *req, const bip32_path_t *path,
+                               const uint8_t *tx, size_t tx_len, size_t tx_offset,
+                               apdu_done_cb_t done, void *user) {
+    if (req == NULL) {
+        return false;
+    }
+
+    memset(req, 0, sizeof(*req));
+    req->is_sign_tx = true;
+    req->done = done;
+    req->user = user;
+
+    return apdu_sign_tx_plan_init(&req->plan, path, tx, tx_len, tx_offset);
+}
+
+bool apdu_request_init_sign_merkle(apdu_request_t *req, const bip32_path_t *path,
+                                   const uint8_t *stream, size_t stream_len,
+                                   size_t stream_offset,
+                                   apdu_done_cb_t done, void *user) {
+    if (!apdu_request_init_sign_tx(req, path, stream, stream_len, stream_offset, done, user)) {
+        return false;
+    }
+
+    req->plan.ins = INS_SIGN_MERKLE;
+    return true;
+}
+
+bool apdu_parse_resume(const uint8_t *resp, size_t len, uint8_t *kind, size_t *offset) {
+    if (resp == NULL || kind == NULL || offset == NULL || len != RESUME_RESPONSE_LEN ||
+        resp[0] > RESUME_KIND_SIGN_MERKLE) {
+        return false;
+    }
+
+    *kind = resp[0];
+    *offset = ((size_t)resp[1] << 24) | ((size_t)resp[2] << 16) |
+              ((size_t)resp[3] << 8) | (size_t)resp[4];
+    return true;
+}
+
+bool apdu_request_init_raw(apdu_request_t *req, uint8_t ins, uint8_t p1, uint8_t p2,
+                           const uint8_t *data, size_t lc,
+                           apdu_done_cb_t done, void *user) {
+    if (req == NULL) {
+        return false;
+    }
+
+    memset(req, 0, sizeof(*req));
+    req->done = done;
+    req->user = user;
+
+    return apdu_frame_build(&req->single, CLA_SUMCHAIN, ins, p1, p2, data, lc);
+}
+
+static size_t request_frame_count(const apdu_request_t *req) {
+    return req->is_sign_tx ? req->plan.frame_count : 1;
+}
+
+static bool request_frame(const apdu_request_t *req, size_t index, apdu_frame_t *frame) {
+    if (req->is_sign_tx) {
+        return apdu_sign_tx_plan_frame(&req->plan, index, frame);
+    }
+    if (index != 0) {
+        return false;
+    }
+    *frame = req->single;
+    return true;
+}
+
+void apdu_device_init(apdu_device_t *dev, apdu_transport_t *transport) {
+    if (dev == NULL) {
+        return;
+    }
+    memset(dev, 0, sizeof(*dev));
+    dev->transport = transport;
+}
+
+bool apdu_device_idle(const apdu_device_t *dev) {
+    return dev == NULL || dev->head == NULL;
+}
+
+/* Pop the head request and run its callback */
+static void device_complete_head(apdu_device_t *dev, apdu_status_t status) {
+    apdu_request_t *req = dev->head;
+
+    dev->head = req->next;
+    if (dev->head == NULL) {
+        dev->tail = NULL;
+    }
+    dev->in_flight = false;
+
+    req->next = NULL;
+    req->status = status;
+    if (req->done != NULL) {
+        req->done(req, req->user);
+    }
+}
+
+/* Fail everything queued on a device whose transport broke */
+static void device_fail_all(apdu_device_t *dev) {
+    dev->failed = true;
+    while (dev->head != NULL) {
+        device_complete_head(dev, APDU_STATUS_TRANSPORT_ERROR);
+    }
+}
+
+void apdu_device_submit(apdu_device_t *dev, apdu_request_t *req) {
+    if (dev == NULL || req == NULL) {
+        return;
+    }
+
+    req->status = APDU_STATUS_PENDING;
+    req->next_frame = 0;
+    req->next = NULL;
+
+    if (dev->failed || dev->transport == NULL) {
+        req->status = APDU_STATUS_TRANSPORT_ERROR;
+        if (req->done != NULL) {
+            req->done(req, req->user);
+        }
+        return;
+    }
+
+    if (dev->tail != NULL) {
+        dev->tail->next = req;
+    } else {
+        dev->head = req;
+    }
+    dev->tail = req;
+}
+
+/* Send the next frame of the head request */
+static void device_send_next(apdu_device_t *dev) {
+    while (dev->head != NULL && !dev->in_flight) {
+        apdu_request_t *req = dev->head;
+
+        if (!request_frame(req, req->next_frame, &dev->frame)) {
+            device_complete_head(dev, APDU_STATUS_SW_ERROR);
+            continue;
+        }
+        if (dev->transport->send(dev->transport, dev->frame.bytes, dev->frame.len) != 0) {
+            device_fail_all(dev);
+            return;
+        }
+        dev->in_flight = true;
+    }
+}
+
+/* Handle a complete response for the head request */
+static void device_on_response(apdu_device_t *dev, const uint8_t *resp, size_t resp_len) {
+    apdu_request_t *req = dev->head;
+
+    dev->in_flight = false;
+    dev->exchanges++;
+
+    if (resp_len < 2) {
+        device_fail_all(dev);
+        return;
+    }
+
+    req->sw = (uint16_t)((resp[resp_len - 2] << 8) | resp[resp_len - 1]);
+    req->resp_len = resp_len - 2;
+    memcpy(req->resp, resp, req->resp_len);
+    req->next_frame++;
+
+    if (req->sw != SW_OK) {
+        device_complete_head(dev, APDU_STATUS_SW_ERROR);
+    } else if (req->next_frame >= request_frame_count(req)) {
+        device_complete_head(dev, APDU_STATUS_OK);
+    }
+
+    /* Chain the next frame (or next request) without returning to the caller */
+    device_send_next(dev);
+}
+
+int apdu_client_poll(apdu_device_t *const *devs, size_t n, int timeout_ms) {
+    struct pollfd pfds[64];
+    size_t pfd_dev[64];
+    size_t npfd = 0;
+    bool direct = false;
+
+    if (devs == NULL) {
+        return -1;
+    }
+
+    /* Start idle devices and collect what to wait on */
+    for (size_t i = 0; i < n; i++) {
+        apdu_device_t *dev = devs[i];
+        if (dev == NULL) {
+            continue;
+        }
+        device_send_next(dev);
+        if (!dev->in_flight) {
+            continue;
+        }
+        int fd = dev->transport->fd(dev->transport);
+        if (fd < 0) {
+            direct = true;
+        } else if (npfd < sizeof(pfds) / sizeof(pfds[0])) {
+            pfds[npfd].fd = fd;
+            pfds[npfd].events = POLLIN;
+            pfds[npfd].revents = 0;
+            pfd_dev[npfd] = i;
+            npfd++;
+        } else {
+            direct = true;     /* Beyond the poll set: fall back to probing */
+        }
+    }
+
+    if (npfd > 0) {
+        int rc = poll(pfds, npfd, direct ? 0 : timeout_ms);
+        if (rc < 0 && errno != EINTR) {
+            return -1;
+        }
+    }
+
+    /* Collect responses */
+    for (size_t i = 0; i < n; i++) {
+        apdu_device_t *dev = devs[i];
+        if (dev == NULL || !dev->in_flight) {
+            continue;
+        }
+
+        int fd = dev->transport->fd(dev->transport);
+        if (fd >= 0) {
+            bool ready = false;
+            bool polled = false;
+            for (size_t k = 0; k < npfd; k++) {
+                if (pfd_dev[k] == i) {
+                    polled = true;
+                    ready = (pfds[k].revents & (POLLIN | POLLERR | POLLHUP)) != 0;
+                    break;
+                }
+            }
+            if (polled && !ready) {
+                continue;
+            }
+        }
+
+        uint8_t resp[APDU_MAX_RESP_LEN];
+        size_t resp_len = 0;
+        int rc = dev->transport->recv(dev->transport, resp, sizeof(resp), &resp_len);
+        if (rc < 0) {
+            device_fail_all(dev);
+        } else if (rc > 0) {
+            device_on_response(dev, resp, resp_len);
+        }
+    }
+
+    int busy = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (devs[i] != NULL && !apdu_device_idle(devs[i])) {
+            busy++;
+        }
+    }
+    return busy;
+}
+
+static uint64_t total_exchanges(apdu_device_t *const *devs, size_t n) {
+    uint64_t total = 0;
+    for (size_t i = 0; i < n; i++) {
+        total += (devs[i] != NULL) ? devs[i]->exchanges : 0;
+    }
+    return total;
+}
+
+static int64_t monotonic_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+int apdu_client_run(apdu_device_t *const *devs, size_t n, int timeout_ms) {
+    uint64_t last = total_exchanges(devs, n);
+    int64_t since = monotonic_ms();
+
+    for (;;) {
+        int busy = apdu_client_poll(devs, n, timeout_ms > 0 ? timeout_ms : -1);
+        if (busy <= 0) {
+            return busy;
+        }
+
+        /* Timeout applies to the gap between two completed exchanges */
+        if (timeout_ms > 0) {
+            uint64_t now_exchanges = total_exchanges(devs, n);
+            if (now_exchanges != last) {
+                last = now_exchanges;
+                since = monotonic_ms();
+            } else if (monotonic_ms() - since >= timeout_ms) {
+                return -1;
+            }
+        }
+    }
+}
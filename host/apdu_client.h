@@ -0,0 +1,246 @@
+/*
+ * SUM Chain Host Library - APDU Client
+ * Packs commands into APDU frames and drives one or more devices
+ * concurrently from a single thread through an async completion interface.
+ * Host-side only (not part of the device build).
+ */
+
+#ifndef APDU_CLIENT_H
+#define APDU_CLIENT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "globals.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define APDU_HEADER_LEN       5      /* CLA INS P1 P2 Lc */
+#define APDU_MAX_DATA_LEN     255    /* Short APDU Lc limit */
+#define APDU_MAX_FRAME_LEN    (APDU_HEADER_LEN + APDU_MAX_DATA_LEN)
+#define APDU_MAX_RESP_LEN     (256 + 2)   /* Response data + SW */
+
+/*
+ * A single command APDU.
+ */
+typedef struct {
+    uint8_t bytes[APDU_MAX_FRAME_LEN];
+    size_t  len;
+} apdu_frame_t;
+
+/*
+ * Plan for streaming a SIGN_TX command. Frames are built on demand so a large
+ * transaction is never copied as a whole.
+ *
+ * The first frame carries the serialized path followed by as many tx bytes as
+ * fit; every following frame is a full APDU_MAX_DATA_LEN bytes except the
+ * last. Since the path must travel in the first APDU and no APDU can carry
+ * more than APDU_MAX_DATA_LEN bytes, this is the minimum number of exchanges.
+ */
+typedef struct {
+    uint8_t        path_buf[1 + 4 * MAX_BIP32_PATH_LEN];
+    size_t         path_len;           /* Serialized path length */
+    const uint8_t *tx;
+    size_t         tx_len;
+    bool           with_path;          /* Frame 0 opens a new session */
+    size_t         first_take;         /* Tx bytes carried by frame 0 after the path */
+    size_t         cont_offset;        /* Tx offset of the first continuation frame */
+    size_t         frame_count;
+    uint8_t        ins;                /* INS_SIGN_TX or INS_SIGN_MERKLE */
+} apdu_sign_tx_plan_t;
+
+/*
+ * Serialize a BIP32 path in APDU format: [len:1] [path[i]:4 BE]...
+ * BIP32-Ed25519 paths set PATH_LEN_FLAG_BIP32_ED25519 in the length byte.
+ *
+ * @param path    Path to serialize.
+ * @param out     Output buffer.
+ * @param out_len Size of output buffer.
+ * @return Number of bytes written, or 0 on error.
+ */
+size_t apdu_serialize_path(const bip32_path_t *path, uint8_t *out, size_t out_len);
+
+/*
+ * Build a SIGN_TX plan.
+ *
+ * @param plan      Plan to initialize.
+ * @param path      Signing key path.
+ * @param tx        Transaction bytes (must outlive the plan).
+ * @param tx_len    Transaction length.
+ * @param tx_offset Offset to start streaming from. 0 for a new session;
+ *                  non-zero plans continuation frames only (used to resume).
+ * @return true on success.
+ */
+bool apdu_sign_tx_plan_init(apdu_sign_tx_plan_t *plan, const bip32_path_t *path,
+                            const uint8_t *tx, size_t tx_len, size_t tx_offset);
+
+/*
+ * Build frame `index` of a SIGN_TX plan.
+ *
+ * @return true on success, false if index is out of range.
+ */
+bool apdu_sign_tx_plan_frame(const apdu_sign_tx_plan_t *plan, size_t index, apdu_frame_t *frame);
+
+/*
+ * Build a single-frame command APDU.
+ *
+ * @return true on success, false if lc exceeds APDU_MAX_DATA_LEN.
+ */
+bool apdu_frame_build(apdu_frame_t *frame, uint8_t cla, uint8_t ins, uint8_t p1, uint8_t p2,
+                      const uint8_t *data, size_t lc);
+
+/*
+ * Transport interface. All calls are non-blocking except `send`, which may
+ * block briefly while the kernel accepts a single frame.
+ */
+typedef struct apdu_transport {
+    /* Start an exchange. Returns 0 on success, -1 on error. */
+    int  (*send)(struct apdu_transport *t, const uint8_t *apdu, size_t len);
+    /*
+     * Collect the response to the exchange in flight.
+     * Writes data followed by the 2-byte SW to `resp`.
+     * Returns 1 when complete, 0 if still pending, -1 on error.
+     */
+    int  (*recv)(struct apdu_transport *t, uint8_t *resp, size_t resp_cap, size_t *resp_len);
+    /* File descriptor to poll for readability, or -1 if recv can be called directly. */
+    int  (*fd)(struct apdu_transport *t);
+    void (*close)(struct apdu_transport *t);
+} apdu_transport_t;
+
+/*
+ * TCP transport speaking the Speculos APDU protocol
+ * (request: [len:4 BE][apdu], response: [len:4 BE][data][sw:2]).
+ */
+typedef struct {
+    apdu_transport_t base;
+    int      sock;
+    uint8_t  rx[4 + APDU_MAX_RESP_LEN];
+    size_t   rx_len;
+} apdu_transport_tcp_t;
+
+/*
+ * Connect to a Speculos (or compatible) APDU port.
+ *
+ * @return 0 on success, -1 on error.
+ */
+int apdu_transport_tcp_open(apdu_transport_tcp_t *t, const char *host, uint16_t port);
+
+/*
+ * Request completion status.
+ */
+typedef enum {
+    APDU_STATUS_PENDING = 0,
+    APDU_STATUS_OK,                    /* Final SW was SW_OK */
+    APDU_STATUS_SW_ERROR,              /* Device returned an error SW (see sw) */
+    APDU_STATUS_TRANSPORT_ERROR        /* Transport failed; device is marked failed */
+} apdu_status_t;
+
+struct apdu_request;
+typedef void (*apdu_done_cb_t)(struct apdu_request *req, void *user);
+
+/*
+ * A queued command: either a SIGN_TX plan or a single frame.
+ * Owned by the caller and must stay valid until its callback runs.
+ */
+typedef struct apdu_request {
+    /* Input */
+    bool                 is_sign_tx;
+    apdu_sign_tx_plan_t  plan;
+    apdu_frame_t         single;
+    apdu_done_cb_t       done;
+    void                *user;
+
+    /* Result (valid in the callback) */
+    apdu_status_t        status;
+    uint16_t             sw;
+    uint8_t              resp[APDU_MAX_RESP_LEN];
+    size_t               resp_len;     /* Data length, SW excluded */
+
+    /* Internal */
+    size_t               next_frame;
+    struct apdu_request *next;
+} apdu_request_t;
+
+/*
+ * Prepare a SIGN_TX request (see apdu_sign_tx_plan_init).
+ */
+bool apdu_request_init_sign_tx(apdu_request_t *req, const bip32_path_t *path,
+                               const uint8_t *tx, size_t tx_len, size_t tx_offset,
+                               apdu_done_cb_t done, void *user);
+
+/*
+ * Prepare a SIGN_MERKLE request: same chunking as SIGN_TX over a stream of
+ * back-to-back transactions. The response is [root:32] [signature:64].
+ */
+bool apdu_request_init_sign_merkle(apdu_request_t *req, const bip32_path_t *path,
+                                   const uint8_t *stream, size_t stream_len,
+                                   size_t stream_offset,
+                                   apdu_done_cb_t done, void *user);
+
+/*
+ * Decode an INS_RESUME response.
+ *
+ * @param resp    Response data (SW excluded).
+ * @param len     Response length.
+ * @param kind    Output: RESUME_KIND_* of the open session.
+ * @param offset  Output: bytes already received; pass it as tx_offset /
+ *                stream_offset to continue the session.
+ * @return false if the response is malformed.
+ */
+bool apdu_parse_resume(const uint8_t *resp, size_t len, uint8_t *kind, size_t *offset);
+
+/*
+ * Prepare a single-frame request.
+ */
+bool apdu_request_init_raw(apdu_request_t *req, uint8_t ins, uint8_t p1, uint8_t p2,
+                           const uint8_t *data, size_t lc,
+                           apdu_done_cb_t done, void *user);
+
+/*
+ * One device (or emulator) with a FIFO of requests. The head request is the
+ * one in flight; the device protocol allows one outstanding APDU at a time.
+ */
+typedef struct {
+    apdu_transport_t *transport;
+    apdu_request_t   *head;
+    apdu_request_t   *tail;
+    bool              in_flight;
+    bool              failed;
+    apdu_frame_t      frame;
+    uint64_t          exchanges;       /* APDUs completed on this device */
+} apdu_device_t;
+
+void apdu_device_init(apdu_device_t *dev, apdu_transport_t *transport);
+
+/*
+ * Queue a request. If the device has failed, the request completes
+ * immediately with APDU_STATUS_TRANSPORT_ERROR.
+ */
+void apdu_device_submit(apdu_device_t *dev, apdu_request_t *req);
+
+bool apdu_device_idle(const apdu_device_t *dev);
+
+/*
+ * Make progress on every device: start queued requests, wait up to
+ * `timeout_ms` for responses and chain the next frame of each request as
+ * soon as its previous response arrives. Completion callbacks run from here.
+ *
+ * @return Number of devices still busy, or -1 on a poll failure.
+ */
+int apdu_client_poll(apdu_device_t *const *devs, size_t n, int timeout_ms);
+
+/*
+ * Poll until every device is idle.
+ *
+ * @param timeout_ms Maximum wait for any single response; 0 waits forever.
+ * @return 0 when all devices are idle, -1 on timeout or poll failure.
+ */
+int apdu_client_run(apdu_device_t *const *devs, size_t n, int timeout_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APDU_CLIENT_H */
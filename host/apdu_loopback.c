@@ -0,0 +1,112 @@
+/*
+ * SUM Chain Host Library - In-process APDU Transport Implementation
+ */
+
+#include "apdu_loopback.h"
+#include "apdu_handlers.h"
+#include <string.h>
+
+/* Same framing checks as app_main before dispatch */
+static uint16_t loopback_dispatch(const uint8_t *apdu, size_t len, uint8_t *out, size_t *out_len) {
+    uint8_t data[APDU_MAX_DATA_LEN];
+    uint8_t lc = 0;
+
+    *out_len = 0;
+
+    if (len < 4) {
+        return SW_WRONG_LENGTH;
+    }
+    if (len > 4) {
+        lc = apdu[4];
+        if (len < (size_t)APDU_HEADER_LEN + lc) {
+            return SW_WRONG_LENGTH;
+        }
+        memcpy(data, &apdu[APDU_HEADER_LEN], lc);
+    }
+
+    uint8_t *tx = out;
+    uint16_t sw = apdu_dispatch(apdu[0], apdu[1], apdu[2], apdu[3], lc,
+                                (len > 4) ? data : NULL, &tx);
+    *out_len = (size_t)(tx - out);
+
+    return sw;
+}
+
+static int loopback_send(apdu_transport_t *base, const uint8_t *apdu, size_t len) {
+    apdu_transport_loopback_t *t = (apdu_transport_loopback_t *)base;
+    static app_state_t saved;
+    size_t data_len = 0;
+
+    if (t->pending || t->broken) {
+        return -1;
+    }
+
+    uint16_t sw;
+    if (t->fail_count > 0) {
+        t->fail_count--;
+        sw = t->fail_sw;
+    } else {
+        /* Run the command against this device's private state */
+        memcpy(&saved, &G_app_state, sizeof(app_state_t));
+        memcpy(&G_app_state, &t->state, sizeof(app_state_t));
+
+        sw = loopback_dispatch(apdu, len, t->resp, &data_len);
+
+        memcpy(&t->state, &G_app_state, sizeof(app_state_t));
+        memcpy(&G_app_state, &saved, sizeof(app_state_t));
+    }
+
+    t->resp[data_len] = (uint8_t)(sw >> 8);
+    t->resp[data_len + 1] = (uint8_t)(sw & 0xFF);
+    t->resp_len = data_len + 2;
+    t->pending = true;
+    t->polls_left = t->latency_polls;
+    t->exchanges++;
+
+    return 0;
+}
+
+static int loopback_recv(apdu_transport_t *base, uint8_t *resp, size_t resp_cap, size_t *resp_len) {
+    apdu_transport_loopback_t *t = (apdu_transport_loopback_t *)base;
+
+    if (!t->pending) {
+        return -1;
+    }
+    if (t->polls_left > 0) {
+        t->polls_left--;
+        return 0;
+    }
+    if (t->resp_len > resp_cap) {
+        return -1;
+    }
+
+    memcpy(resp, t->resp, t->resp_len);
+    *resp_len = t->resp_len;
+    t->pending = false;
+
+    return 1;
+}
+
+static int loopback_fd(apdu_transport_t *base) {
+    (void)base;
+    return -1;
+}
+
+static void loopback_close(apdu_transport_t *base) {
+    apdu_transport_loopback_t *t = (apdu_transport_loopback_t *)base;
+    SECURE_ZEROIZE(&t->state, sizeof(t->state));
+    t->pending = false;
+}
+
+void apdu_transport_loopback_init(apdu_transport_loopback_t *t, unsigned latency_polls) {
+    if (t == NULL) {
+        return;
+    }
+
+    memset(t, 0, sizeof(*t));
+    t->base.send = loopback_send;
+    t->base.recv = loopback_recv;
+    t->base.fd = loopback_fd;
+    t->base.close = loopback_close;
+    t->latency_polls = latency_polls;
+}
@@ -0,0 +1,53 @@
+/*
+ * SUM Chain Host Library - In-process APDU Transport
+ * Runs apdu_dispatch from the host build of the app as a simulated device.
+ * Host-side only (not part of the device build).
+ */
+
+#ifndef APDU_LOOPBACK_H
+#define APDU_LOOPBACK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "apdu_client.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Simulated device. Each instance keeps its own app_state_t, swapped into
+ * G_app_state around every dispatch, so several simulated devices can hold
+ * independent signing sessions in one process.
+ */
+typedef struct {
+    apdu_transport_t base;
+    app_state_t      state;
+    uint8_t          resp[APDU_MAX_RESP_LEN];
+    size_t           resp_len;
+    bool             pending;
+    unsigned         latency_polls;    /* recv calls before a response is ready */
+    unsigned         polls_left;
+    uint64_t         exchanges;        /* APDUs dispatched */
+
+    /* Fault injection */
+    uint16_t         fail_sw;          /* SW returned instead of dispatching... */
+    unsigned         fail_count;       /* ...for this many upcoming APDUs */
+    bool             broken;           /* Every send fails (unplugged device) */
+} apdu_transport_loopback_t;
+
+/*
+ * Initialize a simulated device.
+ *
+ * @param t             Transport to initialize.
+ * @param latency_polls Number of pending recv results before each response
+ *                      (simulates a slow device; 0 answers immediately).
+ */
+void apdu_transport_loopback_init(apdu_transport_loopback_t *t, unsigned latency_polls);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APDU_LOOPBACK_H */
@@ -0,0 +1,206 @@
+/*
+ * SUM Chain Host Library - BIP32-Ed25519 Key Derivation Implementation
+ *
+ * Master node (as on the device): I = HMAC-SHA512("ed25519 seed", seed),
+ * repeated on I until bit 5 of I[31] is clear; kL || kR = I with kL
+ * clamped; chain code = HMAC-SHA256("ed25519 seed", 0x01 || seed).
+ *
+ * Child i (ser32 little-endian), with parent chain code c:
+ *   hardened:  Z = HMAC-SHA512(c, 0x00 || kL || kR || i), c' from 0x01
+ *   normal:    Z = HMAC-SHA512(c, 0x02 || A || i),        c' from 0x03
+ *   kL' = kL + 8 * Z[0..28),  kR' = kR + Z[32..64) mod 2^256,
+ *   A'  = A + [8 * Z[0..28)]B,  c' = right half of the second HMAC.
+ */
+
+#include "bip32_ed25519.h"
+#include "sha512.h"
+#include "sha256.h"
+#include "ed25519.h"
+#include "address.h"
+#include <string.h>
+
+static const char ED25519_CURVE_KEY[] = "ed25519 seed";
+
+#define HARDENED_BIT  0x80000000u
+#define ZL_LEN        28
+
+static void store_u32_le(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+/* out = 8 * zl (28 bytes) as a 32-byte little-endian integer */
+static void mul8_zl(uint8_t out[32], const uint8_t zl[ZL_LEN]) {
+    uint8_t carry = 0;
+
+    memset(out, 0, 32);
+    for (size_t i = 0; i < ZL_LEN; i++) {
+        out[i] = (uint8_t)((zl[i] << 3) | carry);
+        carry = (uint8_t)(zl[i] >> 5);
+    }
+    out[ZL_LEN] = carry;
+}
+
+/* r = a + b over 32 little-endian bytes; returns the carry out */
+static uint8_t add256(uint8_t r[32], const uint8_t a[32], const uint8_t b[32]) {
+    unsigned int carry = 0;
+
+    for (size_t i = 0; i < 32; i++) {
+        carry += (unsigned int)a[i] + b[i];
+        r[i] = (uint8_t)carry;
+        carry >>= 8;
+    }
+    return (uint8_t)carry;
+}
+
+static void master_node(const uint8_t *seed, size_t seed_len,
+                        uint8_t priv64[BIP32_ED25519_PRIVKEY_LEN], uint8_t chain32[32]) {
+    uint8_t data[1 + BIP32_ED25519_MAX_SEED_LEN];
+    uint8_t i_buf[SHA512_DIGEST_LEN];
+
+    hmac_sha512((const uint8_t *)ED25519_CURVE_KEY, sizeof(ED25519_CURVE_KEY) - 1,
+                seed, seed_len, i_buf);
+    while ((i_buf[31] & 0x20) != 0) {
+        hmac_sha512((const uint8_t *)ED25519_CURVE_KEY, sizeof(ED25519_CURVE_KEY) - 1,
+                    i_buf, sizeof(i_buf), i_buf);
+    }
+    i_buf[0] &= 0xF8;
+    i_buf[31] &= 0x7F;
+    i_buf[31] |= 0x40;
+    memcpy(priv64, i_buf, BIP32_ED25519_PRIVKEY_LEN);
+
+    data[0] = 0x01;
+    memcpy(data + 1, seed, seed_len);
+    hmac_sha256((const uint8_t *)ED25519_CURVE_KEY, sizeof(ED25519_CURVE_KEY) - 1,
+                data, 1 + seed_len, chain32);
+
+    SECURE_ZEROIZE(data, sizeof(data));
+    SECURE_ZEROIZE(i_buf, sizeof(i_buf));
+}
+
+bool bip32_ed25519_derive(const uint8_t *seed, size_t seed_len,
+                          const uint32_t *path, size_t path_len,
+                          uint8_t priv64[BIP32_ED25519_PRIVKEY_LEN], uint8_t chain32[32]) {
+    uint8_t key[BIP32_ED25519_PRIVKEY_LEN];     /* kL || kR */
+    uint8_t chain[32];
+    uint8_t data[1 + BIP32_ED25519_PRIVKEY_LEN + 4];
+    uint8_t z[SHA512_DIGEST_LEN];
+    uint8_t zl8[32];
+    size_t data_len;
+    bool ok = true;
+
+    if (seed == NULL || seed_len > BIP32_ED25519_MAX_SEED_LEN || priv64 == NULL ||
+        (path == NULL && path_len > 0)) {
+        return false;
+    }
+
+    master_node(seed, seed_len, key, chain);
+
+    for (size_t i = 0; i < path_len && ok; i++) {
+        uint32_t index = path[i];
+
+        if (index & HARDENED_BIT) {
+            data[0] = 0x00;
+            memcpy(data + 1, key, BIP32_ED25519_PRIVKEY_LEN);
+            data_len = 1 + BIP32_ED25519_PRIVKEY_LEN;
+        } else {
+            data[0] = 0x02;
+            ed25519_public_key_from_scalar(key, data + 1);
+            data_len = 1 + PUBKEY_LEN;
+        }
+        store_u32_le(data + data_len, index);
+        data_len += 4;
+
+        hmac_sha512(chain, sizeof(chain), data, data_len, z);
+
+        /* kL' = kL + 8 * zL must stay below 2^256 */
+        mul8_zl(zl8, z);
+        ok = add256(key, key, zl8) == 0;
+        add256(key + 32, key + 32, z + 32);
+
+        data[0] = (index & HARDENED_BIT) ? 0x01 : 0x03;
+        hmac_sha512(chain, sizeof(chain), data, data_len, z);
+        memcpy(chain, z + 32, sizeof(chain));
+    }
+
+    if (ok) {
+        memcpy(priv64, key, BIP32_ED25519_PRIVKEY_LEN);
+        if (chain32 != NULL) {
+            memcpy(chain32, chain, sizeof(chain));
+        }
+    }
+
+    SECURE_ZEROIZE(key, sizeof(key));
+    SECURE_ZEROIZE(chain, sizeof(chain));
+    SECURE_ZEROIZE(data, sizeof(data));
+    SECURE_ZEROIZE(z, sizeof(z));
+    SECURE_ZEROIZE(zl8, sizeof(zl8));
+    return ok;
+}
+
+bool bip32_ed25519_public_child(const uint8_t xpub[XPUB_LEN], uint32_t index,
+                                uint8_t child_xpub[XPUB_LEN]) {
+    uint8_t data[1 + PUBKEY_LEN + 4];
+    uint8_t z[SHA512_DIGEST_LEN];
+    uint8_t zl8[32];
+    uint8_t tweak[PUBKEY_LEN];
+    uint8_t pubkey[PUBKEY_LEN];
+
+    if (xpub == NULL || child_xpub == NULL || (index & HARDENED_BIT) != 0) {
+        return false;
+    }
+
+    data[0] = 0x02;
+    memcpy(data + 1, xpub, PUBKEY_LEN);
+    store_u32_le(data + 1 + PUBKEY_LEN, index);
+    hmac_sha512(xpub + PUBKEY_LEN, CHAIN_CODE_LEN, data, sizeof(data), z);
+
+    /* A' = A + [8 * zL]B */
+    mul8_zl(zl8, z);
+    ed25519_public_key_from_scalar(zl8, tweak);
+    if (!ed25519_point_add(xpub, tweak, pubkey)) {
+        return false;
+    }
+
+    data[0] = 0x03;
+    hmac_sha512(xpub + PUBKEY_LEN, CHAIN_CODE_LEN, data, sizeof(data), z);
+
+    memcpy(child_xpub, pubkey, PUBKEY_LEN);
+    memcpy(child_xpub + PUBKEY_LEN, z + 32, CHAIN_CODE_LEN);
+    return true;
+}
+
+bool bip32_ed25519_public_derive(const uint8_t xpub[XPUB_LEN],
+                                 const uint32_t *indices, size_t count,
+                                 uint8_t pubkey32[32]) {
+    uint8_t node[XPUB_LEN];
+
+    if (xpub == NULL || (indices == NULL && count > 0) || pubkey32 == NULL) {
+        return false;
+    }
+
+    memcpy(node, xpub, XPUB_LEN);
+    for (size_t i = 0; i < count; i++) {
+        if (!bip32_ed25519_public_child(node, indices[i], node)) {
+            return false;
+        }
+    }
+
+    memcpy(pubkey32, node, PUBKEY_LEN);
+    return true;
+}
+
+bool bip32_ed25519_address(const uint8_t xpub[XPUB_LEN],
+                           const uint32_t *indices, size_t count,
+                           uint8_t addr20[ADDRESS_LEN]) {
+    uint8_t pubkey[PUBKEY_LEN];
+
+    if (addr20 == NULL || !bip32_ed25519_public_derive(xpub, indices, count, pubkey)) {
+        return false;
+    }
+
+    sumchain_address_bytes_from_pubkey(pubkey, addr20);
+    return true;
+}
@@ -0,0 +1,79 @@
+/*
+ * SUM Chain Host Library - BIP32-Ed25519 Key Derivation
+ * Khovratovich-Law hierarchical Ed25519 keys, the derivation the device
+ * uses for PATH_SCHEME_BIP32_ED25519 paths (HDW_NORMAL). Non-hardened
+ * children can be derived from an extended public key alone, so a backend
+ * holding the INS_GET_XPUB result of an account can generate its deposit
+ * addresses without the device. Host-side only.
+ */
+
+#ifndef BIP32_ED25519_H
+#define BIP32_ED25519_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "globals.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BIP32_ED25519_MAX_SEED_LEN  64     /* BIP39 seed size */
+
+/*
+ * Derive the extended private key kL || kR and chain code for a path.
+ * Used by the host crypto backend and tests; backends that only generate
+ * addresses need bip32_ed25519_public_derive.
+ *
+ * @param seed       Master seed (BIP39 seed or raw test seed).
+ * @param seed_len   Seed length (at most BIP32_ED25519_MAX_SEED_LEN).
+ * @param path       Path components (hardened and non-hardened).
+ * @param path_len   Number of components (0 = master node).
+ * @param priv64     Output extended private key.
+ * @param chain32    Output chain code (may be NULL).
+ * @return false on bad arguments or if a derived kL overflows 2^256.
+ */
+bool bip32_ed25519_derive(const uint8_t *seed, size_t seed_len,
+                          const uint32_t *path, size_t path_len,
+                          uint8_t priv64[BIP32_ED25519_PRIVKEY_LEN], uint8_t chain32[32]);
+
+/*
+ * Derive a non-hardened child extended public key.
+ *
+ * @param xpub        Parent public key || chain code (INS_GET_XPUB response).
+ * @param index       Child index (must be < 0x80000000).
+ * @param child_xpub  Output child public key || chain code (may alias xpub).
+ * @return false for a hardened index or an invalid parent key.
+ */
+bool bip32_ed25519_public_child(const uint8_t xpub[XPUB_LEN], uint32_t index,
+                                uint8_t child_xpub[XPUB_LEN]);
+
+/*
+ * Derive the public key at xpub/indices[0]/indices[1]/...
+ *
+ * @param xpub      Account extended public key.
+ * @param indices   Non-hardened child indices.
+ * @param count     Number of indices.
+ * @param pubkey32  Output public key.
+ * @return false if an index is hardened or the key is invalid.
+ */
+bool bip32_ed25519_public_derive(const uint8_t xpub[XPUB_LEN],
+                                 const uint32_t *indices, size_t count,
+                                 uint8_t pubkey32[32]);
+
+/*
+ * Derive the 20-byte address at xpub/indices[0]/indices[1]/... (see
+ * sumchain_address_bytes_from_pubkey).
+ *
+ * @return false if an index is hardened or the key is invalid.
+ */
+bool bip32_ed25519_address(const uint8_t xpub[XPUB_LEN],
+                           const uint32_t *indices, size_t count,
+                           uint8_t addr20[ADDRESS_LEN]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BIP32_ED25519_H */
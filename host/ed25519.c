@@ -0,0 +1,779 @@
+/*
+ * SUM Chain Host Library - Ed25519 Implementation
+ *
+ * Field elements use five 51-bit limbs with unsigned __int128 products
+ * (GCC/Clang on 64-bit hosts). Points use extended twisted Edwards
+ * coordinates (X:Y:Z:T), x = X/Z, y = Y/Z, xy = T/Z. Scalars mod L use the
+ * byte-wise reduction from TweetNaCl. Batch verification is variable-time
+ * (public inputs only).
+ */
+
+#include "ed25519.h"
+#include "sha512.h"
+#include "globals.h"
+#include <string.h>
+
+typedef unsigned __int128 u128;
+
+typedef struct {
+    uint64_t v[5];
+} fe_t;
+
+typedef struct {
+    fe_t X, Y, Z, T;
+} ge_t;
+
+#define MASK51  ((1ULL << 51) - 1)
+
+/* d = -121665/121666 */
+static const fe_t FE_D = {{
+    0x34dca135978a3ULL, 0x1a8283b156ebdULL, 0x5e7a26001c029ULL, 0x739c663a03cbbULL, 0x52036cee2b6ffULL
+}};
+
+/* 2d */
+static const fe_t FE_D2 = {{
+    0x69b9426b2f159ULL, 0x35050762add7aULL, 0x3cf44c0038052ULL, 0x6738cc7407977ULL, 0x2406d9dc56dffULL
+}};
+
+/* sqrt(-1) */
+static const fe_t FE_SQRTM1 = {{
+    0x61b274a0ea0b0ULL, 0x0d5a5fc8f189dULL, 0x7ef5e9cbd0c60ULL, 0x78595a6804c9eULL, 0x2b8324804fc1dULL
+}};
+
+/* Base point B (y = 4/5, x even) */
+static const ge_t GE_BASE = {
+    {{ 0x62d608f25d51aULL, 0x412a4b4f6592aULL, 0x75b7171a4b31dULL, 0x1ff60527118feULL, 0x216936d3cd6e5ULL }},
+    {{ 0x6666666666658ULL, 0x4ccccccccccccULL, 0x1999999999999ULL, 0x3333333333333ULL, 0x6666666666666ULL }},
+    {{ 1, 0, 0, 0, 0 }},
+    {{ 0x68ab3a5b7dda3ULL, 0x00eea2a5eadbbULL, 0x2af8df483c27eULL, 0x332b375274732ULL, 0x67875f0fd78b7ULL }}
+};
+
+/* Group order L = 2^252 + 27742317777372353535851937790883648493, little-endian */
+static const uint8_t L_BYTES[32] = {
+    0xed, 0xd3, 0xf5, 0x5c, 0x1a, 0x63, 0x12, 0x58, 0xd6, 0x9c, 0xf7, 0xa2, 0xde, 0xf9, 0xde, 0x14,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10
+};
+
+/* ------------------------------------------------------------------------ */
+/* Field arithmetic mod p = 2^255 - 19                                      */
+/* ------------------------------------------------------------------------ */
+
+static void fe_0(fe_t *h) {
+    memset(h, 0, sizeof(*h));
+}
+
+static void fe_1(fe_t *h) {
+    fe_0(h);
+    h->v[0] = 1;
+}
+
+/* Propagate carries so every limb is below 2^51 (+ a small excess in v[0]) */
+static void fe_carry(fe_t *h) {
+    uint64_t c;
+    c = h->v[0] >> 51; h->v[0] &= MASK51; h->v[1] += c;
+    c = h->v[1] >> 51; h->v[1] &= MASK51; h->v[2] += c;
+    c = h->v[2] >> 51; h->v[2] &= MASK51; h->v[3] += c;
+    c = h->v[3] >> 51; h->v[3] &= MASK51; h->v[4] += c;
+    c = h->v[4] >> 51; h->v[4] &= MASK51; h->v[0] += c * 19;
+}
+
+static void fe_add(fe_t *h, const fe_t *f, const fe_t *g) {
+    for (int i = 0; i < 5; i++) {
+        h->v[i] = f->v[i] + g->v[i];
+    }
+    fe_carry(h);
+}
+
+/* f - g computed as f + 4p - g so limbs never underflow */
+static void fe_sub(fe_t *h, const fe_t *f, const fe_t *g) {
+    h->v[0] = f->v[0] + 0x1FFFFFFFFFFFB4ULL - g->v[0];
+    h->v[1] = f->v[1] + 0x1FFFFFFFFFFFFCULL - g->v[1];
+    h->v[2] = f->v[2] + 0x1FFFFFFFFFFFFCULL - g->v[2];
+    h->v[3] = f->v[3] + 0x1FFFFFFFFFFFFCULL - g->v[3];
+    h->v[4] = f->v[4] + 0x1FFFFFFFFFFFFCULL - g->v[4];
+    fe_carry(h);
+}
+
+static void fe_neg(fe_t *h, const fe_t *f) {
+    fe_t zero;
+    fe_0(&zero);
+    fe_sub(h, &zero, f);
+}
+
+static void fe_mul(fe_t *h, const fe_t *f, const fe_t *g) {
+    const uint64_t f0 = f->v[0], f1 = f->v[1], f2 = f->v[2], f3 = f->v[3], f4 = f->v[4];
+    const uint64_t g0 = g->v[0], g1 = g->v[1], g2 = g->v[2], g3 = g->v[3], g4 = g->v[4];
+    const uint64_t g1_19 = g1 * 19, g2_19 = g2 * 19, g3_19 = g3 * 19, g4_19 = g4 * 19;
+
+    u128 r0 = (u128)f0 * g0 + (u128)f1 * g4_19 + (u128)f2 * g3_19 + (u128)f3 * g2_19 + (u128)f4 * g1_19;
+    u128 r1 = (u128)f0 * g1 + (u128)f1 * g0 + (u128)f2 * g4_19 + (u128)f3 * g3_19 + (u128)f4 * g2_19;
+    u128 r2 = (u128)f0 * g2 + (u128)f1 * g1 + (u128)f2 * g0 + (u128)f3 * g4_19 + (u128)f4 * g3_19;
+    u128 r3 = (u128)f0 * g3 + (u128)f1 * g2 + (u128)f2 * g1 + (u128)f3 * g0 + (u128)f4 * g4_19;
+    u128 r4 = (u128)f0 * g4 + (u128)f1 * g3 + (u128)f2 * g2 + (u128)f3 * g1 + (u128)f4 * g0;
+
+    r1 += (uint64_t)(r0 >> 51);
+    r2 += (uint64_t)(r1 >> 51);
+    r3 += (uint64_t)(r2 >> 51);
+    r4 += (uint64_t)(r3 >> 51);
+
+    h->v[0] = ((uint64_t)r0 & MASK51) + (uint64_t)(r4 >> 51) * 19;
+    h->v[1] = (uint64_t)r1 & MASK51;
+    h->v[2] = (uint64_t)r2 & MASK51;
+    h->v[3] = (uint64_t)r3 & MASK51;
+    h->v[4] = (uint64_t)r4 & MASK51;
+    h->v[1] += h->v[0] >> 51;
+    h->v[0] &= MASK51;
+}
+
+static void fe_sq(fe_t *h, const fe_t *f) {
+    fe_mul(h, f, f);
+}
+
+/* h = f^(2^n) */
+static void fe_sq_n(fe_t *h, const fe_t *f, int n) {
+    fe_sq(h, f);
+    for (int i = 1; i < n; i++) {
+        fe_sq(h, h);
+    }
+}
+
+/* Shared ladder: returns z^(2^250 - 1) in t_250 and z^11 in z11 */
+static void fe_pow_2_250_1(fe_t *t_250, fe_t *z11, const fe_t *z) {
+    fe_t t0, t1, t2;
+
+    fe_sq(&t0, z);                  /* z^2 */
+    fe_sq_n(&t1, &t0, 2);           /* z^8 */
+    fe_mul(&t1, z, &t1);            /* z^9 */
+    fe_mul(z11, &t0, &t1);          /* z^11 */
+    fe_sq(&t2, z11);                /* z^22 */
+    fe_mul(&t1, &t1, &t2);          /* z^(2^5 - 1) */
+    fe_sq_n(&t2, &t1, 5);
+    fe_mul(&t1, &t2, &t1);          /* z^(2^10 - 1) */
+    fe_sq_n(&t2, &t1, 10);
+    fe_mul(&t2, &t2, &t1);          /* z^(2^20 - 1) */
+    fe_sq_n(&t0, &t2, 20);
+    fe_mul(&t2, &t0, &t2);          /* z^(2^40 - 1) */
+    fe_sq_n(&t2, &t2, 10);
+    fe_mul(&t1, &t2, &t1);          /* z^(2^50 - 1) */
+    fe_sq_n(&t2, &t1, 50);
+    fe_mul(&t2, &t2, &t1);          /* z^(2^100 - 1) */
+    fe_sq_n(&t0, &t2, 100);
+    fe_mul(&t2, &t0, &t2);          /* z^(2^200 - 1) */
+    fe_sq_n(&t2, &t2, 50);
+    fe_mul(t_250, &t2, &t1);        /* z^(2^250 - 1) */
+}
+
+/* h = z^(p - 2) = 1/z */
+static void fe_invert(fe_t *h, const fe_t *z) {
+    fe_t t, z11;
+    fe_pow_2_250_1(&t, &z11, z);
+    fe_sq_n(&t, &t, 5);
+    fe_mul(h, &t, &z11);            /* z^(2^255 - 21) */
+}
+
+/* h = z^((p - 5) / 8) */
+static void fe_pow22523(fe_t *h, const fe_t *z) {
+    fe_t t, z11;
+    fe_pow_2_250_1(&t, &z11, z);
+    fe_sq_n(&t, &t, 2);
+    fe_mul(h, &t, z);               /* z^(2^252 - 3) */
+}
+
+static void fe_frombytes(fe_t *h, const uint8_t s[32]) {
+    uint64_t w[4];
+    for (int i = 0; i < 4; i++) {
+        w[i] = 0;
+        for (int j = 7; j >= 0; j--) {
+            w[i] = (w[i] << 8) | s[8 * i + j];
+        }
+    }
+    h->v[0] = w[0] & MASK51;
+    h->v[1] = ((w[0] >> 51) | (w[1] << 13)) & MASK51;
+    h->v[2] = ((w[1] >> 38) | (w[2] << 26)) & MASK51;
+    h->v[3] = ((w[2] >> 25) | (w[3] << 39)) & MASK51;
+    h->v[4] = (w[3] >> 12) & MASK51;
+}
+
+/* Canonical little-endian encoding (fully reduced mod p) */
+static void fe_tobytes(uint8_t s[32], const fe_t *f) {
+    fe_t h = *f;
+    uint64_t q;
+    uint64_t w[4];
+
+    fe_carry(&h);
+    fe_carry(&h);
+
+    /* q = 1 iff h >= p */
+    q = (h.v[0] + 19) >> 51;
+    q = (h.v[1] + q) >> 51;
+    q = (h.v[2] + q) >> 51;
+    q = (h.v[3] + q) >> 51;
+    q = (h.v[4] + q) >> 51;
+
+    h.v[0] += 19 * q;
+    h.v[1] += h.v[0] >> 51; h.v[0] &= MASK51;
+    h.v[2] += h.v[1] >> 51; h.v[1] &= MASK51;
+    h.v[3] += h.v[2] >> 51; h.v[2] &= MASK51;
+    h.v[4] += h.v[3] >> 51; h.v[3] &= MASK51;
+    h.v[4] &= MASK51;
+
+    w[0] = h.v[0] | (h.v[1] << 51);
+    w[1] = (h.v[1] >> 13) | (h.v[2] << 38);
+    w[2] = (h.v[2] >> 26) | (h.v[3] << 25);
+    w[3] = (h.v[3] >> 39) | (h.v[4] << 12);
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 8; j++) {
+            s[8 * i + j] = (uint8_t)(w[i] >> (8 * j));
+        }
+    }
+}
+
+static bool fe_isnegative(const fe_t *f) {
+    uint8_t s[32];
+    fe_tobytes(s, f);
+    return (s[0] & 1) != 0;
+}
+
+static bool fe_iszero(const fe_t *f) {
+    uint8_t s[32];
+    uint8_t acc = 0;
+    fe_tobytes(s, f);
+    for (int i = 0; i < 32; i++) {
+        acc |= s[i];
+    }
+    return acc == 0;
+}
+
+static bool fe_equal(const fe_t *f, const fe_t *g) {
+    fe_t d;
+    fe_sub(&d, f, g);
+    return fe_iszero(&d);
+}
+
+/* Constant-time h = b ? g : h */
+static void fe_cmov(fe_t *h, const fe_t *g, uint64_t b) {
+    uint64_t mask = (uint64_t)0 - b;
+    for (int i = 0; i < 5; i++) {
+        h->v[i] ^= mask & (h->v[i] ^ g->v[i]);
+    }
+}
+
+/* ------------------------------------------------------------------------ */
+/* Group operations                                                         */
+/* ------------------------------------------------------------------------ */
+
+static void ge_identity(ge_t *p) {
+    fe_0(&p->X);
+    fe_1(&p->Y);
+    fe_1(&p->Z);
+    fe_0(&p->T);
+}
+
+/* add-2008-hwcd-3 (a = -1), complete for Ed25519 */
+static void ge_add(ge_t *r, const ge_t *p, const ge_t *q) {
+    fe_t a, b, c, d, e, f, g, h, t;
+
+    fe_sub(&a, &p->Y, &p->X);
+    fe_sub(&t, &q->Y, &q->X);
+    fe_mul(&a, &a, &t);
+    fe_add(&b, &p->Y, &p->X);
+    fe_add(&t, &q->Y, &q->X);
+    fe_mul(&b, &b, &t);
+    fe_mul(&c, &p->T, &q->T);
+    fe_mul(&c, &c, &FE_D2);
+    fe_mul(&d, &p->Z, &q->Z);
+    fe_add(&d, &d, &d);
+    fe_sub(&e, &b, &a);
+    fe_sub(&f, &d, &c);
+    fe_add(&g, &d, &c);
+    fe_add(&h, &b, &a);
+
+    fe_mul(&r->X, &e, &f);
+    fe_mul(&r->Y, &g, &h);
+    fe_mul(&r->T, &e, &h);
+    fe_mul(&r->Z, &f, &g);
+}
+
+/* dbl-2008-hwcd (a = -1) */
+static void ge_double(ge_t *r, const ge_t *p) {
+    fe_t a, b, c, e, f, g, h;
+
+    fe_sq(&a, &p->X);
+    fe_sq(&b, &p->Y);
+    fe_sq(&c, &p->Z);
+    fe_add(&c, &c, &c);
+    fe_add(&h, &a, &b);
+    fe_add(&e, &p->X, &p->Y);
+    fe_sq(&e, &e);
+    fe_sub(&e, &h, &e);
+    fe_sub(&g, &a, &b);
+    fe_add(&f, &c, &g);
+
+    fe_mul(&r->X, &e, &f);
+    fe_mul(&r->Y, &g, &h);
+    fe_mul(&r->T, &e, &h);
+    fe_mul(&r->Z, &f, &g);
+}
+
+static void ge_neg(ge_t *r, const ge_t *p) {
+    fe_neg(&r->X, &p->X);
+    r->Y = p->Y;
+    r->Z = p->Z;
+    fe_neg(&r->T, &p->T);
+}
+
+static void ge_cmov(ge_t *r, const ge_t *p, uint64_t b) {
+    fe_cmov(&r->X, &p->X, b);
+    fe_cmov(&r->Y, &p->Y, b);
+    fe_cmov(&r->Z, &p->Z, b);
+    fe_cmov(&r->T, &p->T, b);
+}
+
+static void ge_tobytes(uint8_t s[32], const ge_t *p) {
+    fe_t recip, x, y;
+
+    fe_invert(&recip, &p->Z);
+    fe_mul(&x, &p->X, &recip);
+    fe_mul(&y, &p->Y, &recip);
+    fe_tobytes(s, &y);
+    s[31] |= (uint8_t)(fe_isnegative(&x) << 7);
+}
+
+/* Decode a point (RFC 8032 5.1.3). Returns false for invalid encodings. */
+static bool ge_frombytes(ge_t *p, const uint8_t s[32]) {
+    fe_t u, v, v3, vxx, check;
+    uint8_t canon[32];
+    bool x_sign = (s[31] >> 7) != 0;
+
+    fe_frombytes(&p->Y, s);
+
+    /* Reject non-canonical y */
+    fe_tobytes(canon, &p->Y);
+    if ((canon[31] & 0x7F) != (s[31] & 0x7F) || memcmp(canon, s, 31) != 0) {
+        return false;
+    }
+
+    fe_1(&p->Z);
+    fe_sq(&u, &p->Y);
+    fe_mul(&v, &u, &FE_D);
+    fe_sub(&u, &u, &p->Z);          /* u = y^2 - 1 */
+    fe_add(&v, &v, &p->Z);          /* v = d y^2 + 1 */
+
+    /* x = u v^3 (u v^7)^((p - 5) / 8) */
+    fe_sq(&v3, &v);
+    fe_mul(&v3, &v3, &v);
+    fe_sq(&p->X, &v3);
+    fe_mul(&p->X, &p->X, &v);
+    fe_mul(&p->X, &p->X, &u);
+    fe_pow22523(&p->X, &p->X);
+    fe_mul(&p->X, &p->X, &v3);
+    fe_mul(&p->X, &p->X, &u);
+
+    fe_sq(&vxx, &p->X);
+    fe_mul(&vxx, &vxx, &v);
+    if (!fe_equal(&vxx, &u)) {
+        fe_neg(&check, &u);
+        if (!fe_equal(&vxx, &check)) {
+            return false;
+        }
+        fe_mul(&p->X, &p->X, &FE_SQRTM1);
+    }
+
+    if (fe_iszero(&p->X) && x_sign) {
+        return false;
+    }
+    if (fe_isnegative(&p->X) != x_sign) {
+        fe_neg(&p->X, &p->X);
+    }
+
+    fe_mul(&p->T, &p->X, &p->Y);
+    return true;
+}
+
+/* r = [s]p with 4-bit fixed windows and constant-time table lookup */
+static void ge_scalarmult(ge_t *r, const uint8_t s[32], const ge_t *p) {
+    ge_t table[16];
+    ge_t t;
+
+    ge_identity(&table[0]);
+    table[1] = *p;
+    for (int i = 2; i < 16; i++) {
+        ge_add(&table[i], &table[i - 1], p);
+    }
+
+    ge_identity(r);
+    for (int i = 63; i >= 0; i--) {
+        uint8_t nibble = (uint8_t)((s[i / 2] >> (4 * (i & 1))) & 0x0F);
+
+        ge_double(r, r);
+        ge_double(r, r);
+        ge_double(r, r);
+        ge_double(r, r);
+
+        ge_identity(&t);
+        for (uint8_t j = 1; j < 16; j++) {
+            ge_cmov(&t, &table[j], (uint64_t)(j == nibble));
+        }
+        ge_add(r, r, &t);
+    }
+
+    SECURE_ZEROIZE(table, sizeof(table));
+    SECURE_ZEROIZE(&t, sizeof(t));
+}
+
+static void ge_scalarmult_base(ge_t *r, const uint8_t s[32]) {
+    ge_scalarmult(r, s, &GE_BASE);
+}
+
+static bool ge_is_identity(const ge_t *p) {
+    return fe_iszero(&p->X) && fe_equal(&p->Y, &p->Z);
+}
+
+/* P, 2P, ..., 8P for signed 4-bit windows */
+typedef struct {
+    ge_t mult[8];
+} ge_table8_t;
+
+static void ge_table8_init(ge_table8_t *t, const ge_t *p) {
+    t->mult[0] = *p;
+    for (int i = 1; i < 8; i++) {
+        ge_add(&t->mult[i], &t->mult[i - 1], p);
+    }
+}
+
+/* Signed radix-16 digits of a scalar below 2^255, each in [-8, 8] */
+static void sc_recode16(int8_t e[64], const uint8_t a[32]) {
+    int8_t carry = 0;
+
+    for (int i = 0; i < 32; i++) {
+        e[2 * i] = (int8_t)(a[i] & 15);
+        e[2 * i + 1] = (int8_t)(a[i] >> 4);
+    }
+    for (int i = 0; i < 63; i++) {
+        e[i] = (int8_t)(e[i] + carry);
+        carry = (int8_t)((e[i] + 8) >> 4);
+        e[i] = (int8_t)(e[i] - carry * 16);
+    }
+    e[63] = (int8_t)(e[63] + carry);
+}
+
+/* r = sum [scalar_j]P_j (Straus: shared doublings, variable time) */
+static void ge_msm(ge_t *r, const int8_t (*digits)[64], const ge_table8_t *tables, size_t n) {
+    bool started = false;
+    ge_t t;
+
+    ge_identity(r);
+    for (int i = 63; i >= 0; i--) {
+        if (started) {
+            ge_double(r, r);
+            ge_double(r, r);
+            ge_double(r, r);
+            ge_double(r, r);
+        }
+        for (size_t j = 0; j < n; j++) {
+            int8_t d = digits[j][i];
+            if (d > 0) {
+                ge_add(r, r, &tables[j].mult[d - 1]);
+                started = true;
+            } else if (d < 0) {
+                ge_neg(&t, &tables[j].mult[-d - 1]);
+                ge_add(r, r, &t);
+                started = true;
+            }
+        }
+    }
+}
+
+/* ------------------------------------------------------------------------ */
+/* Scalars mod L                                                            */
+/* ------------------------------------------------------------------------ */
+
+/* r = x mod L, x given as 64 signed radix-2^8 limbs (clobbered) */
+static void sc_reduce_limbs(uint8_t r[32], int64_t x[64]) {
+    int64_t carry;
+    int i, j;
+
+    for (i = 63; i >= 32; i--) {
+        carry = 0;
+        for (j = i - 32; j < i - 12; j++) {
+            x[j] += carry - 16 * x[i] * L_BYTES[j - (i - 32)];
+            carry = (x[j] + 128) >> 8;
+            x[j] -= carry * 256;
+        }
+        x[j] += carry;
+        x[i] = 0;
+    }
+
+    carry = 0;
+    for (j = 0; j < 32; j++) {
+        x[j] += carry - (x[31] >> 4) * L_BYTES[j];
+        carry = x[j] >> 8;
+        x[j] &= 255;
+    }
+    for (j = 0; j < 32; j++) {
+        x[j] -= carry * L_BYTES[j];
+    }
+    for (i = 0; i < 32; i++) {
+        x[i + 1] += x[i] >> 8;
+        r[i] = (uint8_t)(x[i] & 255);
+    }
+}
+
+/* r = s mod L for a 64-byte little-endian s */
+static void sc_reduce64(uint8_t r[32], const uint8_t s[64]) {
+    int64_t x[64];
+    for (int i = 0; i < 64; i++) {
+        x[i] = s[i];
+    }
+    sc_reduce_limbs(r, x);
+}
+
+/* r = a * b + c mod L */
+static void sc_muladd(uint8_t r[32], const uint8_t a[32], const uint8_t b[32], const uint8_t c[32]) {
+    int64_t x[64];
+
+    memset(x, 0, sizeof(x));
+    for (int i = 0; i < 32; i++) {
+        x[i] = c[i];
+    }
+    for (int i = 0; i < 32; i++) {
+        for (int j = 0; j < 32; j++) {
+            x[i + j] += (int64_t)a[i] * b[j];
+        }
+    }
+    sc_reduce_limbs(r, x);
+    SECURE_ZEROIZE(x, sizeof(x));
+}
+
+/* s < L (big-endian compare from the top byte) */
+static bool sc_is_canonical(const uint8_t s[32]) {
+    for (int i = 31; i >= 0; i--) {
+        if (s[i] < L_BYTES[i]) {
+            return true;
+        }
+        if (s[i] > L_BYTES[i]) {
+            return false;
+        }
+    }
+    return false;
+}
+
+/* ------------------------------------------------------------------------ */
+/* Ed25519                                                                  */
+/* ------------------------------------------------------------------------ */
+
+/* Expand the seed: clamped scalar a and nonce prefix */
+static void expand_seed(const uint8_t seed[ED25519_SEED_LEN], uint8_t az[64]) {
+    sha512(seed, ED25519_SEED_LEN, az);
+    az[0] &= 248;
+    az[31] &= 127;
+    az[31] |= 64;
+}
+
+/* k = SHA-512(R || A || M) mod L */
+static void challenge(uint8_t k[32], const uint8_t r[32], const uint8_t pubkey[32],
+                      const uint8_t *msg, size_t msg_len) {
+    sha512_ctx_t ctx;
+    uint8_t h[SHA512_DIGEST_LEN];
+
+    sha512_init(&ctx);
+    sha512_update(&ctx, r, 32);
+    sha512_update(&ctx, pubkey, 32);
+    sha512_update(&ctx, msg, msg_len);
+    sha512_final(&ctx, h);
+    sc_reduce64(k, h);
+}
+
+void ed25519_public_key(const uint8_t seed[ED25519_SEED_LEN],
+                        uint8_t pubkey[ED25519_PUBKEY_LEN]) {
+    uint8_t az[64];
+    ge_t a;
+
+    expand_seed(seed, az);
+    ge_scalarmult_base(&a, az);
+    ge_tobytes(pubkey, &a);
+
+    SECURE_ZEROIZE(az, sizeof(az));
+    SECURE_ZEROIZE(&a, sizeof(a));
+}
+
+/* Sign with an expanded key: scalar az[0..32), nonce prefix az[32..64) */
+static void sign_expanded(const uint8_t az[64], const uint8_t pubkey[ED25519_PUBKEY_LEN],
+                          const uint8_t *msg, size_t msg_len,
+                          uint8_t sig[ED25519_SIGNATURE_LEN]) {
+    uint8_t nonce_hash[SHA512_DIGEST_LEN];
+    uint8_t nonce[32];
+    uint8_t k[32];
+    sha512_ctx_t ctx;
+    ge_t r;
+
+    /* r = SHA-512(prefix || M) mod L */
+    sha512_init(&ctx);
+    sha512_update(&ctx, az + 32, 32);
+    sha512_update(&ctx, msg, msg_len);
+    sha512_final(&ctx, nonce_hash);
+    sc_reduce64(nonce, nonce_hash);
+
+    ge_scalarmult_base(&r, nonce);
+    ge_tobytes(sig, &r);
+
+    /* S = r + k * a mod L */
+    challenge(k, sig, pubkey, msg, msg_len);
+    sc_muladd(sig + 32, k, az, nonce);
+
+    SECURE_ZEROIZE(nonce_hash, sizeof(nonce_hash));
+    SECURE_ZEROIZE(nonce, sizeof(nonce));
+    SECURE_ZEROIZE(&r, sizeof(r));
+}
+
+void ed25519_sign(const uint8_t seed[ED25519_SEED_LEN],
+                  const uint8_t pubkey[ED25519_PUBKEY_LEN],
+                  const uint8_t *msg, size_t msg_len,
+                  uint8_t sig[ED25519_SIGNATURE_LEN]) {
+    uint8_t az[64];
+
+    expand_seed(seed, az);
+    sign_expanded(az, pubkey, msg, msg_len, sig);
+
+    SECURE_ZEROIZE(az, sizeof(az));
+}
+
+void ed25519_public_key_from_scalar(const uint8_t scalar[32],
+                                    uint8_t pubkey[ED25519_PUBKEY_LEN]) {
+    ge_t a;
+
+    ge_scalarmult_base(&a, scalar);
+    ge_tobytes(pubkey, &a);
+
+    SECURE_ZEROIZE(&a, sizeof(a));
+}
+
+void ed25519_sign_extended(const uint8_t ext[64],
+                           const uint8_t pubkey[ED25519_PUBKEY_LEN],
+                           const uint8_t *msg, size_t msg_len,
+                           uint8_t sig[ED25519_SIGNATURE_LEN]) {
+    sign_expanded(ext, pubkey, msg, msg_len, sig);
+}
+
+bool ed25519_point_add(const uint8_t p[ED25519_PUBKEY_LEN],
+                       const uint8_t q[ED25519_PUBKEY_LEN],
+                       uint8_t out[ED25519_PUBKEY_LEN]) {
+    ge_t a, b;
+
+    if (!ge_frombytes(&a, p) || !ge_frombytes(&b, q)) {
+        return false;
+    }
+
+    ge_add(&a, &a, &b);
+    ge_tobytes(out, &a);
+    return true;
+}
+
+bool ed25519_verify(const uint8_t pubkey[ED25519_PUBKEY_LEN],
+                    const uint8_t *msg, size_t msg_len,
+                    const uint8_t sig[ED25519_SIGNATURE_LEN]) {
+    uint8_t k[32];
+    ge_t a, r, sb, ka;
+
+    if (!sc_is_canonical(sig + 32) || !ge_frombytes(&a, pubkey) || !ge_frombytes(&r, sig)) {
+        return false;
+    }
+
+    challenge(k, sig, pubkey, msg, msg_len);
+
+    /* [8]([S]B - R - [k]A) must be the identity, as in ed25519_verify_batch */
+    ge_scalarmult_base(&sb, sig + 32);
+    ge_scalarmult(&ka, k, &a);
+    ge_neg(&ka, &ka);
+    ge_add(&sb, &sb, &ka);
+    ge_neg(&r, &r);
+    ge_add(&sb, &sb, &r);
+    ge_double(&sb, &sb);
+    ge_double(&sb, &sb);
+    ge_double(&sb, &sb);
+
+    return ge_is_identity(&sb);
+}
+
+bool ed25519_verify_batch(const ed25519_batch_item_t *items, size_t n) {
+    /* Points: -R_i, -A_i for every item, then B */
+    ge_table8_t tables[2 * ED25519_BATCH_MAX + 1];
+    int8_t digits[2 * ED25519_BATCH_MAX + 1][64];
+    uint8_t transcript[SHA512_DIGEST_LEN];
+    uint8_t sum_s[32];
+    sha512_ctx_t ctx;
+    ge_t p;
+
+    if (items == NULL || n == 0 || n > ED25519_BATCH_MAX) {
+        return false;
+    }
+
+    /* Transcript binding the coefficients to the whole batch */
+    sha512_init(&ctx);
+    for (size_t i = 0; i < n; i++) {
+        uint8_t len_le[8];
+        for (int j = 0; j < 8; j++) {
+            len_le[j] = (uint8_t)((uint64_t)items[i].msg_len >> (8 * j));
+        }
+        sha512_update(&ctx, items[i].sig, ED25519_SIGNATURE_LEN);
+        sha512_update(&ctx, items[i].pubkey, ED25519_PUBKEY_LEN);
+        sha512_update(&ctx, len_le, sizeof(len_le));
+        sha512_update(&ctx, items[i].msg, items[i].msg_len);
+    }
+    sha512_final(&ctx, transcript);
+
+    memset(sum_s, 0, sizeof(sum_s));
+
+    for (size_t i = 0; i < n; i++) {
+        const ed25519_batch_item_t *item = &items[i];
+        uint8_t k[32], z[32], zk[32], zero[32];
+        uint8_t zin[SHA512_DIGEST_LEN + 4];
+        uint8_t zh[SHA512_DIGEST_LEN];
+
+        if (!sc_is_canonical(item->sig + 32)) {
+            return false;
+        }
+
+        /* z_i = first 128 bits of SHA-512(transcript || i) */
+        memcpy(zin, transcript, SHA512_DIGEST_LEN);
+        zin[SHA512_DIGEST_LEN + 0] = (uint8_t)i;
+        zin[SHA512_DIGEST_LEN + 1] = (uint8_t)(i >> 8);
+        zin[SHA512_DIGEST_LEN + 2] = (uint8_t)(i >> 16);
+        zin[SHA512_DIGEST_LEN + 3] = (uint8_t)(i >> 24);
+        sha512(zin, sizeof(zin), zh);
+        memset(z, 0, sizeof(z));
+        memcpy(z, zh, 16);
+        z[0] |= 1;
+
+        challenge(k, item->sig, item->pubkey, item->msg, item->msg_len);
+        memset(zero, 0, sizeof(zero));
+        sc_muladd(zk, z, k, zero);
+        sc_muladd(sum_s, z, item->sig + 32, sum_s);
+
+        if (!ge_frombytes(&p, item->sig)) {
+            return false;
+        }
+        ge_neg(&p, &p);
+        ge_table8_init(&tables[2 * i], &p);
+        sc_recode16(digits[2 * i], z);
+
+        if (!ge_frombytes(&p, item->pubkey)) {
+            return false;
+        }
+        ge_neg(&p, &p);
+        ge_table8_init(&tables[2 * i + 1], &p);
+        sc_recode16(digits[2 * i + 1], zk);
+    }
+
+    ge_table8_init(&tables[2 * n], &GE_BASE);
+    sc_recode16(digits[2 * n], sum_s);
+
+    ge_msm(&p, digits, tables, 2 * n + 1);
+
+    /* Clear any small-order component */
+    ge_double(&p, &p);
+    ge_double(&p, &p);
+    ge_double(&p, &p);
+
+    return ge_is_identity(&p);
+}
@@ -0,0 +1,129 @@
+/*
+ * SUM Chain Host Library - Ed25519 (RFC 8032)
+ * Deterministic signing and verification for host builds, benchmarks and
+ * simulators. Not constant-time hardened; never use with production keys.
+ * Host-side only (the device uses cx_eddsa_sign_no_throw).
+ */
+
+#ifndef ED25519_H
+#define ED25519_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ED25519_SEED_LEN        32
+#define ED25519_PUBKEY_LEN      32
+#define ED25519_SIGNATURE_LEN   64
+
+/* Maximum signatures per ed25519_verify_batch call (bounds stack use) */
+#define ED25519_BATCH_MAX       16
+
+/*
+ * One (message, public key, signature) triple for batch verification.
+ */
+typedef struct {
+    const uint8_t *msg;
+    size_t         msg_len;
+    const uint8_t *pubkey;                  /* ED25519_PUBKEY_LEN bytes */
+    const uint8_t *sig;                     /* ED25519_SIGNATURE_LEN bytes */
+} ed25519_batch_item_t;
+
+/*
+ * Derive the public key of a 32-byte private key (RFC 8032 "seed").
+ *
+ * @param seed    Private key.
+ * @param pubkey  Output encoded public key.
+ */
+void ed25519_public_key(const uint8_t seed[ED25519_SEED_LEN],
+                        uint8_t pubkey[ED25519_PUBKEY_LEN]);
+
+/*
+ * Sign a message (PureEdDSA).
+ *
+ * @param seed    Private key.
+ * @param pubkey  Matching public key (from ed25519_public_key).
+ * @param msg     Message.
+ * @param msg_len Message length.
+ * @param sig     Output signature R || S.
+ */
+void ed25519_sign(const uint8_t seed[ED25519_SEED_LEN],
+                  const uint8_t pubkey[ED25519_PUBKEY_LEN],
+                  const uint8_t *msg, size_t msg_len,
+                  uint8_t sig[ED25519_SIGNATURE_LEN]);
+
+/*
+ * Public key [s]B of a raw scalar (no hashing or clamping), e.g. the kL
+ * half of a BIP32-Ed25519 extended key.
+ *
+ * @param scalar  Little-endian scalar (any 256-bit value).
+ * @param pubkey  Output encoded public key.
+ */
+void ed25519_public_key_from_scalar(const uint8_t scalar[32],
+                                    uint8_t pubkey[ED25519_PUBKEY_LEN]);
+
+/*
+ * Sign with an extended key kL || kR (BIP32-Ed25519): kL is the scalar,
+ * kR the nonce prefix, as in the expanded form of an RFC 8032 key.
+ *
+ * @param ext     Extended private key (64 bytes).
+ * @param pubkey  Matching public key (from ed25519_public_key_from_scalar).
+ * @param msg     Message.
+ * @param msg_len Message length.
+ * @param sig     Output signature R || S.
+ */
+void ed25519_sign_extended(const uint8_t ext[64],
+                           const uint8_t pubkey[ED25519_PUBKEY_LEN],
+                           const uint8_t *msg, size_t msg_len,
+                           uint8_t sig[ED25519_SIGNATURE_LEN]);
+
+/*
+ * Add two encoded points.
+ *
+ * @return false if either input does not decode.
+ */
+bool ed25519_point_add(const uint8_t p[ED25519_PUBKEY_LEN],
+                       const uint8_t q[ED25519_PUBKEY_LEN],
+                       uint8_t out[ED25519_PUBKEY_LEN]);
+
+/*
+ * Verify a signature (cofactored check [8]([S]B - R - [k]A) == 0, S < L and
+ * canonical R and A encodings required).
+ *
+ * Uses the same equation as ed25519_verify_batch, so a signature gets the
+ * same verdict alone or in any batch. R or A with a small-order component
+ * is accepted when the prime-order part checks out.
+ *
+ * @return true if the signature is valid.
+ */
+bool ed25519_verify(const uint8_t pubkey[ED25519_PUBKEY_LEN],
+                    const uint8_t *msg, size_t msg_len,
+                    const uint8_t sig[ED25519_SIGNATURE_LEN]);
+
+/*
+ * Verify up to ED25519_BATCH_MAX signatures at once.
+ *
+ * Checks [8]([sum z_i S_i]B - sum [z_i]R_i - sum [z_i k_i]A_i) == 0 with
+ * one multi-scalar multiplication (Straus, signed 4-bit windows). The 128-bit
+ * coefficients z_i are derived from a SHA-512 transcript of the whole batch,
+ * so results are deterministic. A false result only says that at least one
+ * item is invalid; verify items one by one to find it.
+ *
+ * The batch equation is cofactored, like ed25519_verify: every item is
+ * valid in the batch iff it is valid alone.
+ *
+ * @param items  Items to verify.
+ * @param n      Number of items (0 < n <= ED25519_BATCH_MAX).
+ * @return true if every signature in the batch is valid.
+ */
+bool ed25519_verify_batch(const ed25519_batch_item_t *items, size_t n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ED25519_H */
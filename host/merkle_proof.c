@@ -0,0 +1,127 @@
+/*
+ * SUM Chain Host Library - Merkle Batch Proofs Implementation
+ */
+
+#include "merkle_proof.h"
+#include <string.h>
+
+size_t merkle_tree_nodes(size_t count) {
+    size_t total = 0;
+
+    if (count == 0 || count > MERKLE_MAX_LEAVES) {
+        return 0;
+    }
+
+    for (size_t width = count; ; width = (width + 1) / 2) {
+        total += width;
+        if (width == 1) {
+            break;
+        }
+    }
+
+    return total;
+}
+
+bool merkle_tree_build(merkle_tree_t *tree, const uint8_t (*digests)[MERKLE_HASH_LEN],
+                       size_t count, uint8_t (*nodes)[MERKLE_HASH_LEN], size_t nodes_cap) {
+    size_t needed = merkle_tree_nodes(count);
+    sum_blake3_ctx_t scratch = SUM_BLAKE3_CTX_INIT;
+
+    if (tree == NULL || digests == NULL || nodes == NULL || needed == 0 || nodes_cap < needed) {
+        return false;
+    }
+
+    memset(tree, 0, sizeof(*tree));
+    tree->count = count;
+    tree->nodes = nodes;
+
+    for (size_t i = 0; i < count; i++) {
+        merkle_leaf_hash(&scratch, digests[i], nodes[i]);
+    }
+
+    size_t width = count;
+    size_t base = 0;
+    tree->levels = 1;
+
+    while (width > 1) {
+        size_t next = base + width;
+        size_t parents = width / 2;
+
+        for (size_t i = 0; i < parents; i++) {
+            merkle_node_hash(&scratch, nodes[base + 2 * i], nodes[base + 2 * i + 1],
+                             nodes[next + i]);
+        }
+        if (width & 1) {
+            memcpy(nodes[next + parents], nodes[base + width - 1], MERKLE_HASH_LEN);
+        }
+
+        base = next;
+        width = (width + 1) / 2;
+        tree->offset[tree->levels++] = base;
+    }
+
+    memcpy(tree->root, nodes[base], MERKLE_HASH_LEN);
+    sum_blake3_zeroize(&scratch);
+    return true;
+}
+
+bool merkle_tree_proof(const merkle_tree_t *tree, size_t index, merkle_proof_t *proof) {
+    if (tree == NULL || proof == NULL || index >= tree->count) {
+        return false;
+    }
+
+    memset(proof, 0, sizeof(*proof));
+    proof->index = (uint32_t)index;
+    proof->leaf_count = (uint32_t)tree->count;
+
+    size_t width = tree->count;
+    for (size_t level = 0; level + 1 < tree->levels; level++) {
+        size_t sibling = index ^ 1;
+        if (sibling < width) {
+            memcpy(proof->path[proof->length++], tree->nodes[tree->offset[level] + sibling],
+                   MERKLE_HASH_LEN);
+        }
+        index >>= 1;
+        width = (width + 1) / 2;
+    }
+
+    return true;
+}
+
+bool merkle_proof_verify(const uint8_t tx_digest[MERKLE_HASH_LEN],
+                         const merkle_proof_t *proof,
+                         const uint8_t root[MERKLE_HASH_LEN]) {
+    uint8_t hash[MERKLE_HASH_LEN];
+    sum_blake3_ctx_t scratch = SUM_BLAKE3_CTX_INIT;
+
+    if (tx_digest == NULL || proof == NULL || root == NULL ||
+        proof->leaf_count == 0 || proof->leaf_count > MERKLE_MAX_LEAVES ||
+        proof->index >= proof->leaf_count || proof->length > MERKLE_MAX_DEPTH) {
+        return false;
+    }
+
+    merkle_leaf_hash(&scratch, tx_digest, hash);
+
+    size_t index = proof->index;
+    size_t width = proof->leaf_count;
+    size_t used = 0;
+
+    while (width > 1) {
+        if (index & 1) {
+            if (used == proof->length) {
+                return false;
+            }
+            merkle_node_hash(&scratch, proof->path[used++], hash, hash);
+        } else if (index + 1 < width) {
+            if (used == proof->length) {
+                return false;
+            }
+            merkle_node_hash(&scratch, hash, proof->path[used++], hash);
+        }
+        /* else: last node of an odd level, promoted unchanged */
+        index >>= 1;
+        width = (width + 1) / 2;
+    }
+
+    return used == proof->length && memcmp(hash, root, MERKLE_HASH_LEN) == 0;
+}
@@ -0,0 +1,93 @@
+/*
+ * SUM Chain Host Library - Merkle Batch Proofs
+ * Rebuilds the INS_SIGN_MERKLE tree (src/merkle.h) from transaction digests
+ * and produces per-transaction inclusion proofs against the signed root.
+ * Host-side only (not part of the device build).
+ */
+
+#ifndef MERKLE_PROOF_H
+#define MERKLE_PROOF_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "merkle.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Full tree, stored level by level in a caller-provided arena.
+ * Level 0 holds the leaf hashes; an odd node at the end of a level is
+ * promoted unchanged, which gives exactly the device's tree shape.
+ */
+typedef struct {
+    size_t   count;                                        /* Leaves */
+    size_t   levels;                                       /* Including the root level */
+    size_t   offset[MERKLE_MAX_DEPTH + 1];                 /* First node of each level */
+    uint8_t (*nodes)[MERKLE_HASH_LEN];
+    uint8_t  root[MERKLE_HASH_LEN];
+} merkle_tree_t;
+
+/*
+ * Inclusion proof: sibling hashes from the leaf level up. Levels where the
+ * node is promoted contribute no sibling.
+ */
+typedef struct {
+    uint32_t index;                                        /* Leaf position */
+    uint32_t leaf_count;                                   /* Batch size */
+    uint8_t  length;                                       /* Siblings in path */
+    uint8_t  path[MERKLE_MAX_DEPTH][MERKLE_HASH_LEN];
+} merkle_proof_t;
+
+/*
+ * Number of arena nodes merkle_tree_build needs
+ * (below 2 * count + MERKLE_MAX_DEPTH).
+ *
+ * @param count Number of transactions.
+ * @return Node count, or 0 if count is 0 or above MERKLE_MAX_LEAVES.
+ */
+size_t merkle_tree_nodes(size_t count);
+
+/*
+ * Build the tree over transaction digests (sum_blake3 of each tx, as
+ * returned by tx_encode_transfer_batch).
+ *
+ * @param tree      Tree to initialize.
+ * @param digests   Transaction digests in stream order.
+ * @param count     Number of transactions.
+ * @param nodes     Arena of at least merkle_tree_nodes(count) entries.
+ * @param nodes_cap Arena capacity in nodes.
+ * @return false on bad arguments or a too-small arena.
+ */
+bool merkle_tree_build(merkle_tree_t *tree, const uint8_t (*digests)[MERKLE_HASH_LEN],
+                       size_t count, uint8_t (*nodes)[MERKLE_HASH_LEN], size_t nodes_cap);
+
+/*
+ * Extract the inclusion proof of one transaction (O(log n)).
+ *
+ * @param tree  Built tree.
+ * @param index Transaction position.
+ * @param proof Output proof.
+ * @return false if index is out of range.
+ */
+bool merkle_tree_proof(const merkle_tree_t *tree, size_t index, merkle_proof_t *proof);
+
+/*
+ * Check that a transaction digest is included under root.
+ *
+ * @param tx_digest sum_blake3 hash of the transaction.
+ * @param proof     Proof from merkle_tree_proof.
+ * @param root      Root returned by the device.
+ * @return true if the proof is well formed and hashes to root.
+ */
+bool merkle_proof_verify(const uint8_t tx_digest[MERKLE_HASH_LEN],
+                         const merkle_proof_t *proof,
+                         const uint8_t root[MERKLE_HASH_LEN]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MERKLE_PROOF_H */
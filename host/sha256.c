@@ -0,0 +1,169 @@
+/*
+ * SUM Chain Host Library - SHA-256 and HMAC-SHA256 Implementation (FIPS 180-4)
+ */
+
+#include "sha256.h"
+#include "globals.h"
+#include <string.h>
+
+static const uint32_t K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+static const uint32_t IV[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+};
+
+#define ROTR(x, n)  (((x) >> (n)) | ((x) << (32 - (n))))
+
+static uint32_t load_u32_be(const uint8_t *p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+           ((uint32_t)p[2] << 8)  | ((uint32_t)p[3]);
+}
+
+static void store_u32_be(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+static void sha256_compress(uint32_t state[8], const uint8_t block[SHA256_BLOCK_LEN]) {
+    uint32_t w[64];
+    uint32_t a, b, c, d, e, f, g, h;
+
+    for (int i = 0; i < 16; i++) {
+        w[i] = load_u32_be(block + 4 * i);
+    }
+    for (int i = 16; i < 64; i++) {
+        uint32_t s0 = ROTR(w[i - 15], 7) ^ ROTR(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        uint32_t s1 = ROTR(w[i - 2], 17) ^ ROTR(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    a = state[0]; b = state[1]; c = state[2]; d = state[3];
+    e = state[4]; f = state[5]; g = state[6]; h = state[7];
+
+    for (int i = 0; i < 64; i++) {
+        uint32_t s1 = ROTR(e, 6) ^ ROTR(e, 11) ^ ROTR(e, 25);
+        uint32_t ch = (e & f) ^ (~e & g);
+        uint32_t t1 = h + s1 + ch + K[i] + w[i];
+        uint32_t s0 = ROTR(a, 2) ^ ROTR(a, 13) ^ ROTR(a, 22);
+        uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+        uint32_t t2 = s0 + maj;
+        h = g; g = f; f = e; e = d + t1;
+        d = c; c = b; b = a; a = t1 + t2;
+    }
+
+    state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+    state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+
+    SECURE_ZEROIZE(w, sizeof(w));
+}
+
+void sha256_init(sha256_ctx_t *ctx) {
+    memcpy(ctx->state, IV, sizeof(IV));
+    ctx->total_len = 0;
+    ctx->buf_len = 0;
+}
+
+void sha256_update(sha256_ctx_t *ctx, const uint8_t *data, size_t len) {
+    ctx->total_len += len;
+
+    if (ctx->buf_len > 0) {
+        size_t take = SHA256_BLOCK_LEN - ctx->buf_len;
+        if (take > len) {
+            take = len;
+        }
+        memcpy(ctx->buf + ctx->buf_len, data, take);
+        ctx->buf_len += take;
+        data += take;
+        len -= take;
+        if (ctx->buf_len < SHA256_BLOCK_LEN) {
+            return;
+        }
+        sha256_compress(ctx->state, ctx->buf);
+        ctx->buf_len = 0;
+    }
+
+    while (len >= SHA256_BLOCK_LEN) {
+        sha256_compress(ctx->state, data);
+        data += SHA256_BLOCK_LEN;
+        len -= SHA256_BLOCK_LEN;
+    }
+
+    memcpy(ctx->buf, data, len);
+    ctx->buf_len = len;
+}
+
+void sha256_final(sha256_ctx_t *ctx, uint8_t out[SHA256_DIGEST_LEN]) {
+    uint64_t bits = ctx->total_len << 3;
+
+    ctx->buf[ctx->buf_len++] = 0x80;
+    if (ctx->buf_len > SHA256_BLOCK_LEN - 8) {
+        memset(ctx->buf + ctx->buf_len, 0, SHA256_BLOCK_LEN - ctx->buf_len);
+        sha256_compress(ctx->state, ctx->buf);
+        ctx->buf_len = 0;
+    }
+    memset(ctx->buf + ctx->buf_len, 0, SHA256_BLOCK_LEN - 8 - ctx->buf_len);
+    store_u32_be(ctx->buf + SHA256_BLOCK_LEN - 8, (uint32_t)(bits >> 32));
+    store_u32_be(ctx->buf + SHA256_BLOCK_LEN - 4, (uint32_t)bits);
+    sha256_compress(ctx->state, ctx->buf);
+
+    for (int i = 0; i < 8; i++) {
+        store_u32_be(out + 4 * i, ctx->state[i]);
+    }
+
+    SECURE_ZEROIZE(ctx, sizeof(*ctx));
+}
+
+void sha256(const uint8_t *data, size_t len, uint8_t out[SHA256_DIGEST_LEN]) {
+    sha256_ctx_t ctx;
+    sha256_init(&ctx);
+    sha256_update(&ctx, data, len);
+    sha256_final(&ctx, out);
+}
+
+void hmac_sha256(const uint8_t *key, size_t key_len,
+                 const uint8_t *data, size_t data_len,
+                 uint8_t out[SHA256_DIGEST_LEN]) {
+    uint8_t k[SHA256_BLOCK_LEN];
+    uint8_t pad[SHA256_BLOCK_LEN];
+    uint8_t inner[SHA256_DIGEST_LEN];
+    sha256_ctx_t ctx;
+
+    memset(k, 0, sizeof(k));
+    if (key_len > SHA256_BLOCK_LEN) {
+        sha256(key, key_len, k);
+    } else {
+        memcpy(k, key, key_len);
+    }
+
+    for (size_t i = 0; i < SHA256_BLOCK_LEN; i++) {
+        pad[i] = k[i] ^ 0x36;
+    }
+    sha256_init(&ctx);
+    sha256_update(&ctx, pad, sizeof(pad));
+    sha256_update(&ctx, data, data_len);
+    sha256_final(&ctx, inner);
+
+    for (size_t i = 0; i < SHA256_BLOCK_LEN; i++) {
+        pad[i] = k[i] ^ 0x5c;
+    }
+    sha256_init(&ctx);
+    sha256_update(&ctx, pad, sizeof(pad));
+    sha256_update(&ctx, inner, sizeof(inner));
+    sha256_final(&ctx, out);
+
+    SECURE_ZEROIZE(k, sizeof(k));
+    SECURE_ZEROIZE(pad, sizeof(pad));
+    SECURE_ZEROIZE(inner, sizeof(inner));
+}
@@ -0,0 +1,51 @@
+/*
+ * SUM Chain Host Library - SHA-256 and HMAC-SHA256
+ * Used by BIP32-Ed25519 master key derivation (chain code).
+ * Host-side only (the device uses cx_hash / cx_hmac from the SDK).
+ */
+
+#ifndef SHA256_H
+#define SHA256_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SHA256_DIGEST_LEN   32
+#define SHA256_BLOCK_LEN    64
+
+typedef struct {
+    uint32_t state[8];
+    uint64_t total_len;                     /* Bytes absorbed */
+    uint8_t  buf[SHA256_BLOCK_LEN];
+    size_t   buf_len;
+} sha256_ctx_t;
+
+void sha256_init(sha256_ctx_t *ctx);
+void sha256_update(sha256_ctx_t *ctx, const uint8_t *data, size_t len);
+
+/*
+ * Write the digest and wipe the context.
+ */
+void sha256_final(sha256_ctx_t *ctx, uint8_t out[SHA256_DIGEST_LEN]);
+
+/*
+ * One-shot SHA-256.
+ */
+void sha256(const uint8_t *data, size_t len, uint8_t out[SHA256_DIGEST_LEN]);
+
+/*
+ * One-shot HMAC-SHA256 (RFC 2104).
+ */
+void hmac_sha256(const uint8_t *key, size_t key_len,
+                 const uint8_t *data, size_t data_len,
+                 uint8_t out[SHA256_DIGEST_LEN]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SHA256_H */
@@ -0,0 +1,51 @@
+/*
+ * SUM Chain Host Library - SHA-512 and HMAC-SHA512
+ * Used by the host Ed25519 backend and SLIP-10 derivation.
+ * Host-side only (the device uses cx_hash / cx_hmac from the SDK).
+ */
+
+#ifndef SHA512_H
+#define SHA512_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SHA512_DIGEST_LEN   64
+#define SHA512_BLOCK_LEN    128
+
+typedef struct {
+    uint64_t state[8];
+    uint64_t total_len;                     /* Bytes absorbed (messages < 2^61 bytes) */
+    uint8_t  buf[SHA512_BLOCK_LEN];
+    size_t   buf_len;
+} sha512_ctx_t;
+
+void sha512_init(sha512_ctx_t *ctx);
+void sha512_update(sha512_ctx_t *ctx, const uint8_t *data, size_t len);
+
+/*
+ * Write the digest and wipe the context.
+ */
+void sha512_final(sha512_ctx_t *ctx, uint8_t out[SHA512_DIGEST_LEN]);
+
+/*
+ * One-shot SHA-512.
+ */
+void sha512(const uint8_t *data, size_t len, uint8_t out[SHA512_DIGEST_LEN]);
+
+/*
+ * One-shot HMAC-SHA512 (RFC 2104).
+ */
+void hmac_sha512(const uint8_t *key, size_t key_len,
+                 const uint8_t *data, size_t data_len,
+                 uint8_t out[SHA512_DIGEST_LEN]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SHA512_H */
@@ -0,0 +1,123 @@
+/*
+ * SUM Chain Host Library - Batch Signature Verifier Implementation
+ */
+
+#include "sig_verify.h"
+#include "ed25519.h"
+#include "crypto/sum_blake3.h"
+#include <pthread.h>
+#include <unistd.h>
+
+typedef struct {
+    const sig_verify_item_t *items;
+    size_t                   count;
+    bool                    *valid;
+    size_t                   invalid;
+} verify_slice_t;
+
+/* Verify one group of at most ED25519_BATCH_MAX items */
+static size_t verify_group(const sig_verify_item_t *items, size_t n, bool *valid) {
+    uint8_t hashes[ED25519_BATCH_MAX][HASH_LEN];
+    ed25519_batch_item_t batch[ED25519_BATCH_MAX];
+    size_t invalid = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        sum_blake3_hash(items[i].tx, items[i].tx_len, hashes[i]);
+        batch[i].msg = hashes[i];
+        batch[i].msg_len = HASH_LEN;
+        batch[i].pubkey = items[i].pubkey;
+        batch[i].sig = items[i].signature;
+    }
+
+    if (ed25519_verify_batch(batch, n)) {
+        for (size_t i = 0; i < n; i++) {
+            valid[i] = true;
+        }
+        return 0;
+    }
+
+    /* Isolate the failures */
+    for (size_t i = 0; i < n; i++) {
+        valid[i] = ed25519_verify(batch[i].pubkey, batch[i].msg, batch[i].msg_len, batch[i].sig);
+        if (!valid[i]) {
+            invalid++;
+        }
+    }
+    return invalid;
+}
+
+static void *verify_slice(void *arg) {
+    verify_slice_t *s = (verify_slice_t *)arg;
+
+    s->invalid = 0;
+    for (size_t off = 0; off < s->count; off += ED25519_BATCH_MAX) {
+        size_t n = s->count - off;
+        if (n > ED25519_BATCH_MAX) {
+            n = ED25519_BATCH_MAX;
+        }
+        s->invalid += verify_group(s->items + off, n, s->valid + off);
+    }
+    return NULL;
+}
+
+size_t sig_verify_batch(const sig_verify_item_t *items, size_t count, bool *valid,
+                        unsigned num_threads) {
+    verify_slice_t slices[SIG_VERIFY_MAX_THREADS];
+    pthread_t threads[SIG_VERIFY_MAX_THREADS];
+    bool started[SIG_VERIFY_MAX_THREADS];
+    size_t invalid = 0;
+
+    if (items == NULL || valid == NULL || count == 0) {
+        return 0;
+    }
+
+    if (num_threads == 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        num_threads = (cpus > 0) ? (unsigned)cpus : 1;
+    }
+    if (num_threads > SIG_VERIFY_MAX_THREADS) {
+        num_threads = SIG_VERIFY_MAX_THREADS;
+    }
+
+    /* No point in a thread with less than one full group */
+    size_t groups = (count + ED25519_BATCH_MAX - 1) / ED25519_BATCH_MAX;
+    if (num_threads > groups) {
+        num_threads = (unsigned)groups;
+    }
+
+    /* Slices are whole groups so every thread batches fully */
+    size_t per_thread = ((groups + num_threads - 1) / num_threads) * ED25519_BATCH_MAX;
+    for (unsigned t = 0; t < num_threads; t++) {
+        size_t begin = (size_t)t * per_thread;
+        size_t end = begin + per_thread;
+        if (begin > count) {
+            begin = count;
+        }
+        if (end > count) {
+            end = count;
+        }
+        slices[t].items = items + begin;
+        slices[t].count = end - begin;
+        slices[t].valid = valid + begin;
+        slices[t].invalid = 0;
+        started[t] = false;
+    }
+
+    /* Slice 0 runs on the calling thread; fall back inline if a spawn fails */
+    for (unsigned t = 1; t < num_threads; t++) {
+        started[t] = pthread_create(&threads[t], NULL, verify_slice, &slices[t]) == 0;
+        if (!started[t]) {
+            verify_slice(&slices[t]);
+        }
+    }
+    verify_slice(&slices[0]);
+
+    for (unsigned t = 0; t < num_threads; t++) {
+        if (started[t]) {
+            pthread_join(threads[t], NULL);
+        }
+        invalid += slices[t].invalid;
+    }
+
+    return invalid;
+}
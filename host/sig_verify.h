@@ -0,0 +1,55 @@
+/*
+ * SUM Chain Host Library - Batch Signature Verifier
+ * Checks device signatures over BLAKE3(tx) before broadcast.
+ * Host-side only (not part of the device build).
+ */
+
+#ifndef SIG_VERIFY_H
+#define SIG_VERIFY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "globals.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Upper bound on worker threads */
+#define SIG_VERIFY_MAX_THREADS   64
+
+/*
+ * One signed transaction. All pointers are borrowed.
+ */
+typedef struct {
+    const uint8_t *tx;                      /* Encoded transaction */
+    size_t         tx_len;
+    const uint8_t *pubkey;                  /* PUBKEY_LEN bytes */
+    const uint8_t *signature;               /* SIGNATURE_LEN bytes */
+} sig_verify_item_t;
+
+/*
+ * Verify signatures over sum_blake3(tx).
+ *
+ * Items are split into contiguous slices, one per thread. Each thread hashes
+ * its transactions and verifies them in groups of ED25519_BATCH_MAX with one
+ * multi-scalar multiplication per group; a group that fails is re-checked
+ * item by item so only the bad signatures are reported. Both checks use the
+ * cofactored equation, so an item's verdict never depends on its group.
+ *
+ * @param items        Items to verify.
+ * @param count        Number of items.
+ * @param valid        Output: valid[i] is true iff item i verified.
+ * @param num_threads  Worker threads (0 = online CPUs, capped at
+ *                     SIG_VERIFY_MAX_THREADS; 1 = run on the calling thread).
+ * @return Number of invalid signatures.
+ */
+size_t sig_verify_batch(const sig_verify_item_t *items, size_t count, bool *valid,
+                        unsigned num_threads);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIG_VERIFY_H */
@@ -0,0 +1,396 @@
+/*
+ * SUM Chain Host Library - Multi-device Signing Scheduler Implementation
+ */
+
+#include "sign_scheduler.h"
+#include <string.h>
+#include <time.h>
+
+/*
+ * Queue helpers (intrusive deque)
+ */
+
+static void queue_push_back(sign_worker_t *w, sign_job_t *job) {
+    job->next = NULL;
+    job->prev = w->q_tail;
+    if (w->q_tail != NULL) {
+        w->q_tail->next = job;
+    } else {
+        w->q_head = job;
+    }
+    w->q_tail = job;
+    w->q_len++;
+}
+
+static void queue_push_front(sign_worker_t *w, sign_job_t *job) {
+    job->prev = NULL;
+    job->next = w->q_head;
+    if (w->q_head != NULL) {
+        w->q_head->prev = job;
+    } else {
+        w->q_tail = job;
+    }
+    w->q_head = job;
+    w->q_len++;
+}
+
+static sign_job_t *queue_pop_front(sign_worker_t *w) {
+    sign_job_t *job = w->q_head;
+    if (job == NULL) {
+        return NULL;
+    }
+    w->q_head = job->next;
+    if (w->q_head != NULL) {
+        w->q_head->prev = NULL;
+    } else {
+        w->q_tail = NULL;
+    }
+    w->q_len--;
+    job->next = job->prev = NULL;
+    return job;
+}
+
+static sign_job_t *queue_pop_back(sign_worker_t *w) {
+    sign_job_t *job = w->q_tail;
+    if (job == NULL) {
+        return NULL;
+    }
+    w->q_tail = job->prev;
+    if (w->q_tail != NULL) {
+        w->q_tail->next = NULL;
+    } else {
+        w->q_head = NULL;
+    }
+    w->q_len--;
+    job->next = job->prev = NULL;
+    return job;
+}
+
+/*
+ * Routing
+ */
+
+static bool path_has_prefix(const bip32_path_t *path, const bip32_path_t *prefix) {
+    if (prefix->length > path->length || prefix->scheme != path->scheme) {
+        return false;
+    }
+    for (uint8_t i = 0; i < prefix->length; i++) {
+        if (path->path[i] != prefix->path[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool worker_holds_path(const sign_worker_t *w, const bip32_path_t *path) {
+    for (size_t i = 0; i < w->num_prefixes; i++) {
+        if (path_has_prefix(path, &w->prefixes[i])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static size_t worker_load(const sign_worker_t *w) {
+    return w->q_len + (w->active != NULL ? 1 : 0);
+}
+
+/*
+ * Pick the least loaded live worker for a job. When `seed_group` is
+ * non-NULL, any worker in that group qualifies (the seed can derive the
+ * path); otherwise the worker must list the path. `avoid` is skipped when
+ * another candidate exists.
+ */
+static sign_worker_t *pick_worker(sign_scheduler_t *s, const sign_job_t *job,
+                                  const uint32_t *seed_group, const sign_worker_t *avoid) {
+    sign_worker_t *best = NULL;
+    sign_worker_t *fallback = NULL;
+
+    for (size_t i = 0; i < s->num_workers; i++) {
+        sign_worker_t *w = &s->workers[i];
+        if (w->failed) {
+            continue;
+        }
+        bool eligible = (seed_group != NULL) ? (w->seed_group == *seed_group)
+                                             : worker_holds_path(w, &job->path);
+        if (!eligible) {
+            continue;
+        }
+        if (w == avoid) {
+            fallback = w;
+            continue;
+        }
+        if (best == NULL || worker_load(w) < worker_load(best)) {
+            best = w;
+        }
+    }
+
+    return (best != NULL) ? best : fallback;
+}
+
+static void job_complete(sign_scheduler_t *s, sign_job_t *job, sign_job_status_t status) {
+    job->status = status;
+    if (s->outstanding > 0) {
+        s->outstanding--;
+    }
+    if (job->done != NULL) {
+        job->done(job, job->user);
+    }
+}
+
+/* Put a job back in line, preferring a different device of the same seed */
+static void job_requeue(sign_scheduler_t *s, sign_job_t *job, sign_worker_t *from) {
+    sign_worker_t *to = pick_worker(s, job, &from->seed_group, from);
+    if (to == NULL) {
+        to = pick_worker(s, job, NULL, NULL);
+    }
+    if (to == NULL) {
+        job_complete(s, job, SIGN_JOB_NO_DEVICE);
+        return;
+    }
+    queue_push_front(to, job);
+}
+
+/* Take a failed worker out of rotation and hand its queue to its peers */
+static void worker_fail(sign_scheduler_t *s, sign_worker_t *w) {
+    w->failed = true;
+    sign_job_t *job;
+    while ((job = queue_pop_front(w)) != NULL) {
+        job_requeue(s, job, w);
+    }
+}
+
+/*
+ * Device completion
+ */
+
+static void on_request_done(apdu_request_t *req, void *user) {
+    sign_worker_t *w = (sign_worker_t *)user;
+    sign_scheduler_t *s = w->sched;
+    sign_job_t *job = w->active;
+
+    w->active = NULL;
+    if (job == NULL) {
+        return;
+    }
+
+    job->sw = req->sw;
+    job->worker = (size_t)(w - s->workers);
+
+    switch (req->status) {
+        case APDU_STATUS_OK:
+            if (req->resp_len != SIGNATURE_LEN) {
+                job_complete(s, job, SIGN_JOB_FAILED);
+                break;
+            }
+            memcpy(job->signature, req->resp, SIGNATURE_LEN);
+            w->completed++;
+            job_complete(s, job, SIGN_JOB_SIGNED);
+            break;
+
+        case APDU_STATUS_SW_ERROR:
+            if (sign_scheduler_sw_retryable(req->sw) && job->attempts < s->max_attempts) {
+                w->retried++;
+                job_requeue(s, job, w);
+            } else {
+                job_complete(s, job, SIGN_JOB_FAILED);
+            }
+            break;
+
+        default:
+            /* Transport failure: the job never reached a verdict, so retry elsewhere */
+            worker_fail(s, w);
+            if (job->attempts < s->max_attempts) {
+                job_requeue(s, job, w);
+            } else {
+                job_complete(s, job, SIGN_JOB_FAILED);
+            }
+            break;
+    }
+}
+
+/* Give an idle worker its next job: own queue first, then steal */
+static sign_job_t *worker_next_job(sign_scheduler_t *s, sign_worker_t *w) {
+    sign_job_t *job = queue_pop_front(w);
+    if (job != NULL) {
+        return job;
+    }
+
+    /* Steal from the back of the longest queue among same-seed peers */
+    sign_worker_t *victim = NULL;
+    for (size_t i = 0; i < s->num_workers; i++) {
+        sign_worker_t *v = &s->workers[i];
+        if (v == w || v->seed_group != w->seed_group || v->q_len == 0) {
+            continue;
+        }
+        if (victim == NULL || v->q_len > victim->q_len) {
+            victim = v;
+        }
+    }
+    if (victim == NULL) {
+        return NULL;
+    }
+
+    w->stolen++;
+    return queue_pop_back(victim);
+}
+
+static void worker_start(sign_scheduler_t *s, sign_worker_t *w) {
+    while (!w->failed && w->active == NULL) {
+        sign_job_t *job = worker_next_job(s, w);
+        if (job == NULL) {
+            return;
+        }
+
+        job->attempts++;
+        if (!apdu_request_init_sign_tx(&w->req, &job->path, job->tx, job->tx_len, 0,
+                                       on_request_done, w)) {
+            job_complete(s, job, SIGN_JOB_FAILED);
+            continue;
+        }
+        w->active = job;
+        apdu_device_submit(w->dev, &w->req);
+    }
+}
+
+/*
+ * Public API
+ */
+
+bool sign_scheduler_sw_retryable(uint16_t sw) {
+    return sw == SW_SESSION_ERROR || sw == SW_TX_PARSE_ERROR;
+}
+
+void sign_worker_init(sign_worker_t *w, apdu_device_t *dev, uint32_t seed_group,
+                      const bip32_path_t *prefixes, size_t num_prefixes) {
+    if (w == NULL) {
+        return;
+    }
+    memset(w, 0, sizeof(*w));
+    w->dev = dev;
+    w->seed_group = seed_group;
+    w->prefixes = prefixes;
+    w->num_prefixes = (prefixes != NULL) ? num_prefixes : 0;
+    w->failed = (dev == NULL);
+}
+
+void sign_scheduler_init(sign_scheduler_t *s, sign_worker_t *workers, size_t num_workers,
+                         unsigned max_attempts) {
+    if (s == NULL) {
+        return;
+    }
+    if (num_workers > SIGN_SCHEDULER_MAX_WORKERS) {
+        num_workers = SIGN_SCHEDULER_MAX_WORKERS;
+    }
+    s->workers = workers;
+    s->num_workers = (workers != NULL) ? num_workers : 0;
+    s->max_attempts = (max_attempts > 0) ? max_attempts : 1;
+    s->outstanding = 0;
+    for (size_t i = 0; i < s->num_workers; i++) {
+        workers[i].sched = s;
+    }
+}
+
+void sign_job_init(sign_job_t *job, const bip32_path_t *path, const uint8_t *tx, size_t tx_len,
+                   sign_job_done_cb_t done, void *user) {
+    if (job == NULL) {
+        return;
+    }
+    memset(job, 0, sizeof(*job));
+    if (path != NULL) {
+        job->path = *path;
+    }
+    job->tx = tx;
+    job->tx_len = tx_len;
+    job->done = done;
+    job->user = user;
+}
+
+int sign_scheduler_submit(sign_scheduler_t *s, sign_job_t *job) {
+    if (s == NULL || job == NULL) {
+        return -1;
+    }
+
+    job->status = SIGN_JOB_PENDING;
+    job->attempts = 0;
+    s->outstanding++;
+
+    sign_worker_t *w = pick_worker(s, job, NULL, NULL);
+    if (w == NULL) {
+        job_complete(s, job, SIGN_JOB_NO_DEVICE);
+        return -1;
+    }
+
+    queue_push_back(w, job);
+    return 0;
+}
+
+int sign_scheduler_poll(sign_scheduler_t *s, int timeout_ms) {
+    apdu_device_t *devs[SIGN_SCHEDULER_MAX_WORKERS];
+    size_t n = 0;
+
+    if (s == NULL) {
+        return -1;
+    }
+
+    for (size_t i = 0; i < s->num_workers; i++) {
+        sign_worker_t *w = &s->workers[i];
+
+        /* Transport errors are reported per request; also catch a device that died idle */
+        if (!w->failed && w->dev->failed) {
+            worker_fail(s, w);
+        }
+        worker_start(s, w);
+        devs[n++] = w->failed ? NULL : w->dev;
+    }
+
+    if (apdu_client_poll(devs, n, timeout_ms) < 0) {
+        return -1;
+    }
+
+    return (int)s->outstanding;
+}
+
+static int64_t monotonic_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+/* Exchanges completed across the rack; any change means progress */
+static uint64_t total_exchanges(const sign_scheduler_t *s) {
+    uint64_t total = 0;
+    for (size_t i = 0; i < s->num_workers; i++) {
+        if (s->workers[i].dev != NULL) {
+            total += s->workers[i].dev->exchanges;
+        }
+    }
+    return total + s->outstanding;
+}
+
+int sign_scheduler_run(sign_scheduler_t *s, int timeout_ms) {
+    if (s == NULL) {
+        return -1;
+    }
+
+    uint64_t last = total_exchanges(s);
+    int64_t since = monotonic_ms();
+
+    for (;;) {
+        int outstanding = sign_scheduler_poll(s, timeout_ms > 0 ? timeout_ms : -1);
+        if (outstanding <= 0) {
+            return outstanding;
+        }
+
+        /* Timeout applies to the gap between two completed exchanges */
+        if (timeout_ms > 0) {
+            uint64_t now_progress = total_exchanges(s);
+            if (now_progress != last) {
+                last = now_progress;
+                since = monotonic_ms();
+            } else if (monotonic_ms() - since >= timeout_ms) {
+                return -1;
+            }
+        }
+    }
+}
@@ -0,0 +1,146 @@
+/*
+ * SUM Chain Host Library - Multi-device Signing Scheduler
+ * Routes SIGN_TX jobs to devices by derivation path, keeps a queue per device,
+ * lets idle devices steal queued work from busy devices that share a seed,
+ * and retries jobs that fail with a transient session or parse error.
+ * Host-side only (not part of the device build).
+ */
+
+#ifndef SIGN_SCHEDULER_H
+#define SIGN_SCHEDULER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "apdu_client.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SIGN_SCHEDULER_MAX_WORKERS  64
+
+/*
+ * Job status.
+ */
+typedef enum {
+    SIGN_JOB_PENDING = 0,
+    SIGN_JOB_SIGNED,                   /* signature is valid */
+    SIGN_JOB_FAILED,                   /* Device refused (see sw) or retries exhausted */
+    SIGN_JOB_NO_DEVICE                 /* No live device holds the path */
+} sign_job_status_t;
+
+struct sign_job;
+typedef void (*sign_job_done_cb_t)(struct sign_job *job, void *user);
+
+/*
+ * A signing job. Owned by the caller; tx must stay valid until completion.
+ */
+typedef struct sign_job {
+    /* Input */
+    bip32_path_t        path;
+    const uint8_t      *tx;
+    size_t              tx_len;
+    sign_job_done_cb_t  done;
+    void               *user;
+
+    /* Result */
+    sign_job_status_t   status;
+    uint16_t            sw;            /* Last status word received */
+    uint8_t             signature[SIGNATURE_LEN];
+    unsigned            attempts;      /* Exchanges started for this job */
+    size_t              worker;        /* Worker that produced the result */
+
+    /* Internal */
+    struct sign_job    *prev;
+    struct sign_job    *next;
+} sign_job_t;
+
+/*
+ * One device in the rack.
+ * `prefixes` lists the derivation paths (or path prefixes) the device serves;
+ * devices with the same `seed_group` hold the same seed and may take each
+ * other's jobs.
+ */
+typedef struct {
+    apdu_device_t      *dev;
+    uint32_t            seed_group;
+    const bip32_path_t *prefixes;
+    size_t              num_prefixes;
+
+    /* Internal */
+    struct sign_scheduler *sched;
+    sign_job_t         *q_head;        /* Waiting jobs; owner pops front, thieves take back */
+    sign_job_t         *q_tail;
+    size_t              q_len;
+    sign_job_t         *active;
+    apdu_request_t      req;
+    bool                failed;
+
+    /* Statistics */
+    uint64_t            completed;
+    uint64_t            stolen;        /* Jobs taken from other workers' queues */
+    uint64_t            retried;       /* Transient errors seen on this device */
+} sign_worker_t;
+
+typedef struct sign_scheduler {
+    sign_worker_t      *workers;
+    size_t              num_workers;
+    unsigned            max_attempts;  /* Per job, including the first */
+    size_t              outstanding;   /* Submitted and not yet completed */
+} sign_scheduler_t;
+
+/*
+ * Initialize a worker around a device.
+ */
+void sign_worker_init(sign_worker_t *w, apdu_device_t *dev, uint32_t seed_group,
+                      const bip32_path_t *prefixes, size_t num_prefixes);
+
+/*
+ * Initialize a scheduler over caller-provided workers
+ * (at most SIGN_SCHEDULER_MAX_WORKERS).
+ *
+ * @param max_attempts Attempts per job for retryable errors (minimum 1).
+ */
+void sign_scheduler_init(sign_scheduler_t *s, sign_worker_t *workers, size_t num_workers,
+                         unsigned max_attempts);
+
+/*
+ * Prepare a job.
+ */
+void sign_job_init(sign_job_t *job, const bip32_path_t *path, const uint8_t *tx, size_t tx_len,
+                   sign_job_done_cb_t done, void *user);
+
+/*
+ * Queue a job on the least loaded live worker that holds its path.
+ *
+ * @return 0 on success; -1 if no worker holds the path (the job completes
+ *         immediately with SIGN_JOB_NO_DEVICE).
+ */
+int sign_scheduler_submit(sign_scheduler_t *s, sign_job_t *job);
+
+/*
+ * Make progress: start or steal work for idle workers and poll devices.
+ *
+ * @return Number of outstanding jobs, or -1 on a poll failure.
+ */
+int sign_scheduler_poll(sign_scheduler_t *s, int timeout_ms);
+
+/*
+ * Run until every submitted job has completed.
+ *
+ * @param timeout_ms Maximum wait for any single response; 0 waits forever.
+ * @return 0 on completion, -1 on timeout or poll failure.
+ */
+int sign_scheduler_run(sign_scheduler_t *s, int timeout_ms);
+
+/*
+ * Whether a status word is worth retrying (session lost or stream corrupted).
+ */
+bool sign_scheduler_sw_retryable(uint16_t sw);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIGN_SCHEDULER_H */
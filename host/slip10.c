@@ -0,0 +1,49 @@
+/*
+ * SUM Chain Host Library - SLIP-10 Ed25519 Key Derivation Implementation
+ */
+
+#include "slip10.h"
+#include "sha512.h"
+#include "globals.h"
+#include <string.h>
+
+static const char ED25519_CURVE_KEY[] = "ed25519 seed";
+
+bool slip10_ed25519_derive(const uint8_t *seed, size_t seed_len,
+                           const uint32_t *path, size_t path_len,
+                           uint8_t priv32[32], uint8_t chain32[32]) {
+    uint8_t node[SHA512_DIGEST_LEN];          /* key || chain code */
+    uint8_t data[1 + 32 + 4];
+    bool ok = true;
+
+    hmac_sha512((const uint8_t *)ED25519_CURVE_KEY, sizeof(ED25519_CURVE_KEY) - 1,
+                seed, seed_len, node);
+
+    for (size_t i = 0; i < path_len; i++) {
+        uint32_t index = path[i];
+        if ((index & 0x80000000u) == 0) {
+            ok = false;
+            break;
+        }
+
+        /* I = HMAC-SHA512(chain, 0x00 || key || ser32(index)) */
+        data[0] = 0x00;
+        memcpy(data + 1, node, 32);
+        data[33] = (uint8_t)(index >> 24);
+        data[34] = (uint8_t)(index >> 16);
+        data[35] = (uint8_t)(index >> 8);
+        data[36] = (uint8_t)index;
+        hmac_sha512(node + 32, 32, data, sizeof(data), node);
+    }
+
+    if (ok) {
+        memcpy(priv32, node, 32);
+        if (chain32 != NULL) {
+            memcpy(chain32, node + 32, 32);
+        }
+    }
+
+    SECURE_ZEROIZE(node, sizeof(node));
+    SECURE_ZEROIZE(data, sizeof(data));
+    return ok;
+}
@@ -0,0 +1,38 @@
+/*
+ * SUM Chain Host Library - SLIP-10 Ed25519 Key Derivation
+ * Same derivation as os_perso_derive_node_bip32_seed_key(HDW_ED25519_SLIP10)
+ * on the device. Host-side only.
+ */
+
+#ifndef SLIP10_H
+#define SLIP10_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Derive the Ed25519 private key and chain code for a path.
+ * SLIP-10 Ed25519 only defines hardened children.
+ *
+ * @param seed       Master seed (BIP39 seed or raw test seed).
+ * @param seed_len   Seed length.
+ * @param path       Path components (hardened bit set).
+ * @param path_len   Number of components (0 = master node).
+ * @param priv32     Output private key.
+ * @param chain32    Output chain code (may be NULL).
+ * @return false if a component is not hardened.
+ */
+bool slip10_ed25519_derive(const uint8_t *seed, size_t seed_len,
+                           const uint32_t *path, size_t path_len,
+                           uint8_t priv32[32], uint8_t chain32[32]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SLIP10_H */
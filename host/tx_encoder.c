@@ -0,0 +1,170 @@
+/*
+ * SUM Chain Host Library - Transaction Encoder Implementation
+ *
+ * Mirrors the layout documented in src/tx_parser.c (all multi-byte integers
+ * little-endian).
+ */
+
+#include "tx_encoder.h"
+#include "crypto/sum_blake3.h"
+#include <string.h>
+
+/* Helper: write u64 little-endian to buffer */
+static void write_u64_le(uint8_t *buf, uint64_t value) {
+    buf[0] = (uint8_t)(value);
+    buf[1] = (uint8_t)(value >> 8);
+    buf[2] = (uint8_t)(value >> 16);
+    buf[3] = (uint8_t)(value >> 24);
+    buf[4] = (uint8_t)(value >> 32);
+    buf[5] = (uint8_t)(value >> 40);
+    buf[6] = (uint8_t)(value >> 48);
+    buf[7] = (uint8_t)(value >> 56);
+}
+
+/* Write one Transfer transaction; `out` must hold TX_TRANSFER_ENCODED_LEN bytes */
+static void encode_transfer_fields(uint8_t *out,
+                                   uint8_t version,
+                                   uint64_t chain_id,
+                                   const uint8_t sender[ADDRESS_LEN],
+                                   uint64_t nonce,
+                                   uint64_t gas_price,
+                                   uint64_t gas_limit,
+                                   const uint8_t recipient[ADDRESS_LEN],
+                                   uint64_t amount) {
+    out[0] = version;
+    write_u64_le(&out[1], chain_id);
+    memcpy(&out[9], sender, ADDRESS_LEN);
+    write_u64_le(&out[29], nonce);
+    write_u64_le(&out[37], gas_price);
+    write_u64_le(&out[45], gas_limit);
+    out[53] = TX_TYPE_TRANSFER;
+    memcpy(&out[54], recipient, ADDRESS_LEN);
+    write_u64_le(&out[74], amount);
+}
+
+void tx_arena_init(tx_arena_t *arena, uint8_t *buf, size_t buf_len) {
+    if (arena == NULL) {
+        return;
+    }
+    arena->base = buf;
+    arena->capacity = (buf != NULL) ? buf_len : 0;
+    arena->used = 0;
+}
+
+size_t tx_encode_transfer(const tx_parsed_t *tx, uint8_t *out, size_t out_len) {
+    if (tx == NULL || out == NULL || out_len < TX_TRANSFER_ENCODED_LEN) {
+        return 0;
+    }
+
+    encode_transfer_fields(out, tx->version, tx->chain_id, tx->sender, tx->nonce,
+                           tx->gas_price, tx->gas_limit, tx->recipient, tx->amount);
+
+    return TX_TRANSFER_ENCODED_LEN;
+}
+
+size_t tx_encode_call(const tx_parsed_t *tx, const uint8_t *data, size_t data_len,
+                      uint8_t *out, size_t out_len) {
+    if (tx == NULL || out == NULL || (data == NULL && data_len > 0) ||
+        data_len > MAX_TX_SIZE - TX_CALL_HEADER_LEN ||
+        out_len < TX_CALL_HEADER_LEN + data_len) {
+        return 0;
+    }
+
+    encode_transfer_fields(out, tx->version, tx->chain_id, tx->sender, tx->nonce,
+                           tx->gas_price, tx->gas_limit, tx->recipient, tx->amount);
+    out[53] = TX_TYPE_CALL;
+    out[82] = (uint8_t)(data_len);
+    out[83] = (uint8_t)(data_len >> 8);
+    out[84] = (uint8_t)(data_len >> 16);
+    out[85] = (uint8_t)(data_len >> 24);
+    if (data_len > 0) {
+        memcpy(&out[TX_CALL_HEADER_LEN], data, data_len);
+    }
+
+    return TX_CALL_HEADER_LEN + data_len;
+}
+
+size_t tx_encode_multi_transfer(const tx_parsed_t *tx,
+                                const uint8_t (*recipients)[ADDRESS_LEN],
+                                const uint64_t *amounts, size_t count,
+                                uint8_t *out, size_t out_len) {
+    if (tx == NULL || recipients == NULL || amounts == NULL || out == NULL ||
+        count == 0 || count > UINT16_MAX ||
+        count > (MAX_TX_SIZE - TX_MULTI_HEADER_LEN) / TX_MULTI_PAIR_LEN ||
+        out_len < TX_MULTI_HEADER_LEN + count * TX_MULTI_PAIR_LEN) {
+        return 0;
+    }
+
+    /* Header as a Transfer; the pair area starts where the recipient would */
+    encode_transfer_fields(out, tx->version, tx->chain_id, tx->sender, tx->nonce,
+                           tx->gas_price, tx->gas_limit, recipients[0], amounts[0]);
+    out[53] = TX_TYPE_MULTI_TRANSFER;
+    out[54] = (uint8_t)(count);
+    out[55] = (uint8_t)(count >> 8);
+
+    uint8_t *pair = &out[TX_MULTI_HEADER_LEN];
+    for (size_t i = 0; i < count; i++) {
+        memcpy(pair, recipients[i], ADDRESS_LEN);
+        write_u64_le(&pair[ADDRESS_LEN], amounts[i]);
+        pair += TX_MULTI_PAIR_LEN;
+    }
+
+    return TX_MULTI_HEADER_LEN + count * TX_MULTI_PAIR_LEN;
+}
+
+size_t tx_encode_transfer_batch(const tx_transfer_batch_t *batch,
+                                tx_arena_t *arena,
+                                size_t *offsets,
+                                uint8_t (*hashes)[HASH_LEN]) {
+    if (batch == NULL || arena == NULL || arena->base == NULL) {
+        return 0;
+    }
+
+    /* Every NULL column falls back to the template */
+    const tx_parsed_t *d = batch->defaults;
+    if (d == NULL &&
+        (batch->chain_id == NULL || batch->sender == NULL || batch->nonce == NULL ||
+         batch->gas_price == NULL || batch->gas_limit == NULL ||
+         batch->recipient == NULL || batch->amount == NULL)) {
+        return 0;
+    }
+
+    uint8_t version = (d != NULL) ? d->version : 1;
+    size_t room = (arena->capacity - arena->used) / TX_TRANSFER_ENCODED_LEN;
+    size_t n = (batch->count < room) ? batch->count : room;
+
+    /*
+     * One hasher for the whole batch: reset per tx instead of init/zeroize,
+     * since nothing hashed here is secret.
+     */
+    sum_blake3_ctx_t ctx = SUM_BLAKE3_CTX_INIT;
+    sum_blake3_init(&ctx);
+
+    uint8_t *out = arena->base + arena->used;
+    for (size_t i = 0; i < n; i++) {
+        encode_transfer_fields(out, version,
+            batch->chain_id  ? batch->chain_id[i]  : d->chain_id,
+            batch->sender    ? batch->sender[i]    : d->sender,
+            batch->nonce     ? batch->nonce[i]     : d->nonce,
+            batch->gas_price ? batch->gas_price[i] : d->gas_price,
+            batch->gas_limit ? batch->gas_limit[i] : d->gas_limit,
+            batch->recipient ? batch->recipient[i] : d->recipient,
+            batch->amount    ? batch->amount[i]    : d->amount);
+
+        if (offsets != NULL) {
+            offsets[i] = (size_t)(out - arena->base);
+        }
+
+        /* Fused signing hash while the encoded bytes are still in cache */
+        if (hashes != NULL) {
+            sum_blake3_reset(&ctx);
+            sum_blake3_update(&ctx, out, TX_TRANSFER_ENCODED_LEN);
+            sum_blake3_finalize32(&ctx, hashes[i]);
+        }
+
+        out += TX_TRANSFER_ENCODED_LEN;
+    }
+
+    arena->used += n * TX_TRANSFER_ENCODED_LEN;
+    return n;
+}
@@ -0,0 +1,138 @@
+/*
+ * SUM Chain Host Library - Transaction Encoder
+ * Serializes transactions in the wire format consumed by tx_parser_consume.
+ * Host-side only (not part of the device build).
+ */
+
+#ifndef TX_ENCODER_H
+#define TX_ENCODER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "globals.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Encoded size of a Transfer transaction (see README "Transaction Format") */
+#define TX_TRANSFER_ENCODED_LEN   82
+
+/* Encoded size of a Call transaction without its data */
+#define TX_CALL_HEADER_LEN        86
+
+/* Encoded size of a Multi-transfer transaction without its pairs */
+#define TX_MULTI_HEADER_LEN       56
+
+/* Encoded size of one Multi-transfer (recipient, amount) pair */
+#define TX_MULTI_PAIR_LEN         28
+
+/*
+ * Preallocated output arena. The encoder appends to [base + used, base + capacity)
+ * and never allocates.
+ */
+typedef struct {
+    uint8_t *base;
+    size_t   capacity;
+    size_t   used;
+} tx_arena_t;
+
+/*
+ * Structure-of-arrays input for a batch of Transfer transactions.
+ * Each column holds `count` entries. A NULL column takes the value of the
+ * matching field in `defaults` for every transaction (e.g. a constant
+ * chain_id, sender or gas settings across a payout run). The version byte
+ * is taken from `defaults`, or 1 when `defaults` is NULL.
+ */
+typedef struct {
+    size_t          count;
+    const tx_parsed_t *defaults;            /* Required if any column is NULL */
+
+    const uint64_t *chain_id;
+    const uint8_t (*sender)[ADDRESS_LEN];
+    const uint64_t *nonce;
+    const uint64_t *gas_price;
+    const uint64_t *gas_limit;
+    const uint8_t (*recipient)[ADDRESS_LEN];
+    const uint64_t *amount;
+} tx_transfer_batch_t;
+
+/*
+ * Initialize an arena over a caller-provided buffer.
+ *
+ * @param arena    Arena to initialize.
+ * @param buf      Backing storage.
+ * @param buf_len  Size of backing storage.
+ */
+void tx_arena_init(tx_arena_t *arena, uint8_t *buf, size_t buf_len);
+
+/*
+ * Encode a single Transfer transaction.
+ * Uses version, chain_id, sender, nonce, gas_price, gas_limit, recipient
+ * and amount from `tx`; tx_type is always TX_TYPE_TRANSFER.
+ *
+ * @param tx      Transaction fields.
+ * @param out     Output buffer.
+ * @param out_len Size of output buffer.
+ * @return Number of bytes written (TX_TRANSFER_ENCODED_LEN), or 0 on error.
+ */
+size_t tx_encode_transfer(const tx_parsed_t *tx, uint8_t *out, size_t out_len);
+
+/*
+ * Encode a Call transaction: the Transfer fields with tx_type TX_TYPE_CALL,
+ * then data_len (u32 LE) and the opaque data. The device shows data_len and
+ * a BLAKE3 fingerprint of the data (tx_parsed_t.data_hash).
+ *
+ * @param tx       Transaction fields (data_len/data_hash are ignored).
+ * @param data     Opaque data (may be NULL if data_len is 0).
+ * @param data_len Data length (TX_CALL_HEADER_LEN + data_len <= MAX_TX_SIZE).
+ * @param out      Output buffer.
+ * @param out_len  Size of output buffer.
+ * @return Number of bytes written (TX_CALL_HEADER_LEN + data_len), or 0 on error.
+ */
+size_t tx_encode_call(const tx_parsed_t *tx, const uint8_t *data, size_t data_len,
+                      uint8_t *out, size_t out_len);
+
+/*
+ * Encode a Multi-transfer transaction: the Transfer header fields with
+ * tx_type TX_TYPE_MULTI_TRANSFER, a u16 LE pair count and `count`
+ * (recipient, amount) pairs. tx->recipient and tx->amount are ignored.
+ *
+ * @param tx         Transaction header fields.
+ * @param recipients Recipient addresses.
+ * @param amounts    Amounts, one per recipient.
+ * @param count      Number of pairs (1 .. 65535, and the tx must fit MAX_TX_SIZE).
+ * @param out        Output buffer.
+ * @param out_len    Size of output buffer.
+ * @return Number of bytes written (TX_MULTI_HEADER_LEN + count * TX_MULTI_PAIR_LEN),
+ *         or 0 on error.
+ */
+size_t tx_encode_multi_transfer(const tx_parsed_t *tx,
+                                const uint8_t (*recipients)[ADDRESS_LEN],
+                                const uint64_t *amounts, size_t count,
+                                uint8_t *out, size_t out_len);
+
+/*
+ * Encode a batch of Transfer transactions back to back into the arena,
+ * computing each signing hash (BLAKE3 of the encoded bytes) in the same pass
+ * while the bytes are still hot in cache.
+ *
+ * Encoding stops at the first transaction that does not fit in the arena.
+ *
+ * @param batch   SoA input columns.
+ * @param arena   Output arena (appended to).
+ * @param offsets Optional output: arena offset of each encoded tx (may be NULL).
+ * @param hashes  Optional output: BLAKE3 signing hash of each tx (may be NULL).
+ * @return Number of transactions encoded.
+ */
+size_t tx_encode_transfer_batch(const tx_transfer_batch_t *batch,
+                                tx_arena_t *arena,
+                                size_t *offsets,
+                                uint8_t (*hashes)[HASH_LEN]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TX_ENCODER_H */
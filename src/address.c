@@ -4,6 +4,7 @@
 
 #include "address.h"
 #include "crypto.h"
+#include "work_area.h"
 #include "crypto/sum_blake3.h"
 #include <string.h>
 
@@ -130,9 +131,6 @@ bool sumchain_get_address_for_path(const bip32_path_t *path,
                                    bool display,
                                    char *out_str,
                                    size_t out_str_len) {
-    uint8_t pubkey[PUBKEY_LEN];
-    uint8_t addr_bytes[ADDRESS_LEN];
-
     if (path == NULL || out_str == NULL || out_str_len < ADDRESS_BASE58_MAX_LEN) {
         return false;
     }
@@ -142,23 +140,23 @@ bool sumchain_get_address_for_path(const bip32_path_t *path,
         return false;
     }
 
-    if (!crypto_derive_pubkey(path, pubkey)) {
+    work_address_t *work = work_address();
+    APP_STATS_BEGIN(t_derive);
+    bool derived = crypto_derive_pubkey(path, work->pubkey);
+    APP_STATS_END(APP_STAGE_DERIVE, 1, t_derive);
+    if (!derived) {
         return false;
     }
 
     /* Derive address from pubkey */
-    sumchain_address_bytes_from_pubkey(pubkey, addr_bytes);
+    sumchain_address_bytes_from_pubkey(work->pubkey, work->address_bytes);
 
     /* Encode as Base58 */
-    size_t len = sumchain_address_to_base58(addr_bytes, out_str, out_str_len);
+    size_t len = sumchain_address_to_base58(work->address_bytes, out_str, out_str_len);
     if (len == 0) {
         return false;
     }
 
-    /* Zeroize intermediate buffers */
-    SECURE_ZEROIZE(pubkey, sizeof(pubkey));
-    SECURE_ZEROIZE(addr_bytes, sizeof(addr_bytes));
-
     /*
      * If display is requested, show on device.
      * This would trigger the UI flow for address confirmation.
@@ -35,7 +35,9 @@ void sumchain_address_bytes_from_pubkey(const uint8_t pubkey32[32], uint8_t out_
 size_t sumchain_address_to_base58(const uint8_t addr20[20], char *out, size_t out_len);
 
 /*
- * Derive and format the address for a given BIP32 path.
+ * Derive and format the address for a given BIP32 path. The public key
+ * and address bytes are kept in the GET_ADDRESS working set
+ * (work_area.h), which apdu_dispatch zeroizes when the command ends.
  *
  * @param path        BIP32 derivation path.
  * @param display     If true, show the address on device display for confirmation.
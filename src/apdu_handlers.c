@@ -7,6 +7,10 @@
 #include "address.h"
 #include "tx_parser.h"
 #include "tx_display.h"
+#include "merkle.h"
+#include "settings.h"
+#include "sig_cache.h"
+#include "work_area.h"
 #include "crypto/sum_blake3.h"
 #include <string.h>
 
@@ -68,13 +72,17 @@ uint16_t handle_get_public_key(const apdu_t *apdu, uint8_t **tx) {
     }
 
     /* Derive public key */
-    if (!crypto_derive_pubkey(&path, G_state.pubkey)) {
+    work_key_t *work = work_key();
+    APP_STATS_BEGIN(t_derive);
+    bool derived = crypto_derive_pubkey(&path, work->pubkey);
+    APP_STATS_END(APP_STAGE_DERIVE, 1, t_derive);
+    if (!derived) {
         SECURE_ZEROIZE(&path, sizeof(path));
         return SW_INTERNAL_ERROR;
     }
 
     /* Copy pubkey to output */
-    memcpy(*tx, G_state.pubkey, PUBKEY_LEN);
+    memcpy(*tx, work->pubkey, PUBKEY_LEN);
     *tx += PUBKEY_LEN;
 
     /* Zeroize path */
@@ -113,14 +121,15 @@ uint16_t handle_get_address(const apdu_t *apdu, uint8_t **tx) {
     }
 
     /* Derive address */
-    if (!sumchain_get_address_for_path(&path, display, G_state.address_str, sizeof(G_state.address_str))) {
+    work_address_t *work = work_address();
+    if (!sumchain_get_address_for_path(&path, display, work->address_str, sizeof(work->address_str))) {
         SECURE_ZEROIZE(&path, sizeof(path));
         return SW_INTERNAL_ERROR;
     }
 
     /* Copy address string to output (excluding null terminator) */
-    size_t addr_len = strlen(G_state.address_str);
-    memcpy(*tx, G_state.address_str, addr_len);
+    size_t addr_len = strlen(work->address_str);
+    memcpy(*tx, work->address_str, addr_len);
     *tx += addr_len;
 
     /* Zeroize path */
@@ -129,13 +138,79 @@ uint16_t handle_get_address(const apdu_t *apdu, uint8_t **tx) {
     return SW_OK;
 }
 
+/*
+ * Show the multi-transfer pair the parser just completed, unless the user
+ * approves multi-transfers by total only. The pair is overwritten by the
+ * next one, so this is the only chance to review it.
+ */
+static uint16_t review_pair(const tx_parsed_t *parsed) {
+    if (settings_multi_total_only()) {
+        return SW_OK;
+    }
+
+    tx_pair_display_t *display = work_pair_display();
+    if (!tx_pair_display_format(parsed, display)) {
+        return SW_INTERNAL_ERROR;
+    }
+    if (tx_display_show_pair(display) != UI_RESULT_APPROVED) {
+        return SW_USER_REJECTED;
+    }
+    return SW_OK;
+}
+
+/*
+ * Feed a slice of a single transaction to the hasher and the parser. The
+ * parser returns early after each multi-transfer pair; trailing bytes after
+ * the end of the transaction are a parse error.
+ */
+static uint16_t sign_tx_feed(sign_session_t *session, const uint8_t *data, size_t len) {
+    /* Feed to hash context */
+    APP_STATS_BEGIN(t_hash);
+    sum_blake3_update(&session->tx_hash_ctx, data, len);
+    APP_STATS_END(APP_STAGE_HASH, len, t_hash);
+    APP_TRACE(APP_TRACE_HASH_UPDATE, 0, len);
+
+    /* Feed to parser */
+    while (len > 0) {
+        APP_STATS_BEGIN(t_parse);
+        size_t consumed = tx_parser_consume(&session->parser, data, len);
+        APP_STATS_END(APP_STAGE_PARSE, consumed, t_parse);
+        if (consumed == 0 || tx_parser_has_error(&session->parser)) {
+            return SW_TX_PARSE_ERROR;
+        }
+
+        if (tx_parser_pair_ready(&session->parser)) {
+            const tx_parsed_t *parsed = tx_parser_get_parsed(&session->parser);
+
+            /* A re-send of the cached tx is decided on its first pair (sig_cache.h) */
+            if (parsed->recipient_index == 1) {
+                session->pairs_unreviewed = sig_cache_expect(&session->path, parsed);
+            }
+            if (!session->pairs_unreviewed) {
+                uint16_t sw = review_pair(parsed);
+                if (sw != SW_OK) {
+                    return sw;
+                }
+            }
+        }
+
+        data += consumed;
+        len -= consumed;
+    }
+
+    return SW_OK;
+}
+
 /*
  * INS_SIGN_TX handler - streaming transaction signing
  *
  * Flow:
  * 1. First chunk (P1=0x00): Parse path, init session, start hashing/parsing tx data
  * 2. Continuation chunks (P1=0x80): Continue hashing/parsing
- * 3. Last chunk (P2=0x00): Finalize parsing, display for approval, sign and return
+ * 3. Last chunk (P2=0x00): Finalize parsing, display for approval, sign and return.
+ *    A digest and path equal to the last approved ones (sig_cache.h) return
+ *    the cached signature without review; for a multi-transfer this is
+ *    already decided on its first pair.
  */
 uint16_t handle_sign_tx(const apdu_t *apdu, uint8_t **tx) {
     sign_session_t *session = &G_state.sign_session;
@@ -204,14 +279,10 @@ uint16_t handle_sign_tx(const apdu_t *apdu, uint8_t **tx) {
                 return SW_TX_TOO_LARGE;
             }
 
-            /* Feed to hash context */
-            sum_blake3_update(&session->tx_hash_ctx, tx_data, tx_len);
-
-            /* Feed to parser */
-            size_t consumed = tx_parser_consume(&session->parser, tx_data, tx_len);
-            if (consumed != tx_len || tx_parser_has_error(&session->parser)) {
+            uint16_t sw = sign_tx_feed(session, tx_data, tx_len);
+            if (sw != SW_OK) {
                 reset_sign_session();
-                return SW_TX_PARSE_ERROR;
+                return sw;
             }
 
             session->total_received += tx_len;
@@ -221,8 +292,8 @@ uint16_t handle_sign_tx(const apdu_t *apdu, uint8_t **tx) {
      * Continuation chunk handling
      */
     else {
-        /* Must have an active session */
-        if (!session->initialized) {
+        /* Must have an active single-transaction session */
+        if (!session->initialized || session->is_batch) {
             return SW_SESSION_ERROR;
         }
 
@@ -241,14 +312,10 @@ uint16_t handle_sign_tx(const apdu_t *apdu, uint8_t **tx) {
                 return SW_TX_TOO_LARGE;
             }
 
-            /* Feed to hash context */
-            sum_blake3_update(&session->tx_hash_ctx, apdu->data, apdu->lc);
-
-            /* Feed to parser */
-            size_t consumed = tx_parser_consume(&session->parser, apdu->data, apdu->lc);
-            if (consumed != apdu->lc || tx_parser_has_error(&session->parser)) {
+            uint16_t sw = sign_tx_feed(session, apdu->data, apdu->lc);
+            if (sw != SW_OK) {
                 reset_sign_session();
-                return SW_TX_PARSE_ERROR;
+                return sw;
             }
 
             session->total_received += apdu->lc;
@@ -273,8 +340,8 @@ uint16_t handle_sign_tx(const apdu_t *apdu, uint8_t **tx) {
         }
 
         /* Format for display */
-        tx_display_t display;
-        if (!tx_display_format(parsed, &display)) {
+        tx_display_t *display = work_tx_display();
+        if (!tx_display_format(parsed, display)) {
             reset_sign_session();
             return SW_INTERNAL_ERROR;
         }
@@ -285,30 +352,48 @@ uint16_t handle_sign_tx(const apdu_t *apdu, uint8_t **tx) {
             return SW_TX_OVERFLOW;
         }
 
+        /* Finalize the hash first: a re-sent, already approved tx is not reviewed again */
+        work_sign_t *work = work_sign();
+        APP_STATS_BEGIN(t_final);
+        sum_blake3_finalize32(&session->tx_hash_ctx, work->hash);
+        APP_STATS_END(APP_STAGE_HASH, 0, t_final);
+        APP_TRACE(APP_TRACE_HASH_FINAL, 0, 0);
+
+        if (sig_cache_lookup(&session->path, work->hash, *tx)) {
+            *tx += SIGNATURE_LEN;
+            reset_sign_session();
+            return SW_OK;
+        }
+
+        /* Pairs were not shown: fail closed, and review in full next time */
+        if (session->pairs_unreviewed) {
+            sig_cache_clear();
+            reset_sign_session();
+            return SW_SESSION_ERROR;
+        }
+
         /* Show approval UI and wait for user decision */
-        ui_result_t result = tx_display_show_approval(&display);
+        ui_result_t result = tx_display_show_approval(display);
         if (result != UI_RESULT_APPROVED) {
             reset_sign_session();
             return SW_USER_REJECTED;
         }
 
-        /* User approved - finalize hash and sign */
-        sum_blake3_finalize32(&session->tx_hash_ctx, G_state.hash);
-
-        /* Sign the hash */
-        if (!crypto_sign_hash(&session->path, G_state.hash, G_state.signature)) {
-            SECURE_ZEROIZE(G_state.hash, sizeof(G_state.hash));
+        /* User approved - sign the hash */
+        APP_STATS_BEGIN(t_sign);
+        bool signed_ok = crypto_sign_hash(&session->path, work->hash, work->signature);
+        APP_STATS_END(APP_STAGE_SIGN, 1, t_sign);
+        if (!signed_ok) {
             reset_sign_session();
             return SW_INTERNAL_ERROR;
         }
 
-        /* Copy signature to output */
-        memcpy(*tx, G_state.signature, SIGNATURE_LEN);
+        /* Copy signature to output; keep it in case the response is lost */
+        memcpy(*tx, work->signature, SIGNATURE_LEN);
         *tx += SIGNATURE_LEN;
+        sig_cache_store(&session->path, parsed, work->hash, work->signature);
 
-        /* Cleanup */
-        SECURE_ZEROIZE(G_state.hash, sizeof(G_state.hash));
-        SECURE_ZEROIZE(G_state.signature, sizeof(G_state.signature));
+        /* Cleanup (the working set is zeroized by apdu_dispatch) */
         reset_sign_session();
 
         return SW_OK;
@@ -318,6 +403,449 @@ uint16_t handle_sign_tx(const apdu_t *apdu, uint8_t **tx) {
     return SW_OK;
 }
 
+/*
+ * Close the transaction the parser just finished: check it against the
+ * batch, add it to the totals and push its digest into the tree, then
+ * re-arm hasher and parser for the next one.
+ */
+static uint16_t merkle_finish_tx(sign_session_t *session) {
+    merkle_batch_t *batch = &session->batch;
+    const tx_parsed_t *parsed = tx_parser_get_parsed(&session->parser);
+
+    if (parsed == NULL) {
+        return SW_INTERNAL_ERROR;
+    }
+
+    /* Same safety rule as SIGN_TX */
+    if (parsed->fee_overflow) {
+        return SW_TX_OVERFLOW;
+    }
+
+    /* One chain per batch, so the summary screen is unambiguous */
+    if (batch->tree.count == 0) {
+        batch->chain_id = parsed->chain_id;
+    } else if (parsed->chain_id != batch->chain_id) {
+        return SW_INVALID_DATA;
+    }
+
+    batch->amount_lo += parsed->total_amount_lo;
+    batch->amount_hi += parsed->total_amount_hi + ((batch->amount_lo < parsed->total_amount_lo) ? 1 : 0);
+    batch->fee_lo += parsed->fee_low;
+    batch->fee_hi += parsed->fee_high + ((batch->fee_lo < parsed->fee_low) ? 1 : 0);
+
+    /* The tx hasher is free once finalized: it doubles as the tree's scratch */
+    work_sign_t *work = work_sign();
+    APP_STATS_BEGIN(t_final);
+    sum_blake3_finalize32(&session->tx_hash_ctx, work->hash);
+    bool pushed = merkle_acc_push(&batch->tree, &session->tx_hash_ctx, work->hash);
+    APP_STATS_END(APP_STAGE_HASH, 0, t_final);
+    APP_TRACE(APP_TRACE_HASH_FINAL, 0, 0);
+    if (!pushed) {
+        return SW_TX_TOO_LARGE;
+    }
+
+    sum_blake3_init(&session->tx_hash_ctx);
+    tx_parser_init(&session->parser);
+
+    return SW_OK;
+}
+
+/*
+ * Feed a slice of the transaction stream. Each transaction is hashed and
+ * parsed as it arrives; the parser stops at the end of a transaction, which
+ * is how the stream is split without length prefixes.
+ */
+static uint16_t merkle_feed(sign_session_t *session, const uint8_t *data, size_t len) {
+    while (len > 0) {
+        APP_STATS_BEGIN(t_parse);
+        size_t consumed = tx_parser_consume(&session->parser, data, len);
+        APP_STATS_END(APP_STAGE_PARSE, consumed, t_parse);
+        if (consumed == 0 || tx_parser_has_error(&session->parser)) {
+            return SW_TX_PARSE_ERROR;
+        }
+
+        APP_STATS_BEGIN(t_hash);
+        sum_blake3_update(&session->tx_hash_ctx, data, consumed);
+        APP_STATS_END(APP_STAGE_HASH, consumed, t_hash);
+        APP_TRACE(APP_TRACE_HASH_UPDATE, 0, consumed);
+
+        if (tx_parser_is_done(&session->parser)) {
+            uint16_t sw = merkle_finish_tx(session);
+            if (sw != SW_OK) {
+                return sw;
+            }
+        }
+
+        session->total_received += consumed;
+        data += consumed;
+        len -= consumed;
+    }
+
+    return SW_OK;
+}
+
+/*
+ * INS_SIGN_MERKLE handler - one signature over a batch of transactions
+ *
+ * Flow:
+ * 1. First chunk (P1=0x00): Parse path, init session and tree, start the tx stream
+ * 2. Continuation chunks (P1=0x80): Continue the tx stream
+ * 3. Last chunk (P2=0x00): Fold the root, show the batch summary, sign and return
+ */
+uint16_t handle_sign_merkle(const apdu_t *apdu, uint8_t **tx) {
+    sign_session_t *session = &G_state.sign_session;
+    const uint8_t *data;
+    size_t data_len;
+    uint16_t sw;
+
+    if (apdu == NULL || tx == NULL || *tx == NULL) {
+        return SW_INTERNAL_ERROR;
+    }
+
+    bool is_first = (apdu->p1 == P1_FIRST_CHUNK);
+    bool is_more  = (apdu->p2 == P2_MORE_CHUNKS);
+
+    /* Validate P1/P2 combinations */
+    if ((apdu->p1 != P1_FIRST_CHUNK && apdu->p1 != P1_MORE_CHUNK) ||
+        (apdu->p2 != P2_LAST_CHUNK && apdu->p2 != P2_MORE_CHUNKS)) {
+        reset_sign_session();
+        return SW_INVALID_P1P2;
+    }
+
+    if (is_first) {
+        /* Reset any existing session */
+        reset_sign_session();
+
+        if (apdu->lc < 1) {
+            return SW_WRONG_LENGTH;
+        }
+
+        size_t path_bytes = crypto_parse_path(apdu->data, apdu->lc, &session->path);
+        if (path_bytes == 0 || !crypto_validate_path(&session->path)) {
+            reset_sign_session();
+            return SW_INVALID_PATH;
+        }
+
+        sum_blake3_init(&session->tx_hash_ctx);
+        tx_parser_init(&session->parser);
+        merkle_acc_init(&session->batch.tree);
+
+        session->initialized = true;
+        session->is_batch = true;
+        session->total_received = 0;
+
+        data = apdu->data + path_bytes;
+        data_len = apdu->lc - path_bytes;
+    } else {
+        /* Must have an active batch session */
+        if (!session->initialized || !session->is_batch) {
+            return SW_SESSION_ERROR;
+        }
+
+        /* Already received last chunk - error */
+        if (session->last_chunk_received) {
+            reset_sign_session();
+            return SW_SESSION_ERROR;
+        }
+
+        data = apdu->data;
+        data_len = apdu->lc;
+    }
+
+    session->last_chunk_received = !is_more;
+
+    sw = merkle_feed(session, data, data_len);
+    if (sw != SW_OK) {
+        reset_sign_session();
+        return sw;
+    }
+
+    /* More chunks expected - return OK with no data */
+    if (is_more) {
+        return SW_OK;
+    }
+
+    /* The stream must end on a transaction boundary and hold at least one */
+    if (session->parser.total_consumed != 0 || session->batch.tree.count == 0) {
+        reset_sign_session();
+        return SW_TX_PARSE_ERROR;
+    }
+
+    tx_batch_display_t *display = work_batch_display();
+    if (!tx_batch_display_format(&session->batch, display)) {
+        reset_sign_session();
+        return SW_INTERNAL_ERROR;
+    }
+
+    ui_result_t result = tx_display_show_batch_approval(display);
+    if (result != UI_RESULT_APPROVED) {
+        reset_sign_session();
+        return SW_USER_REJECTED;
+    }
+
+    /* Root goes to the output buffer directly, the signed message to the working set */
+    work_sign_t *work = work_sign();
+    APP_STATS_BEGIN(t_root);
+    merkle_acc_root(&session->batch.tree, &session->tx_hash_ctx, *tx);
+    merkle_signing_hash(&session->tx_hash_ctx, *tx, session->batch.tree.count, work->hash);
+    APP_STATS_END(APP_STAGE_HASH, 0, t_root);
+    APP_TRACE(APP_TRACE_HASH_FINAL, 0, 0);
+
+    APP_STATS_BEGIN(t_sign);
+    bool signed_ok = crypto_sign_hash(&session->path, work->hash, work->signature);
+    APP_STATS_END(APP_STAGE_SIGN, 1, t_sign);
+    if (!signed_ok) {
+        reset_sign_session();
+        return SW_INTERNAL_ERROR;
+    }
+
+    memcpy(*tx + MERKLE_HASH_LEN, work->signature, SIGNATURE_LEN);
+    *tx += MERKLE_HASH_LEN + SIGNATURE_LEN;
+
+    /* Cleanup (the working set is zeroized by apdu_dispatch) */
+    reset_sign_session();
+
+    return SW_OK;
+}
+
+/* Read a u64 little-endian request field */
+static uint64_t read_u64_le(const uint8_t *buf) {
+    uint64_t value = 0;
+    for (int i = 7; i >= 0; i--) {
+        value = (value << 8) | buf[i];
+    }
+    return value;
+}
+
+uint16_t handle_sign_hash(const apdu_t *apdu, uint8_t **tx) {
+    bip32_path_t path;
+    size_t path_bytes;
+
+    if (apdu == NULL || tx == NULL || *tx == NULL) {
+        return SW_INTERNAL_ERROR;
+    }
+
+    /* Off unless the user enabled it in Settings */
+    if (!settings_hash_signing_enabled()) {
+        return SW_SECURITY_STATUS;
+    }
+
+    if (apdu->p1 != 0x00 || apdu->p2 != 0x00) {
+        return SW_INVALID_P1P2;
+    }
+
+    if (apdu->lc < 1) {
+        return SW_WRONG_LENGTH;
+    }
+
+    path_bytes = crypto_parse_path(apdu->data, apdu->lc, &path);
+    if (path_bytes == 0) {
+        return SW_INVALID_PATH;
+    }
+
+    if (!crypto_validate_path(&path)) {
+        SECURE_ZEROIZE(&path, sizeof(path));
+        return SW_INVALID_PATH;
+    }
+
+    /* Exactly [header][hash] after the path */
+    if (apdu->lc != path_bytes + SIGN_HASH_HEADER_LEN + HASH_LEN) {
+        SECURE_ZEROIZE(&path, sizeof(path));
+        return SW_WRONG_LENGTH;
+    }
+
+    const uint8_t *header = apdu->data + path_bytes;
+    work_sign_t *work = work_sign();
+    memcpy(work->hash, header + SIGN_HASH_HEADER_LEN, HASH_LEN);
+
+    tx_hash_display_t *display = work_hash_display();
+    if (!tx_hash_display_format(read_u64_le(header), read_u64_le(header + 8),
+                                read_u64_le(header + 16), work->hash, display)) {
+        SECURE_ZEROIZE(&path, sizeof(path));
+        return SW_INTERNAL_ERROR;
+    }
+
+    ui_result_t result = tx_display_show_hash_approval(display);
+    if (result != UI_RESULT_APPROVED) {
+        SECURE_ZEROIZE(&path, sizeof(path));
+        return SW_USER_REJECTED;
+    }
+
+    APP_STATS_BEGIN(t_sign);
+    bool signed_ok = crypto_sign_hash(&path, work->hash, work->signature);
+    APP_STATS_END(APP_STAGE_SIGN, 1, t_sign);
+
+    SECURE_ZEROIZE(&path, sizeof(path));
+    if (!signed_ok) {
+        return SW_INTERNAL_ERROR;
+    }
+
+    memcpy(*tx, work->signature, SIGNATURE_LEN);
+    *tx += SIGNATURE_LEN;
+
+    return SW_OK;
+}
+
+uint16_t handle_resume(const apdu_t *apdu, uint8_t **tx) {
+    const sign_session_t *session = &G_state.sign_session;
+    uint8_t kind = RESUME_KIND_NONE;
+    uint32_t offset = 0;
+
+    if (apdu == NULL || tx == NULL || *tx == NULL) {
+        return SW_INTERNAL_ERROR;
+    }
+
+    if (apdu->p1 != 0x00 || apdu->p2 != 0x00) {
+        return SW_INVALID_P1P2;
+    }
+
+    if (session->initialized && !session->last_chunk_received) {
+        kind = session->is_batch ? RESUME_KIND_SIGN_MERKLE : RESUME_KIND_SIGN_TX;
+        offset = (uint32_t)session->total_received;
+    }
+
+    /* Optional path check: only resume the caller's own session */
+    if (apdu->lc > 0) {
+        bip32_path_t path;
+
+        if (crypto_parse_path(apdu->data, apdu->lc, &path) != apdu->lc) {
+            return SW_INVALID_PATH;
+        }
+        if (path.length != session->path.length || path.scheme != session->path.scheme ||
+            memcmp(path.path, session->path.path, path.length * sizeof(path.path[0])) != 0) {
+            kind = RESUME_KIND_NONE;
+            offset = 0;
+        }
+        SECURE_ZEROIZE(&path, sizeof(path));
+    }
+
+    (*tx)[0] = kind;
+    (*tx)[1] = (uint8_t)(offset >> 24);
+    (*tx)[2] = (uint8_t)(offset >> 16);
+    (*tx)[3] = (uint8_t)(offset >> 8);
+    (*tx)[4] = (uint8_t)(offset);
+    *tx += RESUME_RESPONSE_LEN;
+
+    return SW_OK;
+}
+
+uint16_t handle_get_xpub(const apdu_t *apdu, uint8_t **tx) {
+    bip32_path_t path;
+
+    if (apdu == NULL || tx == NULL || *tx == NULL) {
+        return SW_INTERNAL_ERROR;
+    }
+
+    if (apdu->p1 != 0x00 || apdu->p2 != 0x00) {
+        return SW_INVALID_P1P2;
+    }
+
+    if (apdu->lc < 1) {
+        return SW_WRONG_LENGTH;
+    }
+
+    /* Exactly one path, and only a scheme with public derivation */
+    size_t path_bytes = crypto_parse_path(apdu->data, apdu->lc, &path);
+    if (path_bytes == 0 || path_bytes != apdu->lc ||
+        path.scheme != PATH_SCHEME_BIP32_ED25519 || !crypto_validate_path(&path)) {
+        SECURE_ZEROIZE(&path, sizeof(path));
+        return SW_INVALID_PATH;
+    }
+
+    work_key_t *work = work_key();
+    APP_STATS_BEGIN(t_derive);
+    bool derived = crypto_derive_xpub(&path, work->pubkey, work->chain_code);
+    APP_STATS_END(APP_STAGE_DERIVE, 1, t_derive);
+    SECURE_ZEROIZE(&path, sizeof(path));
+    if (!derived) {
+        return SW_INTERNAL_ERROR;
+    }
+
+    memcpy(*tx, work->pubkey, PUBKEY_LEN);
+    memcpy(*tx + PUBKEY_LEN, work->chain_code, CHAIN_CODE_LEN);
+    *tx += XPUB_LEN;
+
+    return SW_OK;
+}
+
+#ifdef HAVE_APP_STATS
+uint16_t handle_get_stats(const apdu_t *apdu, uint8_t **tx) {
+    (void)apdu;
+
+    if (tx == NULL || *tx == NULL) {
+        return SW_INTERNAL_ERROR;
+    }
+
+    *tx += app_stats_take(*tx, APP_STATS_RESPONSE_LEN);
+
+    return SW_OK;
+}
+#endif
+
+#ifdef HAVE_APP_TRACE
+uint16_t handle_get_trace(const apdu_t *apdu, uint8_t **tx) {
+    if (tx == NULL || *tx == NULL) {
+        return SW_INTERNAL_ERROR;
+    }
+
+    if (apdu->p1 >= APP_TRACE_PAGES || (apdu->p2 != 0x00 && apdu->p2 != P2_TRACE_CLEAR)) {
+        return SW_INVALID_P1P2;
+    }
+
+    *tx += app_trace_read(apdu->p1, *tx, APP_TRACE_RESPONSE_LEN);
+
+    if (apdu->p2 == P2_TRACE_CLEAR) {
+        app_trace_clear();
+    }
+
+    return SW_OK;
+}
+#endif
+
+static uint16_t apdu_dispatch_ins(const apdu_t *apdu, uint8_t **tx) {
+    switch (apdu->ins) {
+        case INS_GET_VERSION:
+            return handle_get_version(apdu, tx);
+
+        case INS_GET_APP_NAME:
+            return handle_get_app_name(apdu, tx);
+
+        case INS_GET_PUBLIC_KEY:
+            return handle_get_public_key(apdu, tx);
+
+        case INS_GET_ADDRESS:
+            return handle_get_address(apdu, tx);
+
+        case INS_SIGN_TX:
+            return handle_sign_tx(apdu, tx);
+
+        case INS_SIGN_MERKLE:
+            return handle_sign_merkle(apdu, tx);
+
+        case INS_SIGN_HASH:
+            return handle_sign_hash(apdu, tx);
+
+        case INS_RESUME:
+            return handle_resume(apdu, tx);
+
+        case INS_GET_XPUB:
+            return handle_get_xpub(apdu, tx);
+
+#ifdef HAVE_APP_STATS
+        case INS_GET_STATS:
+            return handle_get_stats(apdu, tx);
+#endif
+
+#ifdef HAVE_APP_TRACE
+        case INS_GET_TRACE:
+            return handle_get_trace(apdu, tx);
+#endif
+
+        default:
+            return SW_INS_NOT_SUPPORTED;
+    }
+}
+
 uint16_t apdu_dispatch(uint8_t cla, uint8_t ins, uint8_t p1, uint8_t p2,
                        uint8_t lc, uint8_t *data, uint8_t **tx) {
     apdu_t apdu = {
@@ -334,24 +862,26 @@ uint16_t apdu_dispatch(uint8_t cla, uint8_t ins, uint8_t p1, uint8_t p2,
         return SW_CLA_NOT_SUPPORTED;
     }
 
-    /* Dispatch based on INS */
-    switch (ins) {
-        case INS_GET_VERSION:
-            return handle_get_version(&apdu, tx);
-
-        case INS_GET_APP_NAME:
-            return handle_get_app_name(&apdu, tx);
-
-        case INS_GET_PUBLIC_KEY:
-            return handle_get_public_key(&apdu, tx);
-
-        case INS_GET_ADDRESS:
-            return handle_get_address(&apdu, tx);
-
-        case INS_SIGN_TX:
-            return handle_sign_tx(&apdu, tx);
+    /* Reading the trace is not traced: paging through it must not move it */
+    bool traced = (ins != INS_GET_TRACE);
+    if (traced) {
+        APP_TRACE(APP_TRACE_APDU_RX, ins, ((uint16_t)p1 << 8) | lc);
+    }
 
-        default:
-            return SW_INS_NOT_SUPPORTED;
+    /* Dispatch based on INS */
+#ifdef HAVE_APP_STATS
+    uint32_t start = app_stats_now();
+    uint16_t sw = apdu_dispatch_ins(&apdu, tx);
+    app_stats_record_ins(ins, sw, start);
+#else
+    uint16_t sw = apdu_dispatch_ins(&apdu, tx);
+#endif
+
+    /* The one zeroization of the command's working set */
+    work_area_clear();
+
+    if (traced) {
+        APP_TRACE(APP_TRACE_APDU_SW, ins, sw);
     }
+    return sw;
 }
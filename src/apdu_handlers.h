@@ -93,6 +93,118 @@ uint16_t handle_get_address(const apdu_t *apdu, uint8_t **tx);
  */
 uint16_t handle_sign_tx(const apdu_t *apdu, uint8_t **tx);
 
+/*
+ * Handle INS_SIGN_MERKLE (0x06)
+ * Streams many transactions back to back (same chunking as SIGN_TX) and
+ * signs one BLAKE3 Merkle root over their digests after a summary review
+ * (count, chain ID, total amount, total max fee). Every transaction must
+ * use the same chain ID. Tree and signed message are defined in merkle.h.
+ *
+ * First chunk data format:
+ *   [path_len:1] [path[0]:4 BE] ... [tx stream...]
+ *
+ * Continuation chunk data format:
+ *   [tx stream...]
+ *
+ * Transactions may span chunk boundaries; the last chunk must end on a
+ * transaction boundary.
+ *
+ * Response (last chunk): [root:32] [signature:64]
+ *
+ * @param apdu   Parsed APDU structure.
+ * @param tx     Output buffer pointer (will be incremented).
+ * @return Status word.
+ */
+uint16_t handle_sign_merkle(const apdu_t *apdu, uint8_t **tx);
+
+/*
+ * Handle INS_SIGN_HASH (0x07)
+ * Signs a precomputed 32-byte BLAKE3 transaction hash, for payloads too
+ * large to stream. Refused with SW_SECURITY_STATUS unless "Hash signing"
+ * is enabled in Settings. The header is shown for the user's reference
+ * only; the device cannot check it against the hash, and the flow opens
+ * with a blind-signing warning.
+ *
+ * P1 = 0x00, P2 = 0x00
+ *
+ * Data format:
+ *   [path_len:1] [path[0]:4 BE] ... [chain_id:8 LE] [nonce:8 LE] [fee:8 LE] [hash:32]
+ *
+ * Response: [signature:64]
+ *
+ * @param apdu   Parsed APDU structure.
+ * @param tx     Output buffer pointer (will be incremented).
+ * @return Status word.
+ */
+uint16_t handle_sign_hash(const apdu_t *apdu, uint8_t **tx);
+
+/*
+ * Handle INS_RESUME (0x08)
+ * Reports the open SIGN_TX / SIGN_MERKLE session, which survives a
+ * transport reset, so the host can continue with P1=0x80 chunks from the
+ * returned offset instead of restarting. Does not change the session.
+ *
+ * P1 = 0x00, P2 = 0x00
+ *
+ * Data format (optional):
+ *   [path_len:1] [path[0]:4 BE] ...
+ *   If present, a session for a different path is reported as none.
+ *
+ * Response: [kind:1] [offset:4 BE]
+ *   kind   RESUME_KIND_NONE, RESUME_KIND_SIGN_TX or RESUME_KIND_SIGN_MERKLE
+ *   offset Tx (or stream) bytes received after the path
+ *
+ * @param apdu   Parsed APDU structure.
+ * @param tx     Output buffer pointer (will be incremented).
+ * @return Status word.
+ */
+uint16_t handle_resume(const apdu_t *apdu, uint8_t **tx);
+
+/*
+ * Handle INS_GET_XPUB (0x09)
+ * Returns the extended public key of a BIP32-Ed25519 path (normally the
+ * account, m/44'/12345'/account'). The host derives the public keys and
+ * addresses of non-hardened children from it (host/bip32_ed25519.h).
+ *
+ * P1 = 0x00, P2 = 0x00
+ *
+ * Data format:
+ *   [path_len | PATH_LEN_FLAG_BIP32_ED25519 :1] [path[0]:4 BE] ...
+ *
+ * Response: [pubkey:32] [chain_code:32]
+ *
+ * @param apdu   Parsed APDU structure.
+ * @param tx     Output buffer pointer (will be incremented).
+ * @return Status word.
+ */
+uint16_t handle_get_xpub(const apdu_t *apdu, uint8_t **tx);
+
+#ifdef HAVE_APP_STATS
+/*
+ * Handle INS_GET_STATS (0x05)
+ * Returns the performance counters and resets them.
+ * Response format is described in app_stats.h.
+ *
+ * @param apdu   Parsed APDU structure.
+ * @param tx     Output buffer pointer (will be incremented).
+ * @return Status word.
+ */
+uint16_t handle_get_stats(const apdu_t *apdu, uint8_t **tx);
+#endif
+
+#ifdef HAVE_APP_TRACE
+/*
+ * Handle INS_GET_TRACE (0x0A)
+ * Returns one page of the event ring, oldest event first; P2_TRACE_CLEAR
+ * empties the ring afterwards. Response format is described in app_trace.h.
+ *
+ * @param apdu   Parsed APDU structure.
+ * @param tx     Output buffer pointer (will be incremented).
+ * @return Status word.
+ */
+uint16_t handle_get_trace(const apdu_t *apdu, uint8_t **tx);
+#endif
+
 /*
  * Dispatch an APDU to the appropriate handler.
  *
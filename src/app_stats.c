@@ -0,0 +1,86 @@
+/*
+ * SUM Chain Ledger App - Performance Counters Implementation
+ */
+
+#include "app_stats.h"
+#include "globals.h"
+#include <string.h>
+
+#ifdef HAVE_APP_STATS
+
+#ifdef HAVE_BOLOS_SDK
+
+volatile uint32_t G_app_stats_ticks;
+
+uint32_t app_stats_now(void) {
+    return G_app_stats_ticks;
+}
+
+#else
+
+#include <time.h>
+
+uint32_t app_stats_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u);
+}
+
+#endif /* HAVE_BOLOS_SDK */
+
+void app_stats_record_ins(uint8_t ins, uint16_t sw, uint32_t start) {
+    if (ins >= APP_STATS_NUM_INS) {
+        return;
+    }
+
+    app_ins_stats_t *s = &G_state.stats.ins[ins];
+    s->calls++;
+    if (sw != SW_OK) {
+        s->errors++;
+    }
+    s->ticks += app_stats_now() - start;
+}
+
+void app_stats_record_stage(app_stage_t stage, uint32_t count, uint32_t start) {
+    app_stage_stats_t *s = &G_state.stats.stage[stage];
+    s->count += count;
+    s->ticks += app_stats_now() - start;
+}
+
+static uint8_t *write_u32_be(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+    return p + 4;
+}
+
+size_t app_stats_take(uint8_t *out, size_t out_len) {
+    const app_stats_t *stats = &G_state.stats;
+    uint8_t *p = out;
+
+    if (out == NULL || out_len < APP_STATS_RESPONSE_LEN) {
+        return 0;
+    }
+
+    *p++ = APP_STATS_FORMAT;
+    *p++ = APP_STATS_NUM_INS;
+    *p++ = APP_STAGE_COUNT;
+    p = write_u32_be(p, APP_STATS_TICK_US);
+
+    for (size_t i = 0; i < APP_STATS_NUM_INS; i++) {
+        p = write_u32_be(p, stats->ins[i].calls);
+        p = write_u32_be(p, stats->ins[i].errors);
+        p = write_u32_be(p, stats->ins[i].ticks);
+    }
+    for (size_t i = 0; i < APP_STAGE_COUNT; i++) {
+        p = write_u32_be(p, stats->stage[i].count);
+        p = write_u32_be(p, stats->stage[i].ticks);
+    }
+
+    memset(&G_state.stats, 0, sizeof(G_state.stats));
+
+    return (size_t)(p - out);
+}
+
+#endif /* HAVE_APP_STATS */
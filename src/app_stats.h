@@ -0,0 +1,123 @@
+/*
+ * SUM Chain Ledger App - Performance Counters
+ * Optional per-INS and per-stage counters (build with APP_STATS=1).
+ */
+
+#ifndef APP_STATS_H
+#define APP_STATS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Tick source.
+ * Device: SEPROXYHAL ticker events (counted in io_event, 100 ms each). The
+ * ticker only advances while the app waits in io_exchange or on a review
+ * screen. Derivation, signing, hashing and parsing run between those waits,
+ * so device stage ticks stay at zero and per-INS ticks measure I/O and UI
+ * waiting only; they are not compute timings. Call counts and byte totals
+ * are exact. Time stages on the host build or with tests/bench.
+ * Host: CLOCK_MONOTONIC in microseconds, so every field is a real timing.
+ */
+#ifdef HAVE_BOLOS_SDK
+#define APP_STATS_TICK_US         100000
+#else
+#define APP_STATS_TICK_US         1
+#endif
+
+#define APP_STATS_FORMAT          1      /* GET_STATS response format version */
+#define APP_STATS_NUM_INS         16     /* Instructions 0x00-0x0F are tracked */
+
+/*
+ * Measured stages. `count` is calls for derive/sign, bytes for hash/parse.
+ */
+typedef enum {
+    APP_STAGE_DERIVE = 0,                  /* crypto_derive_pubkey */
+    APP_STAGE_SIGN,                        /* crypto_sign_hash */
+    APP_STAGE_HASH,                        /* sum_blake3_update/finalize on tx bytes */
+    APP_STAGE_PARSE,                       /* tx_parser_consume */
+    APP_STAGE_COUNT
+} app_stage_t;
+
+typedef struct {
+    uint32_t calls;
+    uint32_t errors;                       /* Status word other than SW_OK */
+    uint32_t ticks;
+} app_ins_stats_t;
+
+typedef struct {
+    uint32_t count;
+    uint32_t ticks;
+} app_stage_stats_t;
+
+typedef struct {
+    app_ins_stats_t   ins[APP_STATS_NUM_INS];
+    app_stage_stats_t stage[APP_STAGE_COUNT];
+} app_stats_t;
+
+/*
+ * GET_STATS response size:
+ *   [format:1] [num_ins:1] [num_stages:1] [tick_us:4 BE]
+ *   num_ins    x [calls:4 BE] [errors:4 BE] [ticks:4 BE]
+ *   num_stages x [count:4 BE] [ticks:4 BE]
+ */
+#define APP_STATS_RESPONSE_LEN    (7 + APP_STATS_NUM_INS * 12 + APP_STAGE_COUNT * 8)
+
+#ifdef HAVE_APP_STATS
+
+#ifdef HAVE_BOLOS_SDK
+extern volatile uint32_t G_app_stats_ticks;
+#endif
+
+/*
+ * Current tick count (wraps; use unsigned differences).
+ */
+uint32_t app_stats_now(void);
+
+/*
+ * Account one dispatched APDU.
+ *
+ * @param ins    Instruction byte (ignored if >= APP_STATS_NUM_INS).
+ * @param sw     Returned status word.
+ * @param start  Tick count taken before dispatch.
+ */
+void app_stats_record_ins(uint8_t ins, uint16_t sw, uint32_t start);
+
+/*
+ * Account one stage measurement.
+ *
+ * @param stage  Stage measured.
+ * @param count  Calls or bytes (see app_stage_t).
+ * @param start  Tick count taken before the stage.
+ */
+void app_stats_record_stage(app_stage_t stage, uint32_t count, uint32_t start);
+
+/*
+ * Serialize the counters into the GET_STATS response format and reset them.
+ *
+ * @param out     Output buffer.
+ * @param out_len Output buffer size (>= APP_STATS_RESPONSE_LEN).
+ * @return Bytes written, or 0 if the buffer is too small.
+ */
+size_t app_stats_take(uint8_t *out, size_t out_len);
+
+#define APP_STATS_BEGIN(name)                 uint32_t name = app_stats_now()
+#define APP_STATS_END(stage, count, name)     app_stats_record_stage((stage), (uint32_t)(count), (name))
+
+#else
+
+#define APP_STATS_BEGIN(name)
+#define APP_STATS_END(stage, count, name)
+
+#endif /* HAVE_APP_STATS */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_STATS_H */
@@ -0,0 +1,82 @@
+/*
+ * SUM Chain Ledger App - Event Trace Implementation
+ */
+
+#include "app_trace.h"
+#include "globals.h"
+#include <string.h>
+
+#ifdef HAVE_APP_TRACE
+
+#ifdef HAVE_BOLOS_SDK
+
+volatile uint32_t G_app_trace_ticks;
+
+static uint32_t app_trace_now(void) {
+    return G_app_trace_ticks;
+}
+
+#else
+
+#include <time.h>
+
+static uint32_t app_trace_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u);
+}
+
+#endif /* HAVE_BOLOS_SDK */
+
+void app_trace_record(uint8_t event, uint8_t arg, uint16_t value) {
+    app_trace_t *trace = &G_state.trace;
+    app_trace_entry_t *e = &trace->entries[trace->total % APP_TRACE_CAPACITY];
+
+    e->time = app_trace_now();
+    e->event = event;
+    e->arg = arg;
+    e->value = value;
+    trace->total++;
+}
+
+static uint8_t *write_u32_be(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+    return p + 4;
+}
+
+size_t app_trace_read(uint8_t page, uint8_t *out, size_t out_len) {
+    const app_trace_t *trace = &G_state.trace;
+    uint32_t held = (trace->total < APP_TRACE_CAPACITY) ? trace->total : APP_TRACE_CAPACITY;
+    uint32_t oldest = trace->total - held;
+    uint8_t *p = out;
+
+    if (out == NULL || out_len < APP_TRACE_RESPONSE_LEN || page >= APP_TRACE_PAGES) {
+        return 0;
+    }
+
+    *p++ = APP_TRACE_FORMAT;
+    *p++ = (uint8_t)held;
+    p = write_u32_be(p, APP_TRACE_TICK_US);
+    p = write_u32_be(p, trace->total);
+
+    for (uint32_t i = (uint32_t)page * APP_TRACE_PAGE_ENTRIES;
+         i < held && i < (uint32_t)(page + 1) * APP_TRACE_PAGE_ENTRIES; i++) {
+        const app_trace_entry_t *e = &trace->entries[(oldest + i) % APP_TRACE_CAPACITY];
+        p = write_u32_be(p, e->time);
+        *p++ = e->event;
+        *p++ = e->arg;
+        *p++ = (uint8_t)(e->value >> 8);
+        *p++ = (uint8_t)e->value;
+    }
+
+    return (size_t)(p - out);
+}
+
+void app_trace_clear(void) {
+    memset(&G_state.trace, 0, sizeof(G_state.trace));
+}
+
+#endif /* HAVE_APP_TRACE */
@@ -0,0 +1,127 @@
+/*
+ * SUM Chain Ledger App - Event Trace
+ * Fixed-size ring of timestamped events, compiled in only for debug builds
+ * (DEBUG=1 defines HAVE_APP_TRACE). Read through INS_GET_TRACE and rendered
+ * as a per-session timeline by tools/trace_decode.py.
+ */
+
+#ifndef APP_TRACE_H
+#define APP_TRACE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Time source.
+ * Device: SEPROXYHAL ticker events (counted in io_event, 100 ms each). The
+ * ticker only advances while the app waits in io_exchange or on a review
+ * screen, so a gap between two events is time spent waiting, never compute:
+ * derive, hash and parse events of one APDU share a timestamp. The order
+ * is exact.
+ * Host: CLOCK_MONOTONIC in microseconds.
+ */
+#ifdef HAVE_BOLOS_SDK
+#define APP_TRACE_TICK_US         100000
+#else
+#define APP_TRACE_TICK_US         1
+#endif
+
+#define APP_TRACE_FORMAT          1      /* GET_TRACE response format version */
+#define APP_TRACE_CAPACITY        64     /* Events kept; older ones are overwritten */
+#define APP_TRACE_ENTRY_LEN       8      /* Serialized entry size */
+#define APP_TRACE_HEADER_LEN      10
+#define APP_TRACE_PAGE_ENTRIES    28     /* Entries per GET_TRACE response */
+#define APP_TRACE_PAGES           ((APP_TRACE_CAPACITY + APP_TRACE_PAGE_ENTRIES - 1) / APP_TRACE_PAGE_ENTRIES)
+#define APP_TRACE_RESPONSE_LEN    (APP_TRACE_HEADER_LEN + APP_TRACE_PAGE_ENTRIES * APP_TRACE_ENTRY_LEN)
+
+/*
+ * Events. The meaning of `arg` and `value` is given per event.
+ */
+typedef enum {
+    APP_TRACE_APDU_RX = 1,                 /* arg: INS, value: P1 << 8 | Lc */
+    APP_TRACE_APDU_SW,                     /* arg: INS, value: status word */
+    APP_TRACE_PARSE_STATE,                 /* arg: new tx_parse_state_t, value: bytes parsed (low 16 bits) */
+    APP_TRACE_HASH_UPDATE,                 /* value: bytes hashed */
+    APP_TRACE_HASH_FINAL,
+    APP_TRACE_DERIVE_BEGIN,                /* arg: path length, value: path scheme */
+    APP_TRACE_DERIVE_END,                  /* arg: 1 on success (device: a throw leaves no END) */
+    APP_TRACE_UI_SHOW,                     /* arg: app_trace_ui_t */
+    APP_TRACE_UI_DECISION                  /* arg: ui_result_t */
+} app_trace_event_t;
+
+typedef enum {
+    APP_TRACE_UI_TX = 0,                   /* tx_display_show_approval */
+    APP_TRACE_UI_PAIR,                     /* tx_display_show_pair */
+    APP_TRACE_UI_BATCH,                    /* tx_display_show_batch_approval */
+    APP_TRACE_UI_HASH                      /* tx_display_show_hash_approval */
+} app_trace_ui_t;
+
+typedef struct {
+    uint32_t time;                         /* Ticks of APP_TRACE_TICK_US (wraps) */
+    uint8_t  event;                        /* app_trace_event_t */
+    uint8_t  arg;
+    uint16_t value;
+} app_trace_entry_t;
+
+typedef struct {
+    app_trace_entry_t entries[APP_TRACE_CAPACITY];
+    uint32_t          total;               /* Events recorded since the last clear */
+} app_trace_t;
+
+/*
+ * GET_TRACE response (page P1, oldest event first):
+ *   [format:1] [held:1] [tick_us:4 BE] [total:4 BE]
+ *   min(held - P1 * APP_TRACE_PAGE_ENTRIES, APP_TRACE_PAGE_ENTRIES) x
+ *     [time:4 BE] [event:1] [arg:1] [value:2 BE]
+ * held is min(total, APP_TRACE_CAPACITY); total - held events were lost.
+ */
+
+#ifdef HAVE_APP_TRACE
+
+#ifdef HAVE_BOLOS_SDK
+extern volatile uint32_t G_app_trace_ticks;
+#endif
+
+/*
+ * Append one event, overwriting the oldest once the ring is full.
+ *
+ * @param event  Event type (app_trace_event_t).
+ * @param arg    Event argument.
+ * @param value  Event value.
+ */
+void app_trace_record(uint8_t event, uint8_t arg, uint16_t value);
+
+/*
+ * Serialize one page of the ring into the GET_TRACE response format.
+ *
+ * @param page    Page index (< APP_TRACE_PAGES).
+ * @param out     Output buffer.
+ * @param out_len Output buffer size (>= APP_TRACE_RESPONSE_LEN).
+ * @return Bytes written, or 0 if the page or the buffer is invalid.
+ */
+size_t app_trace_read(uint8_t page, uint8_t *out, size_t out_len);
+
+/*
+ * Drop every recorded event.
+ */
+void app_trace_clear(void);
+
+#define APP_TRACE(event, arg, value) \
+    app_trace_record((uint8_t)(event), (uint8_t)(arg), (uint16_t)(value))
+
+#else
+
+#define APP_TRACE(event, arg, value) ((void)0)
+
+#endif /* HAVE_APP_TRACE */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* APP_TRACE_H */
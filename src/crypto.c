@@ -20,8 +20,18 @@ bool crypto_validate_path(const bip32_path_t *path) {
         return false;
     }
 
-    /* For Ed25519, all components should be hardened */
-    for (uint8_t i = 0; i < path->length; i++) {
+    /* SLIP-10 only has hardened children; BIP32-Ed25519 below the account */
+    uint8_t hardened_depth;
+    if (path->scheme == PATH_SCHEME_SLIP10) {
+        hardened_depth = path->length;
+    } else if (path->scheme == PATH_SCHEME_BIP32_ED25519) {
+        hardened_depth = (path->length < BIP32_ED25519_HARDENED_DEPTH) ? path->length
+                                                                       : BIP32_ED25519_HARDENED_DEPTH;
+    } else {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < hardened_depth; i++) {
         if ((path->path[i] & 0x80000000) == 0) {
             return false;  /* Not hardened */
         }
@@ -35,8 +45,8 @@ size_t crypto_parse_path(const uint8_t *data, size_t data_len, bip32_path_t *pat
         return 0;
     }
 
-    /* First byte is path length */
-    uint8_t len = data[0];
+    /* First byte is path length, bit 7 selects the scheme */
+    uint8_t len = data[0] & (uint8_t)~PATH_LEN_FLAG_BIP32_ED25519;
     if (len == 0 || len > MAX_BIP32_PATH_LEN) {
         return 0;
     }
@@ -48,6 +58,8 @@ size_t crypto_parse_path(const uint8_t *data, size_t data_len, bip32_path_t *pat
     }
 
     path->length = len;
+    path->scheme = (data[0] & PATH_LEN_FLAG_BIP32_ED25519) ? PATH_SCHEME_BIP32_ED25519
+                                                           : PATH_SCHEME_SLIP10;
     for (uint8_t i = 0; i < len; i++) {
         const uint8_t *p = &data[1 + i * 4];
         path->path[i] = ((uint32_t)p[0] << 24) |
@@ -61,10 +73,71 @@ size_t crypto_parse_path(const uint8_t *data, size_t data_len, bip32_path_t *pat
 
 #ifdef HAVE_BOLOS_SDK
 
+/*
+ * Derive the private key of a path and initialize key from it. SLIP-10
+ * keys are 32 bytes; BIP32-Ed25519 keys are 64 bytes (kL || kR), which the
+ * SDK accepts as extended Ed25519 keys. raw_privkey and key must be
+ * zeroized by the caller. Throws on SDK errors (the trace then shows a
+ * DERIVE_BEGIN without its DERIVE_END).
+ */
+static void derive_private_key(const bip32_path_t *path,
+                               uint8_t raw_privkey[BIP32_ED25519_PRIVKEY_LEN],
+                               uint8_t *chain32,
+                               cx_ecfp_256_extended_private_key_t *key) {
+    bool bip32 = (path->scheme == PATH_SCHEME_BIP32_ED25519);
+
+    APP_TRACE(APP_TRACE_DERIVE_BEGIN, path->length, path->scheme);
+
+    /* Derive raw private key from seed */
+    os_perso_derive_node_bip32_seed_key(
+        bip32 ? HDW_NORMAL : HDW_ED25519_SLIP10,
+        CX_CURVE_Ed25519,
+        path->path,
+        path->length,
+        raw_privkey,
+        chain32,
+        NULL,
+        0
+    );
+
+    /* Initialize private key structure */
+    cx_ecfp_init_private_key_no_throw(
+        CX_CURVE_Ed25519,
+        raw_privkey,
+        bip32 ? BIP32_ED25519_PRIVKEY_LEN : PRIVKEY_LEN,
+        (cx_ecfp_private_key_t *)key
+    );
+
+    APP_TRACE(APP_TRACE_DERIVE_END, 1, 0);
+}
+
+/* Compressed 32-byte public key of an initialized private key. Throws. */
+static void public_key_of(cx_ecfp_256_extended_private_key_t *private_key, uint8_t pubkey32[32]) {
+    cx_ecfp_public_key_t public_key;
+
+    /* Generate public key */
+    cx_ecfp_generate_pair_no_throw(
+        CX_CURVE_Ed25519,
+        &public_key,
+        (cx_ecfp_private_key_t *)private_key,
+        1  /* Keep private key */
+    );
+
+    /*
+     * Ed25519 public key from BOLOS is 65 bytes: 0x04 || X (32) || Y (32)
+     * We need the compressed form which is just the Y coordinate with
+     * parity in the high bit. For Ed25519, the convention is:
+     * compressed = Y with bit 255 = X[0] & 1
+     */
+    cx_edwards_compress_point_no_throw(CX_CURVE_Ed25519, public_key.W, public_key.W_len);
+    /* After compression, W contains 33 bytes: 0x02/0x03 || 32-byte compressed point */
+    /* Copy the 32-byte compressed key (skip the prefix byte) */
+    memcpy(pubkey32, public_key.W + 1, PUBKEY_LEN);
+}
+
 bool crypto_derive_pubkey(const bip32_path_t *path, uint8_t pubkey32[32]) {
-    cx_ecfp_private_key_t private_key;
-    cx_ecfp_public_key_t  public_key;
-    uint8_t raw_privkey[PRIVKEY_LEN];
+    cx_ecfp_256_extended_private_key_t private_key;
+    uint8_t raw_privkey[BIP32_ED25519_PRIVKEY_LEN];
     bool success = false;
 
     if (path == NULL || pubkey32 == NULL) {
@@ -73,45 +146,38 @@ bool crypto_derive_pubkey(const bip32_path_t *path, uint8_t pubkey32[32]) {
 
     BEGIN_TRY {
         TRY {
-            /* Derive raw private key from seed */
-            os_perso_derive_node_bip32_seed_key(
-                HDW_ED25519_SLIP10,
-                CX_CURVE_Ed25519,
-                path->path,
-                path->length,
-                raw_privkey,
-                NULL,
-                NULL,
-                0
-            );
+            derive_private_key(path, raw_privkey, NULL, &private_key);
+            public_key_of(&private_key, pubkey32);
+            success = true;
+        }
+        CATCH_OTHER(e) {
+            success = false;
+        }
+        FINALLY {
+            /* Zeroize sensitive data */
+            explicit_bzero(&private_key, sizeof(private_key));
+            explicit_bzero(raw_privkey, sizeof(raw_privkey));
+        }
+    }
+    END_TRY;
 
-            /* Initialize private key structure */
-            cx_ecfp_init_private_key_no_throw(
-                CX_CURVE_Ed25519,
-                raw_privkey,
-                PRIVKEY_LEN,
-                &private_key
-            );
+    return success;
+}
 
-            /* Generate public key */
-            cx_ecfp_generate_pair_no_throw(
-                CX_CURVE_Ed25519,
-                &public_key,
-                &private_key,
-                1  /* Keep private key */
-            );
+bool crypto_derive_xpub(const bip32_path_t *path, uint8_t pubkey32[32], uint8_t chain32[32]) {
+    cx_ecfp_256_extended_private_key_t private_key;
+    uint8_t raw_privkey[BIP32_ED25519_PRIVKEY_LEN];
+    bool success = false;
 
-            /*
-             * Ed25519 public key from BOLOS is 65 bytes: 0x04 || X (32) || Y (32)
-             * We need the compressed form which is just the Y coordinate with
-             * parity in the high bit. For Ed25519, the convention is:
-             * compressed = Y with bit 255 = X[0] & 1
-             */
-            cx_edwards_compress_point_no_throw(CX_CURVE_Ed25519, public_key.W, public_key.W_len);
-            /* After compression, W contains 33 bytes: 0x02/0x03 || 32-byte compressed point */
-            /* Copy the 32-byte compressed key (skip the prefix byte) */
-            memcpy(pubkey32, public_key.W + 1, PUBKEY_LEN);
+    if (path == NULL || pubkey32 == NULL || chain32 == NULL ||
+        path->scheme != PATH_SCHEME_BIP32_ED25519) {
+        return false;
+    }
 
+    BEGIN_TRY {
+        TRY {
+            derive_private_key(path, raw_privkey, chain32, &private_key);
+            public_key_of(&private_key, pubkey32);
             success = true;
         }
         CATCH_OTHER(e) {
@@ -129,8 +195,8 @@ bool crypto_derive_pubkey(const bip32_path_t *path, uint8_t pubkey32[32]) {
 }
 
 bool crypto_sign_hash(const bip32_path_t *path, const uint8_t hash32[32], uint8_t sig64[64]) {
-    cx_ecfp_private_key_t private_key;
-    uint8_t raw_privkey[PRIVKEY_LEN];
+    cx_ecfp_256_extended_private_key_t private_key;
+    uint8_t raw_privkey[BIP32_ED25519_PRIVKEY_LEN];
     bool success = false;
     size_t sig_len = SIGNATURE_LEN;
 
@@ -140,29 +206,11 @@ bool crypto_sign_hash(const bip32_path_t *path, const uint8_t hash32[32], uint8_
 
     BEGIN_TRY {
         TRY {
-            /* Derive raw private key from seed */
-            os_perso_derive_node_bip32_seed_key(
-                HDW_ED25519_SLIP10,
-                CX_CURVE_Ed25519,
-                path->path,
-                path->length,
-                raw_privkey,
-                NULL,
-                NULL,
-                0
-            );
-
-            /* Initialize private key structure */
-            cx_ecfp_init_private_key_no_throw(
-                CX_CURVE_Ed25519,
-                raw_privkey,
-                PRIVKEY_LEN,
-                &private_key
-            );
+            derive_private_key(path, raw_privkey, NULL, &private_key);
 
             /* Sign the hash with Ed25519 */
             cx_eddsa_sign_no_throw(
-                &private_key,
+                (cx_ecfp_private_key_t *)&private_key,
                 CX_SHA512,
                 hash32,
                 HASH_LEN,
@@ -187,20 +235,94 @@ bool crypto_sign_hash(const bip32_path_t *path, const uint8_t hash32[32], uint8_
 }
 
 #else
-/* Stub implementations for host-side testing */
+/*
+ * Host backend: SLIP-10 or BIP32-Ed25519 derivation from a fixed test seed
+ * and RFC 8032 Ed25519 (host/slip10.c, host/bip32_ed25519.c,
+ * host/ed25519.c). The seed is SLIP-10 test vector 1, so m/0' etc. can be
+ * checked against the published vectors. Never use with real funds.
+ */
+
+#include "slip10.h"
+#include "bip32_ed25519.h"
+#include "ed25519.h"
+
+static const uint8_t HOST_TEST_SEED[16] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f
+};
+
+/* Private key (32 or 64 bytes by scheme), public key and chain code */
+static bool host_derive(const bip32_path_t *path, uint8_t raw_privkey[BIP32_ED25519_PRIVKEY_LEN],
+                        uint8_t pubkey32[32], uint8_t *chain32) {
+    bool ok;
+
+    APP_TRACE(APP_TRACE_DERIVE_BEGIN, path->length, path->scheme);
+
+    if (path->scheme == PATH_SCHEME_BIP32_ED25519) {
+        ok = bip32_ed25519_derive(HOST_TEST_SEED, sizeof(HOST_TEST_SEED),
+                                  path->path, path->length, raw_privkey, chain32);
+        if (ok) {
+            ed25519_public_key_from_scalar(raw_privkey, pubkey32);
+        }
+    } else {
+        ok = slip10_ed25519_derive(HOST_TEST_SEED, sizeof(HOST_TEST_SEED),
+                                   path->path, path->length, raw_privkey, chain32);
+        if (ok) {
+            ed25519_public_key(raw_privkey, pubkey32);
+        }
+    }
+
+    APP_TRACE(APP_TRACE_DERIVE_END, ok, 0);
+    return ok;
+}
 
 bool crypto_derive_pubkey(const bip32_path_t *path, uint8_t pubkey32[32]) {
-    (void)path;
-    /* Return a dummy pubkey for testing */
-    memset(pubkey32, 0x42, PUBKEY_LEN);
-    return true;
+    uint8_t raw_privkey[BIP32_ED25519_PRIVKEY_LEN];
+
+    if (path == NULL || pubkey32 == NULL) {
+        return false;
+    }
+
+    bool ok = host_derive(path, raw_privkey, pubkey32, NULL);
+
+    SECURE_ZEROIZE(raw_privkey, sizeof(raw_privkey));
+    return ok;
+}
+
+bool crypto_derive_xpub(const bip32_path_t *path, uint8_t pubkey32[32], uint8_t chain32[32]) {
+    uint8_t raw_privkey[BIP32_ED25519_PRIVKEY_LEN];
+
+    if (path == NULL || pubkey32 == NULL || chain32 == NULL ||
+        path->scheme != PATH_SCHEME_BIP32_ED25519) {
+        return false;
+    }
+
+    bool ok = host_derive(path, raw_privkey, pubkey32, chain32);
+
+    SECURE_ZEROIZE(raw_privkey, sizeof(raw_privkey));
+    return ok;
 }
 
 bool crypto_sign_hash(const bip32_path_t *path, const uint8_t hash32[32], uint8_t sig64[64]) {
-    (void)path;
-    (void)hash32;
-    /* Return a dummy signature for testing */
-    memset(sig64, 0xAA, SIGNATURE_LEN);
+    uint8_t raw_privkey[BIP32_ED25519_PRIVKEY_LEN];
+    uint8_t pubkey[PUBKEY_LEN];
+
+    if (path == NULL || hash32 == NULL || sig64 == NULL) {
+        return false;
+    }
+
+    if (!host_derive(path, raw_privkey, pubkey, NULL)) {
+        SECURE_ZEROIZE(raw_privkey, sizeof(raw_privkey));
+        return false;
+    }
+
+    if (path->scheme == PATH_SCHEME_BIP32_ED25519) {
+        ed25519_sign_extended(raw_privkey, pubkey, hash32, HASH_LEN, sig64);
+    } else {
+        ed25519_sign(raw_privkey, pubkey, hash32, HASH_LEN, sig64);
+    }
+
+    SECURE_ZEROIZE(raw_privkey, sizeof(raw_privkey));
     return true;
 }
 
@@ -19,7 +19,9 @@ extern "C" {
  * Validate a BIP32 derivation path.
  * Requirements for Ed25519:
  * - Path length must be 1-MAX_BIP32_PATH_LEN
- * - All components should be hardened (0x80000000 bit set)
+ * - SLIP-10: all components hardened (0x80000000 bit set)
+ * - BIP32-Ed25519: the first BIP32_ED25519_HARDENED_DEPTH components
+ *   hardened, later ones may be non-hardened
  *
  * @param path Pointer to path structure.
  * @return true if valid, false otherwise.
@@ -29,6 +31,8 @@ bool crypto_validate_path(const bip32_path_t *path);
 /*
  * Parse a BIP32 path from raw APDU data.
  * Format: [length:1 byte] [path[0]:4 bytes BE] [path[1]:4 bytes BE] ...
+ * Bit 7 of the length byte (PATH_LEN_FLAG_BIP32_ED25519) selects the
+ * BIP32-Ed25519 scheme; otherwise the path is SLIP-10.
  *
  * @param data     Raw data buffer.
  * @param data_len Length of data buffer.
@@ -46,6 +50,18 @@ size_t crypto_parse_path(const uint8_t *data, size_t data_len, bip32_path_t *pat
  */
 bool crypto_derive_pubkey(const bip32_path_t *path, uint8_t pubkey32[32]);
 
+/*
+ * Derive the extended public key (public key and chain code) of a
+ * BIP32-Ed25519 path, from which non-hardened children can be derived
+ * without the device.
+ *
+ * @param path      Validated BIP32-Ed25519 path.
+ * @param pubkey32  Output buffer for 32-byte public key.
+ * @param chain32   Output buffer for 32-byte chain code.
+ * @return false for SLIP-10 paths or on failure.
+ */
+bool crypto_derive_xpub(const bip32_path_t *path, uint8_t pubkey32[32], uint8_t chain32[32]);
+
 /*
  * Sign a 32-byte hash with Ed25519 using the private key at the given path.
  * The private key is derived, used, and immediately zeroized.
@@ -472,8 +472,24 @@ INLINE void hasher_push_cv(blake3_hasher *self, uint8_t new_cv[BLAKE3_OUT_LEN],
   self->cv_stack_len += 1;
 }
 
-INLINE void blake3_hasher_update_base(blake3_hasher *self, const void *input,
-                                      size_t input_len, bool use_tbb) {
+// Fast path for input that fits in what is left of the current chunk, which
+// covers every update the app makes per SIGN_TX APDU. Nothing can be pushed
+// to the CV stack, so none of the subtree logic below applies: the bytes go
+// straight into the chunk state. The result is identical to the general
+// path, including its merge when the chunk was empty before this update.
+INLINE void hasher_update_within_chunk(blake3_hasher *self,
+                                       const uint8_t *input_bytes,
+                                       size_t input_len) {
+  bool chunk_was_empty = chunk_state_len(&self->chunk) == 0;
+  chunk_state_update(&self->chunk, input_bytes, input_len);
+  if (chunk_was_empty) {
+    hasher_merge_cv_stack(self, self->chunk.chunk_counter);
+  }
+}
+
+INLINE void hasher_update_general(blake3_hasher *self, const void *input,
+                                  size_t input_len, bool use_tbb,
+                                  bool iterative) {
   // Explicitly checking for zero avoids causing UB by passing a null pointer
   // to memcpy. This comes up in practice with things like:
   //   std::vector<uint8_t> v;
@@ -520,8 +536,15 @@ INLINE void blake3_hasher_update_base(blake3_hasher *self, const void *input,
   //   to complete the current subtree first.
   // Because we might need to break up the input to form powers of 2, or to
   // evenly divide what we already have, this part runs in a loop.
+  //
+  // The iterative variant (BLAKE3_ITERATIVE_SUBTREE) always takes one chunk
+  // and lets hasher_push_cv() merge it into the CV stack. That never enters
+  // blake3_compress_subtree_wide(), whose recursion depth and cv_array
+  // frames grow with the input, so the stack use of update() is fixed. The
+  // output is the same; only SIMD and multi-threading width is given up.
   while (input_len > BLAKE3_CHUNK_LEN) {
-    size_t subtree_len = round_down_to_power_of_2(input_len);
+    size_t subtree_len = iterative ? BLAKE3_CHUNK_LEN
+                                   : round_down_to_power_of_2(input_len);
     uint64_t count_so_far = self->chunk.chunk_counter * BLAKE3_CHUNK_LEN;
     // Shrink the subtree_len until it evenly divides the count so far. We know
     // that subtree_len itself is a power of 2, so we can use a bitmasking
@@ -581,6 +604,32 @@ INLINE void blake3_hasher_update_base(blake3_hasher *self, const void *input,
   }
 }
 
+INLINE void blake3_hasher_update_base(blake3_hasher *self, const void *input,
+                                      size_t input_len, bool use_tbb) {
+  if (input_len == 0) {
+    return;
+  }
+  if (input_len <= BLAKE3_CHUNK_LEN - chunk_state_len(&self->chunk)) {
+    hasher_update_within_chunk(self, (const uint8_t *)input, input_len);
+    return;
+  }
+  hasher_update_general(self, input, input_len, use_tbb,
+                        BLAKE3_ITERATIVE_SUBTREE_ENABLED);
+}
+
+#if defined(BLAKE3_TESTING)
+void blake3_hasher_update_general(blake3_hasher *self, const void *input,
+                                  size_t input_len) {
+  hasher_update_general(self, input, input_len, false,
+                        BLAKE3_ITERATIVE_SUBTREE_ENABLED);
+}
+
+void blake3_hasher_update_iterative(blake3_hasher *self, const void *input,
+                                    size_t input_len) {
+  hasher_update_general(self, input, input_len, false, true);
+}
+#endif
+
 void blake3_hasher_update(blake3_hasher *self, const void *input,
                           size_t input_len) {
   bool use_tbb = false;
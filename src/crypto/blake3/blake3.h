@@ -35,7 +35,26 @@ extern "C" {
 #define BLAKE3_OUT_LEN 32
 #define BLAKE3_BLOCK_LEN 64
 #define BLAKE3_CHUNK_LEN 1024
+// The app hashes at most MAX_TX_SIZE (64 KiB, 2^6 chunks) per hasher, so on
+// the device the CV stack needs 7 entries instead of 55. sum_blake3.c checks
+// the bound against MAX_TX_SIZE.
+#if defined(HAVE_BOLOS_SDK)
+#define BLAKE3_MAX_DEPTH 6
+#else
 #define BLAKE3_MAX_DEPTH 54
+#endif
+
+// Host builds without oneTBB get blake3_hasher_update_tbb() from a pthread
+// pool instead (blake3_pthread.c).
+#if defined(BLAKE3_USE_PTHREADS)
+#if defined(HAVE_BOLOS_SDK)
+#error "BLAKE3_USE_PTHREADS is for host builds only"
+#endif
+#if !defined(BLAKE3_USE_TBB)
+#define BLAKE3_USE_TBB
+#endif
+#define BLAKE3_PTHREAD_MAX_THREADS 64
+#endif
 
 // This struct is a private implementation detail. It has to be here because
 // it's part of the blake3_hasher structure defined below.
@@ -73,6 +92,12 @@ BLAKE3_API void blake3_hasher_update(blake3_hasher *self, const void *input,
 BLAKE3_API void blake3_hasher_update_tbb(blake3_hasher *self, const void *input,
                                          size_t input_len);
 #endif // BLAKE3_USE_TBB
+#if defined(BLAKE3_USE_PTHREADS)
+// Threads used by blake3_hasher_update_tbb(), counting the caller: 0 = online
+// CPUs (the default), 1 = no workers. Stops the current workers, which
+// restart on the next update; must not be called while an update runs.
+BLAKE3_API void blake3_pthread_set_threads(unsigned num_threads);
+#endif
 BLAKE3_API void blake3_hasher_finalize(const blake3_hasher *self, uint8_t *out,
                                        size_t out_len);
 BLAKE3_API void blake3_hasher_finalize_seek(const blake3_hasher *self, uint64_t seek,
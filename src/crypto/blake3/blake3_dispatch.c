@@ -1,33 +1,81 @@
 /*
  * BLAKE3 Dispatch - Portable Only
  * For Ledger embedded environment: only use portable backend.
+ *
+ * Host test builds (BLAKE3_TESTING) route every call through a backend
+ * table instead, so the test suite can select each backend in turn. A new
+ * kernel is added to g_backends and is then covered by the vector suite
+ * and its throughput report.
  */
 
 #include "blake3_impl.h"
 #include <string.h>
 
+#if defined(BLAKE3_TESTING)
+
+static const blake3_backend_t g_backends[] = {
+    {
+        "portable",
+        blake3_compress_in_place_portable,
+        blake3_compress_xof_portable,
+        blake3_hash_many_portable,
+        1,
+    },
+};
+
+static const blake3_backend_t *g_backend = &g_backends[0];
+
+size_t blake3_backend_count(void) {
+    return sizeof(g_backends) / sizeof(g_backends[0]);
+}
+
+const blake3_backend_t *blake3_backend_get(size_t index) {
+    return (index < blake3_backend_count()) ? &g_backends[index] : NULL;
+}
+
+bool blake3_backend_select(size_t index) {
+    if (index >= blake3_backend_count()) {
+        return false;
+    }
+    g_backend = &g_backends[index];
+    return true;
+}
+
+#define COMPRESS_IN_PLACE  g_backend->compress_in_place
+#define COMPRESS_XOF       g_backend->compress_xof
+#define HASH_MANY          g_backend->hash_many
+#define SIMD_DEGREE        g_backend->simd_degree
+
+#else
+
 /* On Ledger, we only use the portable implementation */
+#define COMPRESS_IN_PLACE  blake3_compress_in_place_portable
+#define COMPRESS_XOF       blake3_compress_xof_portable
+#define HASH_MANY          blake3_hash_many_portable
+#define SIMD_DEGREE        1   /* Portable = no SIMD */
+
+#endif /* BLAKE3_TESTING */
+
 void blake3_compress_in_place(uint32_t cv[8],
                               const uint8_t block[BLAKE3_BLOCK_LEN],
                               uint8_t block_len, uint64_t counter,
                               uint8_t flags) {
-    blake3_compress_in_place_portable(cv, block, block_len, counter, flags);
+    COMPRESS_IN_PLACE(cv, block, block_len, counter, flags);
 }
 
 void blake3_compress_xof(const uint32_t cv[8],
                          const uint8_t block[BLAKE3_BLOCK_LEN],
                          uint8_t block_len, uint64_t counter, uint8_t flags,
                          uint8_t out[64]) {
-    blake3_compress_xof_portable(cv, block, block_len, counter, flags, out);
+    COMPRESS_XOF(cv, block, block_len, counter, flags, out);
 }
 
 void blake3_hash_many(const uint8_t *const *inputs, size_t num_inputs,
                       size_t blocks, const uint32_t key[8], uint64_t counter,
                       bool increment_counter, uint8_t flags,
                       uint8_t flags_start, uint8_t flags_end, uint8_t *out) {
-    blake3_hash_many_portable(inputs, num_inputs, blocks, key, counter,
-                              increment_counter, flags, flags_start, flags_end,
-                              out);
+    HASH_MANY(inputs, num_inputs, blocks, key, counter,
+              increment_counter, flags, flags_start, flags_end, out);
 }
 
 /*
@@ -39,10 +87,10 @@ void blake3_xof_many(const uint32_t cv[8],
                      uint8_t block_len, uint64_t counter, uint8_t flags,
                      uint8_t out[64], size_t outblocks) {
     for (size_t i = 0; i < outblocks; i++) {
-        blake3_compress_xof_portable(cv, block, block_len, counter + i, flags, out + i * 64);
+        COMPRESS_XOF(cv, block, block_len, counter + i, flags, out + i * 64);
     }
 }
 
 size_t blake3_simd_degree(void) {
-    return 1;  /* Portable = no SIMD */
+    return SIMD_DEGREE;
 }
@@ -83,6 +83,15 @@ enum blake3_flags {
 // MAX_SIMD_DEGREE, but also at least 2.
 #define MAX_SIMD_DEGREE_OR_2 (MAX_SIMD_DEGREE > 2 ? MAX_SIMD_DEGREE : 2)
 
+// Multi-chunk updates hash one chunk at a time instead of recursing through
+// blake3_compress_subtree_wide(), so update() has a fixed stack footprint.
+// Defined by the device Makefile; host builds keep the recursive path.
+#if defined(BLAKE3_ITERATIVE_SUBTREE)
+#define BLAKE3_ITERATIVE_SUBTREE_ENABLED true
+#else
+#define BLAKE3_ITERATIVE_SUBTREE_ENABLED false
+#endif
+
 static const uint32_t IV[8] = {0x6A09E667UL, 0xBB67AE85UL, 0x3C6EF372UL,
                                0xA54FF53AUL, 0x510E527FUL, 0x9B05688CUL,
                                0x1F83D9ABUL, 0x5BE0CD19UL};
@@ -220,6 +229,39 @@ void blake3_hash_many(const uint8_t *const *inputs, size_t num_inputs,
 
 size_t blake3_simd_degree(void);
 
+#if defined(BLAKE3_TESTING)
+// Host test hook: the compression backends linked into this build. The
+// dispatch functions above route through the selected one, so test vectors
+// and timings can be run per backend. Never defined in device builds.
+typedef struct {
+  const char *name;
+  void (*compress_in_place)(uint32_t cv[8], const uint8_t block[BLAKE3_BLOCK_LEN],
+                            uint8_t block_len, uint64_t counter, uint8_t flags);
+  void (*compress_xof)(const uint32_t cv[8], const uint8_t block[BLAKE3_BLOCK_LEN],
+                       uint8_t block_len, uint64_t counter, uint8_t flags,
+                       uint8_t out[64]);
+  void (*hash_many)(const uint8_t *const *inputs, size_t num_inputs,
+                    size_t blocks, const uint32_t key[8], uint64_t counter,
+                    bool increment_counter, uint8_t flags,
+                    uint8_t flags_start, uint8_t flags_end, uint8_t *out);
+  size_t simd_degree;
+} blake3_backend_t;
+
+size_t blake3_backend_count(void);
+const blake3_backend_t *blake3_backend_get(size_t index);
+bool blake3_backend_select(size_t index);
+
+// blake3_hasher_update() without the within-chunk fast path, as the
+// reference for differential tests.
+void blake3_hasher_update_general(blake3_hasher *self, const void *input,
+                                  size_t input_len);
+
+// The general update path with BLAKE3_ITERATIVE_SUBTREE forced on, so host
+// tests check the device variant against the recursive one.
+void blake3_hasher_update_iterative(blake3_hasher *self, const void *input,
+                                    size_t input_len);
+#endif
+
 BLAKE3_PRIVATE size_t blake3_compress_subtree_wide(const uint8_t *input, size_t input_len,
                                                    const uint32_t key[8],
                                                    uint64_t chunk_counter, uint8_t flags,
@@ -0,0 +1,191 @@
+/*
+ * BLAKE3 Pthread Join - Host Builds Only
+ *
+ * Backs blake3_hasher_update_tbb() with a pool of POSIX threads instead of
+ * oneTBB. blake3_compress_subtree_wide() splits its input into a left and a
+ * right subtree and calls the join below at each level. The right subtree
+ * is queued for a worker while the caller hashes the left one; the caller
+ * then takes the right one back if no worker has started it, or waits for
+ * it. Nobody waits on a task that is not running, so workers can join
+ * nested subtrees the same way.
+ *
+ * The tree and the chaining values are the same as on one thread; only
+ * who computes each subtree changes. Workers start on first use. The pool
+ * and its queue are static, and tasks live in the frames of their joiners.
+ */
+
+#include "blake3_impl.h"
+
+#if defined(BLAKE3_USE_PTHREADS)
+
+#include <pthread.h>
+#include <unistd.h>
+
+/* Smaller subtrees are hashed inline: a hand-off costs more than the work */
+#define JOIN_MIN_SPLIT_LEN  (64 * BLAKE3_CHUNK_LEN)
+/* Joins beyond this many queued subtrees hash both halves inline */
+#define JOIN_QUEUE_LEN      64
+
+typedef struct {
+  const uint32_t *key;
+  const uint8_t *input;
+  size_t input_len;
+  uint64_t chunk_counter;
+  uint8_t flags;
+  uint8_t *cvs;
+  size_t *n;
+  bool done;
+} subtree_task_t;
+
+static struct {
+  pthread_mutex_t lock;
+  pthread_cond_t queued;    /* A task was queued, or the pool is stopping */
+  pthread_cond_t finished;  /* A worker finished a task */
+  pthread_t workers[BLAKE3_PTHREAD_MAX_THREADS];
+  unsigned num_workers;
+  unsigned num_threads;     /* Requested, counting the caller; 0 = online CPUs */
+  bool started;
+  bool stopping;
+  subtree_task_t *queue[JOIN_QUEUE_LEN];  /* Oldest (largest) first */
+  size_t queue_len;
+} g_pool = {
+  .lock = PTHREAD_MUTEX_INITIALIZER,
+  .queued = PTHREAD_COND_INITIALIZER,
+  .finished = PTHREAD_COND_INITIALIZER,
+};
+
+static void run_task(subtree_task_t *task) {
+  *task->n = blake3_compress_subtree_wide(task->input, task->input_len,
+                                          task->key, task->chunk_counter,
+                                          task->flags, task->cvs, true);
+}
+
+/* Lock held */
+static void queue_remove(size_t index) {
+  g_pool.queue_len -= 1;
+  memmove(&g_pool.queue[index], &g_pool.queue[index + 1],
+          (g_pool.queue_len - index) * sizeof(g_pool.queue[0]));
+}
+
+static void *worker_main(void *arg) {
+  (void)arg;
+
+  pthread_mutex_lock(&g_pool.lock);
+  for (;;) {
+    while (g_pool.queue_len == 0 && !g_pool.stopping) {
+      pthread_cond_wait(&g_pool.queued, &g_pool.lock);
+    }
+    if (g_pool.stopping) {
+      break;
+    }
+    subtree_task_t *task = g_pool.queue[0];
+    queue_remove(0);
+    pthread_mutex_unlock(&g_pool.lock);
+
+    run_task(task);
+
+    pthread_mutex_lock(&g_pool.lock);
+    task->done = true;
+    pthread_cond_broadcast(&g_pool.finished);
+  }
+  pthread_mutex_unlock(&g_pool.lock);
+  return NULL;
+}
+
+/* Lock held. Start the workers once; a failed spawn just leaves fewer */
+static void pool_start(void) {
+  if (g_pool.started) {
+    return;
+  }
+  g_pool.started = true;
+
+  unsigned threads = g_pool.num_threads;
+  if (threads == 0) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    threads = (cpus > 0) ? (unsigned)cpus : 1;
+  }
+  if (threads > BLAKE3_PTHREAD_MAX_THREADS) {
+    threads = BLAKE3_PTHREAD_MAX_THREADS;
+  }
+  while (g_pool.num_workers + 1 < threads &&
+         pthread_create(&g_pool.workers[g_pool.num_workers], NULL, worker_main,
+                        NULL) == 0) {
+    g_pool.num_workers += 1;
+  }
+}
+
+static bool pool_submit(subtree_task_t *task) {
+  bool queued = false;
+
+  pthread_mutex_lock(&g_pool.lock);
+  pool_start();
+  if (g_pool.num_workers > 0 && g_pool.queue_len < JOIN_QUEUE_LEN) {
+    g_pool.queue[g_pool.queue_len++] = task;
+    pthread_cond_signal(&g_pool.queued);
+    queued = true;
+  }
+  pthread_mutex_unlock(&g_pool.lock);
+  return queued;
+}
+
+/* Take the task back if it is still queued, otherwise wait for its worker */
+static void pool_join(subtree_task_t *task) {
+  pthread_mutex_lock(&g_pool.lock);
+  for (size_t i = 0; i < g_pool.queue_len; i++) {
+    if (g_pool.queue[i] == task) {
+      queue_remove(i);
+      pthread_mutex_unlock(&g_pool.lock);
+      run_task(task);
+      return;
+    }
+  }
+  while (!task->done) {
+    pthread_cond_wait(&g_pool.finished, &g_pool.lock);
+  }
+  pthread_mutex_unlock(&g_pool.lock);
+}
+
+void blake3_compress_subtree_wide_join_tbb(
+    // shared params
+    const uint32_t key[8], uint8_t flags, bool use_tbb,
+    // left-hand side params
+    const uint8_t *l_input, size_t l_input_len, uint64_t l_chunk_counter,
+    uint8_t *l_cvs, size_t *l_n,
+    // right-hand side params
+    const uint8_t *r_input, size_t r_input_len, uint64_t r_chunk_counter,
+    uint8_t *r_cvs, size_t *r_n) NOEXCEPT {
+  subtree_task_t right = {key,   r_input, r_input_len, r_chunk_counter,
+                          flags, r_cvs,   r_n,         false};
+  bool queued =
+      use_tbb && l_input_len >= JOIN_MIN_SPLIT_LEN && pool_submit(&right);
+
+  *l_n = blake3_compress_subtree_wide(l_input, l_input_len, key,
+                                      l_chunk_counter, flags, l_cvs, use_tbb);
+  if (queued) {
+    pool_join(&right);
+  } else {
+    *r_n = blake3_compress_subtree_wide(r_input, r_input_len, key,
+                                        r_chunk_counter, flags, r_cvs,
+                                        use_tbb);
+  }
+}
+
+void blake3_pthread_set_threads(unsigned num_threads) {
+  pthread_mutex_lock(&g_pool.lock);
+  g_pool.stopping = true;
+  pthread_cond_broadcast(&g_pool.queued);
+  pthread_mutex_unlock(&g_pool.lock);
+
+  for (unsigned i = 0; i < g_pool.num_workers; i++) {
+    pthread_join(g_pool.workers[i], NULL);
+  }
+
+  pthread_mutex_lock(&g_pool.lock);
+  g_pool.num_workers = 0;
+  g_pool.num_threads = num_threads;
+  g_pool.started = false;
+  g_pool.stopping = false;
+  pthread_mutex_unlock(&g_pool.lock);
+}
+
+#endif /* BLAKE3_USE_PTHREADS */
@@ -3,21 +3,29 @@
  */
 
 #include "sum_blake3.h"
+#include "globals.h"
 #include <string.h>
 
-/* Ledger SDK provides explicit_bzero; fallback for host testing */
-#ifdef HAVE_BOLOS_SDK
-#include "os.h"
-#define secure_memzero(ptr, len) explicit_bzero((ptr), (len))
-#else
-/* Volatile pointer trick to prevent optimization */
-static void secure_memzero(void *ptr, size_t len) {
-    volatile uint8_t *p = (volatile uint8_t *)ptr;
-    while (len--) {
-        *p++ = 0;
+#define CV_STACK_ENTRIES  (BLAKE3_MAX_DEPTH + 1)
+
+/* Every hasher input is at most MAX_TX_SIZE bytes (see blake3.h) */
+_Static_assert((MAX_TX_SIZE + BLAKE3_CHUNK_LEN - 1) / BLAKE3_CHUNK_LEN <= (1ULL << BLAKE3_MAX_DEPTH),
+               "BLAKE3_MAX_DEPTH too small for MAX_TX_SIZE");
+
+/*
+ * Entries of the chaining-value stack that a hasher with this many
+ * completed chunks can have written. A CV is pushed after merging down to
+ * popcount(chunks before it) entries, so the stack never holds more than
+ * bitlen(chunk_counter) + 1.
+ */
+static uint8_t cv_stack_bound(uint64_t chunk_counter) {
+    uint8_t bits = 0;
+    while (chunk_counter != 0) {
+        bits++;
+        chunk_counter >>= 1;
     }
+    return (uint8_t)(bits + 1 < CV_STACK_ENTRIES ? bits + 1 : CV_STACK_ENTRIES);
 }
-#endif
 
 void sum_blake3_init(sum_blake3_ctx_t *ctx) {
     if (ctx == NULL) {
@@ -35,6 +43,11 @@ void sum_blake3_update(sum_blake3_ctx_t *ctx, const uint8_t *in, size_t in_len)
         return;
     }
     blake3_hasher_update(&ctx->hasher, in, in_len);
+
+    uint8_t used = cv_stack_bound(ctx->hasher.chunk.chunk_counter);
+    if (used > ctx->cv_used) {
+        ctx->cv_used = used;
+    }
 }
 
 void sum_blake3_finalize32(sum_blake3_ctx_t *ctx, uint8_t out32[32]) {
@@ -47,11 +60,11 @@ void sum_blake3_finalize32(sum_blake3_ctx_t *ctx, uint8_t out32[32]) {
 }
 
 void sum_blake3_hash(const uint8_t *in, size_t in_len, uint8_t out32[32]) {
-    sum_blake3_ctx_t ctx;
+    sum_blake3_ctx_t ctx = SUM_BLAKE3_CTX_INIT;
     sum_blake3_init(&ctx);
     sum_blake3_update(&ctx, in, in_len);
     sum_blake3_finalize32(&ctx, out32);
-    sum_blake3_zeroize(&ctx);
+    sum_blake3_zeroize_used(&ctx);
 }
 
 void sum_blake3_reset(sum_blake3_ctx_t *ctx) {
@@ -66,5 +79,21 @@ void sum_blake3_zeroize(sum_blake3_ctx_t *ctx) {
     if (ctx == NULL) {
         return;
     }
-    secure_memzero(ctx, sizeof(sum_blake3_ctx_t));
+    SECURE_ZEROIZE(ctx, sizeof(*ctx));
+}
+
+void sum_blake3_zeroize_used(sum_blake3_ctx_t *ctx) {
+    if (ctx == NULL) {
+        return;
+    }
+
+    uint8_t *bytes = (uint8_t *)ctx;
+    size_t used = ctx->cv_used < CV_STACK_ENTRIES ? ctx->cv_used : CV_STACK_ENTRIES;
+    size_t stack_start = offsetof(sum_blake3_ctx_t, hasher) + offsetof(blake3_hasher, cv_stack);
+    size_t stack_end = stack_start + sizeof(ctx->hasher.cv_stack);
+
+    /* Key, chunk state, stack length and the used stack entries */
+    SECURE_ZEROIZE(bytes, stack_start + used * BLAKE3_OUT_LEN);
+    /* Padding and wrapper fields after the stack */
+    SECURE_ZEROIZE(bytes + stack_end, sizeof(sum_blake3_ctx_t) - stack_end);
 }
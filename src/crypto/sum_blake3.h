@@ -18,12 +18,24 @@ extern "C" {
 /*
  * Wrapped hasher context type.
  * Contains the underlying blake3_hasher plus any app-specific state.
+ *
+ * cv_used is a high-water mark of the chaining-value stack (1760 bytes on
+ * the host, 224 on the device, of which a transaction of n chunks touches
+ * at most bitlen(n) + 1 entries).
+ * init/reset keep it, so a context that is re-armed without zeroizing still
+ * has its stale entries wiped by sum_blake3_zeroize_used. It is only
+ * meaningful for a context that started zero: static storage,
+ * SUM_BLAKE3_CTX_INIT, or a previous zeroize.
  */
 typedef struct {
     blake3_hasher hasher;
     uint8_t initialized;   /* Guard against use before init */
+    uint8_t cv_used;       /* cv_stack entries written since the last zeroize */
 } sum_blake3_ctx_t;
 
+/* Initializer for contexts on the stack: all zero, so cv_used is valid */
+#define SUM_BLAKE3_CTX_INIT { .initialized = 0, .cv_used = 0 }
+
 /*
  * Initialize a BLAKE3 hasher context for standard hashing.
  * Must be called before update/finalize.
@@ -70,12 +82,24 @@ void sum_blake3_reset(sum_blake3_ctx_t *ctx);
 
 /*
  * Securely zeroize the context to clear any internal state.
- * Should be called when done with sensitive data.
+ * Should be called when done with sensitive data. The whole context is
+ * written, so it is all zero afterwards whatever it held before.
  *
  * @param ctx Context to zeroize.
  */
 void sum_blake3_zeroize(sum_blake3_ctx_t *ctx);
 
+/*
+ * Like sum_blake3_zeroize, but only the cv_used entries of the
+ * chaining-value stack are written. The context must have started zero
+ * (static storage, SUM_BLAKE3_CTX_INIT, or a previous zeroize); then it is
+ * all zero afterwards. On any other context the stack entries above
+ * cv_used keep whatever they held.
+ *
+ * @param ctx Context to zeroize.
+ */
+void sum_blake3_zeroize_used(sum_blake3_ctx_t *ctx);
+
 #ifdef __cplusplus
 }
 #endif
@@ -10,6 +10,9 @@
 #include <stddef.h>
 
 #include "crypto/sum_blake3.h"
+#include "app_stats.h"
+#include "app_trace.h"
+#include "merkle.h"
 
 #ifdef HAVE_BOLOS_SDK
 #include "os.h"
@@ -34,9 +37,23 @@
 #define INS_GET_PUBLIC_KEY    0x02
 #define INS_GET_ADDRESS       0x03
 #define INS_SIGN_TX           0x04
+#define INS_GET_STATS         0x05     /* Only with HAVE_APP_STATS */
+#define INS_SIGN_MERKLE       0x06
+#define INS_SIGN_HASH         0x07     /* Only when enabled in Settings */
+#define INS_RESUME            0x08
+#define INS_GET_XPUB          0x09     /* BIP32-Ed25519 paths only */
+#define INS_GET_TRACE         0x0A     /* Only with HAVE_APP_TRACE */
 
 /*
- * APDU P1/P2 constants for INS_SIGN_TX
+ * INS_RESUME response: [kind:1] [offset:4 BE]
+ */
+#define RESUME_KIND_NONE          0x00   /* No session to resume */
+#define RESUME_KIND_SIGN_TX       0x01
+#define RESUME_KIND_SIGN_MERKLE   0x02
+#define RESUME_RESPONSE_LEN       5
+
+/*
+ * APDU P1/P2 constants for INS_SIGN_TX and INS_SIGN_MERKLE
  */
 #define P1_FIRST_CHUNK        0x00
 #define P1_MORE_CHUNK         0x80
@@ -44,6 +61,11 @@
 #define P2_LAST_CHUNK         0x00
 #define P2_MORE_CHUNKS        0x80
 
+/*
+ * INS_GET_TRACE: P1 is the page, P2 0x01 clears the ring after the read
+ */
+#define P2_TRACE_CLEAR        0x01
+
 /*
  * Status words
  */
@@ -74,18 +96,38 @@
 #define ADDRESS_LEN               20     /* SUM Chain address (bytes) */
 #define ADDRESS_BASE58_MAX_LEN    35     /* Base58 encoded address + null */
 #define HASH_LEN                  32     /* BLAKE3 hash output */
-#define MAX_TX_SIZE               8192   /* Maximum transaction size (streaming, not buffered) */
+#define MAX_TX_SIZE               65536  /* Maximum transaction size (streaming, not buffered) */
+#define SIGN_HASH_HEADER_LEN      24     /* INS_SIGN_HASH: chain_id, nonce, fee (u64 LE each) */
+#define CHAIN_CODE_LEN            32     /* BIP32 chain code */
+#define XPUB_LEN                  64     /* INS_GET_XPUB: pubkey || chain code */
+
+/*
+ * Key derivation schemes. The scheme travels in bit 7 of the path length
+ * byte. SLIP-10 (default) only has hardened children. BIP32-Ed25519
+ * (Khovratovich-Law, as used by HDW_NORMAL on Ed25519) also has
+ * non-hardened children, which a host can derive from the extended public
+ * key returned by INS_GET_XPUB. Its first BIP32_ED25519_HARDENED_DEPTH
+ * components (purpose'/coin'/account') must still be hardened.
+ */
+#define PATH_SCHEME_SLIP10              0x00
+#define PATH_SCHEME_BIP32_ED25519       0x01
+#define PATH_LEN_FLAG_BIP32_ED25519     0x80
+#define BIP32_ED25519_HARDENED_DEPTH    3
+#define BIP32_ED25519_PRIVKEY_LEN       64     /* kL || kR */
 
 /*
  * Transaction types
  */
 #define TX_TYPE_TRANSFER          0x00
+#define TX_TYPE_CALL              0x01   /* Transfer plus length-prefixed opaque data */
+#define TX_TYPE_MULTI_TRANSFER    0x02   /* Count plus (recipient, amount) pairs */
 
 /*
  * BIP32 derivation path structure
  */
 typedef struct {
     uint8_t  length;                       /* Number of path components (1-10) */
+    uint8_t  scheme;                       /* PATH_SCHEME_* */
     uint32_t path[MAX_BIP32_PATH_LEN];     /* Path components */
 } bip32_path_t;
 
@@ -104,6 +146,11 @@ typedef enum {
     /* Transfer-specific fields */
     TX_PARSE_STATE_RECIPIENT,
     TX_PARSE_STATE_AMOUNT,
+    /* Call-specific fields */
+    TX_PARSE_STATE_DATA_LEN,
+    TX_PARSE_STATE_DATA,                   /* Hashed in place, never buffered */
+    /* Multi-transfer: count, then RECIPIENT/AMOUNT once per pair */
+    TX_PARSE_STATE_RECIPIENT_COUNT,
     /* Terminal states */
     TX_PARSE_STATE_DONE,
     TX_PARSE_STATE_ERROR
@@ -121,10 +168,22 @@ typedef struct {
     uint64_t gas_limit;
     uint8_t  tx_type;
 
-    /* Transfer-specific */
+    /* Transfer-specific (multi-transfer: the current pair only) */
     uint8_t  recipient[ADDRESS_LEN];
     uint64_t amount;                       /* TODO: Upgrade to u128 if needed */
 
+    /* Multi-transfer-specific */
+    uint16_t recipient_count;              /* Pairs announced by the tx */
+    uint16_t recipient_index;              /* Pairs parsed so far */
+
+    /* Sum of all amounts (128-bit, lo/hi); set for every tx type once done */
+    uint64_t total_amount_lo;
+    uint64_t total_amount_hi;
+
+    /* Call-specific */
+    uint32_t data_len;                     /* Opaque data length */
+    uint8_t  data_hash[HASH_LEN];          /* BLAKE3 of the opaque data (fingerprint) */
+
     /* Computed fields for display */
     bool     fee_overflow;                 /* True if gas_price * gas_limit overflows */
     uint64_t fee_low;                      /* Low 64 bits of fee */
@@ -140,20 +199,149 @@ typedef struct {
     uint8_t          scratch[32];          /* Scratch buffer for partial field accumulation */
     tx_parsed_t      parsed;               /* Accumulated parsed values */
     size_t           total_consumed;       /* Total bytes consumed so far */
+    uint32_t         data_remaining;       /* Opaque data bytes still expected */
+    bool             pair_ready;           /* A multi-transfer pair was just completed */
+    sum_blake3_ctx_t data_hash_ctx;        /* Fingerprint of the opaque data (last: wiped on its own) */
 } tx_parser_ctx_t;
 
+/*
+ * Merkle batch state (INS_SIGN_MERKLE)
+ * Totals are 128-bit (lo, hi) so no batch of u64 values can overflow them.
+ */
+typedef struct {
+    merkle_acc_t    tree;                  /* Subtree roots of the tx digests */
+    uint64_t        chain_id;              /* Chain ID shared by every tx */
+    uint64_t        amount_lo;             /* Sum of amounts */
+    uint64_t        amount_hi;
+    uint64_t        fee_lo;                /* Sum of max fees */
+    uint64_t        fee_hi;
+} merkle_batch_t;
+
 /*
  * Signing session state
  */
 typedef struct {
     bool            initialized;           /* Session active flag */
+    bool            is_batch;              /* Started by INS_SIGN_MERKLE */
     bip32_path_t    path;                  /* Derivation path for signing key */
-    sum_blake3_ctx_t tx_hash_ctx;          /* Streaming hash context */
-    tx_parser_ctx_t parser;                /* Streaming parser context */
+    sum_blake3_ctx_t tx_hash_ctx;          /* Streaming hash context (current tx) */
+    tx_parser_ctx_t parser;                /* Streaming parser context (current tx) */
     size_t          total_received;        /* Total tx bytes received */
     bool            last_chunk_received;   /* True when P2 indicates last chunk */
+    bool            pairs_unreviewed;      /* Pair review skipped: sign from sig_cache only */
+    merkle_batch_t  batch;                 /* Batch tree and totals (is_batch only) */
 } sign_session_t;
 
+/*
+ * Last approved SIGN_TX signature, kept for a short window so a host that
+ * lost the response can re-send the transaction without a second review
+ * (see sig_cache.h). Zeroized on timeout and on app exit.
+ */
+typedef struct {
+    bool            valid;
+    uint16_t        ticks_left;            /* Ticker events until it is zeroized */
+    bip32_path_t    path;
+    uint64_t        chain_id;              /* Header of the transaction, so a */
+    uint64_t        nonce;                 /* re-send is recognized mid-stream */
+    uint8_t         hash[HASH_LEN];        /* BLAKE3 digest of the transaction */
+    uint8_t         signature[SIGNATURE_LEN];
+} sig_cache_t;
+
+/*
+ * Display strings (formatted by tx_display.c)
+ */
+#define TX_DISPLAY_AMOUNT_MAX_LEN    32   /* e.g., "18446744073709551615" + null */
+#define TX_DISPLAY_FEE_MAX_LEN       40   /* "Overflow" or large number */
+#define TX_DISPLAY_CHAIN_ID_MAX_LEN  24   /* Chain ID as decimal */
+#define TX_DISPLAY_U128_MAX_LEN      40   /* 2^128 - 1 is 39 digits + null */
+#define TX_DISPLAY_FINGERPRINT_BYTES 8    /* Data hash prefix shown on screen */
+#define TX_DISPLAY_FINGERPRINT_LEN   (2 * TX_DISPLAY_FINGERPRINT_BYTES + 1)
+
+/*
+ * Display strings for a transaction.
+ */
+typedef struct {
+    char amount[TX_DISPLAY_AMOUNT_MAX_LEN];
+    char recipient[ADDRESS_BASE58_MAX_LEN];
+    char fee[TX_DISPLAY_FEE_MAX_LEN];
+    char chain_id[TX_DISPLAY_CHAIN_ID_MAX_LEN];
+    char sender[ADDRESS_BASE58_MAX_LEN];
+    char nonce[TX_DISPLAY_AMOUNT_MAX_LEN];
+
+    /* Call transactions only (has_data) */
+    bool has_data;
+    char data_len[TX_DISPLAY_AMOUNT_MAX_LEN];       /* e.g. "40000 bytes" */
+    char data_hash[TX_DISPLAY_FINGERPRINT_LEN];     /* Hex prefix of BLAKE3(data) */
+
+    /* Multi-transfer only (has_recipients); recipient/amount stay empty */
+    bool has_recipients;
+    char recipient_count[TX_DISPLAY_AMOUNT_MAX_LEN];
+    char total_amount[TX_DISPLAY_U128_MAX_LEN];
+} tx_display_t;
+
+/*
+ * Display strings for one multi-transfer pair, shown while it streams in.
+ */
+typedef struct {
+    char index[TX_DISPLAY_AMOUNT_MAX_LEN];          /* e.g. "3 of 120" */
+    char recipient[ADDRESS_BASE58_MAX_LEN];
+    char amount[TX_DISPLAY_AMOUNT_MAX_LEN];
+} tx_pair_display_t;
+
+/*
+ * Display strings for a Merkle batch summary (INS_SIGN_MERKLE).
+ */
+typedef struct {
+    char count[TX_DISPLAY_AMOUNT_MAX_LEN];
+    char chain_id[TX_DISPLAY_CHAIN_ID_MAX_LEN];
+    char total_amount[TX_DISPLAY_U128_MAX_LEN];
+    char total_fee[TX_DISPLAY_U128_MAX_LEN];
+} tx_batch_display_t;
+
+/*
+ * Display strings for INS_SIGN_HASH. The header fields are supplied by the
+ * host and are not bound to the digest; the flow says so.
+ */
+typedef struct {
+    char chain_id[TX_DISPLAY_CHAIN_ID_MAX_LEN];
+    char nonce[TX_DISPLAY_AMOUNT_MAX_LEN];
+    char fee[TX_DISPLAY_AMOUNT_MAX_LEN];
+    char hash[2 * HASH_LEN + 1];            /* Full digest in hex */
+} tx_hash_display_t;
+
+/*
+ * Per-command working set (see work_area.h). One layout per command
+ * family; they overlap, since no command needs two of them. Everything
+ * here lives for one APDU and is zeroized when apdu_dispatch returns.
+ */
+typedef struct {                           /* GET_PUBLIC_KEY, GET_XPUB */
+    uint8_t pubkey[PUBKEY_LEN];
+    uint8_t chain_code[CHAIN_CODE_LEN];
+} work_key_t;
+
+typedef struct {                           /* GET_ADDRESS */
+    uint8_t pubkey[PUBKEY_LEN];
+    uint8_t address_bytes[ADDRESS_LEN];
+    char    address_str[ADDRESS_BASE58_MAX_LEN];
+} work_address_t;
+
+typedef struct {                           /* SIGN_TX, SIGN_MERKLE, SIGN_HASH */
+    uint8_t hash[HASH_LEN];                /* Digest to sign (SIGN_MERKLE: also each leaf) */
+    uint8_t signature[SIGNATURE_LEN];
+    union {                                /* Shown one after the other, never together */
+        tx_display_t       tx;
+        tx_pair_display_t  pair;
+        tx_batch_display_t batch;
+        tx_hash_display_t  digest;
+    } display;
+} work_sign_t;
+
+typedef union {
+    work_key_t      key;
+    work_address_t  address;
+    work_sign_t     sign;
+} work_area_t;
+
 /*
  * UI confirmation result
  */
@@ -170,15 +358,25 @@ typedef struct {
     /* Current signing session */
     sign_session_t  sign_session;
 
+    /* Last approved SIGN_TX signature */
+    sig_cache_t     sig_cache;
+
     /* UI state */
     ui_result_t     ui_result;
 
-    /* Temporary buffers */
-    uint8_t         pubkey[PUBKEY_LEN];
-    uint8_t         address_bytes[ADDRESS_LEN];
-    char            address_str[ADDRESS_BASE58_MAX_LEN];
-    uint8_t         hash[HASH_LEN];
-    uint8_t         signature[SIGNATURE_LEN];
+    /* Per-command working set; work_used bytes of it are dirty */
+    work_area_t     work;
+    uint16_t        work_used;
+
+#ifdef HAVE_APP_STATS
+    /* Performance counters (read and reset by INS_GET_STATS) */
+    app_stats_t     stats;
+#endif
+
+#ifdef HAVE_APP_TRACE
+    /* Event ring (read by INS_GET_TRACE) */
+    app_trace_t     trace;
+#endif
 } app_state_t;
 
 /*
@@ -192,24 +390,88 @@ extern app_state_t G_app_state;
 #define G_state G_app_state
 
 /*
- * Secure memory zeroization
+ * Secure memory zeroization (word writes where aligned)
  */
 #ifdef HAVE_BOLOS_SDK
 #define SECURE_ZEROIZE(ptr, len) explicit_bzero((ptr), (len))
 #else
 static inline void _secure_zeroize(void *ptr, size_t len) {
     volatile uint8_t *p = (volatile uint8_t *)ptr;
+    while (len > 0 && ((uintptr_t)p & (sizeof(uint32_t) - 1)) != 0) {
+        *p++ = 0;
+        len--;
+    }
+    volatile uint32_t *w = (volatile uint32_t *)p;
+    for (; len >= sizeof(uint32_t); len -= sizeof(uint32_t)) {
+        *w++ = 0;
+    }
+    p = (volatile uint8_t *)w;
     while (len--) *p++ = 0;
 }
 #define SECURE_ZEROIZE(ptr, len) _secure_zeroize((ptr), (len))
 #endif
 
 /*
- * Helper to reset signing session
+ * Debug check that a region is all zero after a partial zeroization
+ * (HAVE_ZEROIZE_CHECK: host tests and DEBUG=1 device builds). Partial
+ * wipes rely on high-water marks and struct layout; this catches either
+ * going wrong. A failure exits the app instead of throwing, since
+ * main() resets the session before any TRY handler is installed.
  */
+#ifdef HAVE_ZEROIZE_CHECK
+#ifndef HAVE_BOLOS_SDK
+#include <stdlib.h>
+#endif
+static inline void zeroize_check(const void *ptr, size_t len) {
+    const uint8_t *p = (const uint8_t *)ptr;
+    for (size_t i = 0; i < len; i++) {
+        if (p[i] != 0) {
+#ifdef HAVE_BOLOS_SDK
+            os_sched_exit(-1);
+#else
+            abort();
+#endif
+        }
+    }
+}
+#define ZEROIZE_CHECK(ptr, len) zeroize_check((ptr), (len))
+#else
+#define ZEROIZE_CHECK(ptr, len) ((void)0)
+#endif
+
+/*
+ * Helper to reset signing session. The two hashers and the Merkle stack
+ * are wiped up to their high-water marks (a short transaction touches a
+ * few hundred of the ~4.7 KB); everything around them in full.
+ */
+_Static_assert(offsetof(tx_parser_ctx_t, data_hash_ctx) + sizeof(sum_blake3_ctx_t) ==
+                   sizeof(tx_parser_ctx_t),
+               "data_hash_ctx must be the last field of tx_parser_ctx_t");
+_Static_assert(offsetof(sign_session_t, parser) ==
+                   offsetof(sign_session_t, tx_hash_ctx) + sizeof(sum_blake3_ctx_t),
+               "parser must directly follow tx_hash_ctx");
+_Static_assert(offsetof(sign_session_t, total_received) ==
+                   offsetof(sign_session_t, parser) + sizeof(tx_parser_ctx_t),
+               "total_received must directly follow parser");
+_Static_assert(offsetof(merkle_batch_t, tree) == 0, "tree must start merkle_batch_t");
+
 static inline void reset_sign_session(void) {
-    SECURE_ZEROIZE(&G_state.sign_session, sizeof(sign_session_t));
-    G_state.sign_session.initialized = false;
+    sign_session_t *session = &G_state.sign_session;
+    uint8_t *bytes = (uint8_t *)session;
+    size_t tree_end = offsetof(sign_session_t, batch) + sizeof(merkle_acc_t);
+
+    sum_blake3_zeroize_used(&session->tx_hash_ctx);
+    sum_blake3_zeroize_used(&session->parser.data_hash_ctx);
+    merkle_acc_zeroize(&session->batch.tree);
+
+    /* tx_hash_ctx is followed by parser, data_hash_ctx ends it, tree starts batch */
+    SECURE_ZEROIZE(bytes, offsetof(sign_session_t, tx_hash_ctx));
+    SECURE_ZEROIZE(&session->parser, offsetof(tx_parser_ctx_t, data_hash_ctx));
+    SECURE_ZEROIZE(bytes + offsetof(sign_session_t, total_received),
+                   offsetof(sign_session_t, batch) - offsetof(sign_session_t, total_received));
+    SECURE_ZEROIZE(bytes + tree_end, sizeof(sign_session_t) - tree_end);
+
+    ZEROIZE_CHECK(session, sizeof(*session));
 }
 
 #endif /* GLOBALS_H */
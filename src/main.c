@@ -4,6 +4,9 @@
 
 #include "globals.h"
 #include "apdu_handlers.h"
+#include "settings.h"
+#include "sig_cache.h"
+#include "work_area.h"
 #include <string.h>
 
 #ifdef HAVE_BOLOS_SDK
@@ -40,10 +43,39 @@ UX_STEP_NOCB(
         APPVERSION,
     });
 
+/*
+ * Settings (stored in NVM):
+ *   "Hash signing" toggles INS_SIGN_HASH
+ *   "Payouts" chooses per-recipient review or total-only for multi-transfers
+ */
+static char g_hash_signing_label[10];
+static char g_payouts_label[16];
+static void ui_toggle_hash_signing(void);
+static void ui_toggle_payouts(void);
+static void ui_quit(void);
+
+UX_STEP_CB(
+    ux_idle_step_hash_signing,
+    bn,
+    ui_toggle_hash_signing(),
+    {
+        "Hash signing",
+        g_hash_signing_label,
+    });
+
+UX_STEP_CB(
+    ux_idle_step_payouts,
+    bn,
+    ui_toggle_payouts(),
+    {
+        "Payouts",
+        g_payouts_label,
+    });
+
 UX_STEP_CB(
     ux_idle_step_quit,
     pb,
-    os_sched_exit(-1),
+    ui_quit(),
     {
         &C_icon_dashboard_x,
         "Quit",
@@ -52,6 +84,8 @@ UX_STEP_CB(
 UX_FLOW(ux_idle_flow,
     &ux_idle_step_ready,
     &ux_idle_step_version,
+    &ux_idle_step_hash_signing,
+    &ux_idle_step_payouts,
     &ux_idle_step_quit,
     FLOW_LOOP);
 
@@ -60,14 +94,43 @@ void io_seproxyhal_display(const bagl_element_t *element) {
     io_seproxyhal_display_default(element);
 }
 
+static void ui_update_settings_labels(void) {
+    strlcpy(g_hash_signing_label, settings_hash_signing_enabled() ? "Enabled" : "Disabled",
+            sizeof(g_hash_signing_label));
+    strlcpy(g_payouts_label, settings_multi_total_only() ? "Total only" : "Each recipient",
+            sizeof(g_payouts_label));
+}
+
 /* Return to idle menu */
 static void ui_idle(void) {
     if (G_ux.stack_count == 0) {
         ux_stack_push();
     }
+    ui_update_settings_labels();
     ux_flow_init(0, ux_idle_flow, NULL);
 }
 
+/* Redraw the idle menu on a settings step after a toggle */
+static void ui_idle_at(const ux_flow_step_t *const step) {
+    ui_update_settings_labels();
+    ux_flow_init(0, ux_idle_flow, step);
+}
+
+static void ui_toggle_hash_signing(void) {
+    settings_set_hash_signing(!settings_hash_signing_enabled());
+    ui_idle_at(&ux_idle_step_hash_signing);
+}
+
+static void ui_toggle_payouts(void) {
+    settings_set_multi_total_only(!settings_multi_total_only());
+    ui_idle_at(&ux_idle_step_payouts);
+}
+
+static void ui_quit(void) {
+    sig_cache_clear();
+    os_sched_exit(-1);
+}
+
 /* General status callback */
 uint8_t io_event(uint8_t channel) {
     (void)channel;
@@ -91,6 +154,13 @@ uint8_t io_event(uint8_t channel) {
             break;
 
         case SEPROXYHAL_TAG_TICKER_EVENT:
+#ifdef HAVE_APP_STATS
+            G_app_stats_ticks++;
+#endif
+#ifdef HAVE_APP_TRACE
+            G_app_trace_ticks++;
+#endif
+            sig_cache_tick();
             UX_TICKER_EVENT(G_io_seproxyhal_spi_buffer, {});
             break;
 
@@ -112,9 +182,6 @@ static void app_main(void) {
     volatile unsigned int tx = 0;
     volatile unsigned int flags = 0;
 
-    /* Reset signing session on startup */
-    reset_sign_session();
-
     /* Exchange APDUs */
     for (;;) {
         volatile unsigned short sw = 0;
@@ -177,6 +244,9 @@ static void app_main(void) {
                 }
             }
             FINALLY {
+                /* apdu_dispatch clears it on return, but not when a handler threw */
+                work_area_clear();
+
                 /* Append status word */
                 G_io_apdu_buffer[tx++] = sw >> 8;
                 G_io_apdu_buffer[tx++] = sw & 0xFF;
@@ -193,6 +263,13 @@ __attribute__((section(".boot"))) int main(void) {
     /* Ensure exception will work as planned */
     os_boot();
 
+    /*
+     * Reset the signing session once per launch, not per I/O loop: a
+     * transport reset (EXCEPTION_IO_RESET) keeps the session so the host can
+     * continue it after INS_RESUME.
+     */
+    reset_sign_session();
+
     for (;;) {
         UX_INIT();
 
@@ -208,6 +285,7 @@ __attribute__((section(".boot"))) int main(void) {
                 USB_power(0);
                 USB_power(1);
 
+                settings_init();
                 ui_idle();
 
 #ifdef HAVE_BLE
@@ -218,7 +296,7 @@ __attribute__((section(".boot"))) int main(void) {
                 app_main();
             }
             CATCH(EXCEPTION_IO_RESET) {
-                /* Reset IO and UX */
+                /* Reset IO and UX; G_state.sign_session is kept */
                 continue;
             }
             CATCH_ALL {
@@ -231,6 +309,7 @@ __attribute__((section(".boot"))) int main(void) {
         END_TRY;
     }
 
+    sig_cache_clear();
     return 0;
 }
 
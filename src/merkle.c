@@ -0,0 +1,100 @@
+/*
+ * SUM Chain Ledger App - Merkle Batch Accumulator Implementation
+ */
+
+#include "merkle.h"
+#include "globals.h"
+#include <string.h>
+
+void merkle_leaf_hash(sum_blake3_ctx_t *scratch, const uint8_t tx_digest[MERKLE_HASH_LEN],
+                      uint8_t out[MERKLE_HASH_LEN]) {
+    const uint8_t prefix = MERKLE_LEAF_PREFIX;
+
+    sum_blake3_init(scratch);
+    sum_blake3_update(scratch, &prefix, 1);
+    sum_blake3_update(scratch, tx_digest, MERKLE_HASH_LEN);
+    sum_blake3_finalize32(scratch, out);
+}
+
+void merkle_node_hash(sum_blake3_ctx_t *scratch, const uint8_t left[MERKLE_HASH_LEN],
+                      const uint8_t right[MERKLE_HASH_LEN],
+                      uint8_t out[MERKLE_HASH_LEN]) {
+    const uint8_t prefix = MERKLE_NODE_PREFIX;
+
+    sum_blake3_init(scratch);
+    sum_blake3_update(scratch, &prefix, 1);
+    sum_blake3_update(scratch, left, MERKLE_HASH_LEN);
+    sum_blake3_update(scratch, right, MERKLE_HASH_LEN);
+    sum_blake3_finalize32(scratch, out);
+}
+
+void merkle_signing_hash(sum_blake3_ctx_t *scratch, const uint8_t root[MERKLE_HASH_LEN],
+                         uint32_t leaf_count, uint8_t out[MERKLE_HASH_LEN]) {
+    uint8_t header[5];
+
+    header[0] = MERKLE_ROOT_PREFIX;
+    header[1] = (uint8_t)(leaf_count);
+    header[2] = (uint8_t)(leaf_count >> 8);
+    header[3] = (uint8_t)(leaf_count >> 16);
+    header[4] = (uint8_t)(leaf_count >> 24);
+
+    sum_blake3_init(scratch);
+    sum_blake3_update(scratch, header, sizeof(header));
+    sum_blake3_update(scratch, root, MERKLE_HASH_LEN);
+    sum_blake3_finalize32(scratch, out);
+}
+
+void merkle_acc_init(merkle_acc_t *acc) {
+    if (acc == NULL) {
+        return;
+    }
+    memset(acc, 0, sizeof(*acc));
+}
+
+void merkle_acc_zeroize(merkle_acc_t *acc) {
+    if (acc == NULL) {
+        return;
+    }
+
+    uint8_t *bytes = (uint8_t *)acc;
+    size_t used = acc->stack_len <= MERKLE_MAX_DEPTH + 1 ? acc->stack_len : MERKLE_MAX_DEPTH + 1;
+    size_t stack_end = offsetof(merkle_acc_t, stack) + sizeof(acc->stack);
+
+    SECURE_ZEROIZE(bytes, offsetof(merkle_acc_t, stack) + used * MERKLE_HASH_LEN);
+    SECURE_ZEROIZE(bytes + stack_end, sizeof(*acc) - stack_end);
+}
+
+bool merkle_acc_push(merkle_acc_t *acc, sum_blake3_ctx_t *scratch,
+                     const uint8_t tx_digest[MERKLE_HASH_LEN]) {
+    if (acc == NULL || scratch == NULL || tx_digest == NULL || acc->count >= MERKLE_MAX_LEAVES) {
+        return false;
+    }
+
+    merkle_leaf_hash(scratch, tx_digest, acc->stack[acc->stack_len]);
+    acc->stack_len++;
+    acc->count++;
+
+    /* Each trailing zero bit of the new count closes one subtree level */
+    for (uint32_t n = acc->count; (n & 1) == 0; n >>= 1) {
+        acc->stack_len--;
+        merkle_node_hash(scratch, acc->stack[acc->stack_len - 1], acc->stack[acc->stack_len],
+                         acc->stack[acc->stack_len - 1]);
+        memset(acc->stack[acc->stack_len], 0, MERKLE_HASH_LEN);
+    }
+
+    return true;
+}
+
+bool merkle_acc_root(const merkle_acc_t *acc, sum_blake3_ctx_t *scratch,
+                     uint8_t root[MERKLE_HASH_LEN]) {
+    if (acc == NULL || scratch == NULL || root == NULL || acc->stack_len == 0) {
+        return false;
+    }
+
+    memcpy(root, acc->stack[acc->stack_len - 1], MERKLE_HASH_LEN);
+    for (size_t i = acc->stack_len - 1; i > 0; i--) {
+        merkle_node_hash(scratch, acc->stack[i - 1], root, root);
+    }
+
+    return true;
+}
@@ -0,0 +1,129 @@
+/*
+ * SUM Chain Ledger App - Merkle Batch Accumulator
+ * Incremental BLAKE3 Merkle tree over transaction digests, used by
+ * INS_SIGN_MERKLE. Only the roots of complete subtrees are kept
+ * (one per set bit of the leaf count), so a batch of n transactions
+ * needs O(log n) chaining values. Shared with the host proof library.
+ *
+ * Tree shape follows RFC 6962 section 2.1: for n > 1 leaves the left
+ * subtree holds the largest power of two strictly less than n.
+ *
+ *   leaf   = BLAKE3(0x00 || sum_blake3(tx))
+ *   node   = BLAKE3(0x01 || left || right)
+ *   signed = BLAKE3(0x02 || leaf_count:u32 LE || root)
+ *
+ * The prefixes keep leaves, inner nodes and the signed message apart. The
+ * signed message starts with 0x02, never a valid transaction version, so a
+ * batch signature can never be replayed as a single-transaction signature.
+ *
+ * Every hashing function takes a caller-provided BLAKE3 context as scratch,
+ * so no ~2 KB hasher is placed on the stack. On the device this is the
+ * session's per-transaction context, idle between transactions.
+ */
+
+#ifndef MERKLE_H
+#define MERKLE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "crypto/sum_blake3.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MERKLE_HASH_LEN       32
+#define MERKLE_MAX_DEPTH      16                           /* Tree height limit */
+#define MERKLE_MAX_LEAVES     (1UL << MERKLE_MAX_DEPTH)    /* 65536 transactions */
+
+#define MERKLE_LEAF_PREFIX    0x00
+#define MERKLE_NODE_PREFIX    0x01
+#define MERKLE_ROOT_PREFIX    0x02
+
+/*
+ * Incremental tree state.
+ * stack[0] is the root of the leftmost (largest) complete subtree.
+ */
+typedef struct {
+    uint32_t count;                                        /* Leaves pushed */
+    uint8_t  stack_len;                                    /* Entries in stack */
+    uint8_t  stack[MERKLE_MAX_DEPTH + 1][MERKLE_HASH_LEN];
+} merkle_acc_t;
+
+/*
+ * Compute a leaf hash from a transaction digest.
+ *
+ * @param scratch   Hash context (overwritten).
+ * @param tx_digest sum_blake3 hash of the serialized transaction.
+ * @param out       Output leaf hash.
+ */
+void merkle_leaf_hash(sum_blake3_ctx_t *scratch, const uint8_t tx_digest[MERKLE_HASH_LEN],
+                      uint8_t out[MERKLE_HASH_LEN]);
+
+/*
+ * Compute an inner node hash. out may alias left or right.
+ *
+ * @param scratch Hash context (overwritten).
+ * @param left  Left child hash.
+ * @param right Right child hash.
+ * @param out   Output node hash.
+ */
+void merkle_node_hash(sum_blake3_ctx_t *scratch, const uint8_t left[MERKLE_HASH_LEN],
+                      const uint8_t right[MERKLE_HASH_LEN],
+                      uint8_t out[MERKLE_HASH_LEN]);
+
+/*
+ * Compute the message signed for a batch.
+ *
+ * @param scratch    Hash context (overwritten).
+ * @param root       Tree root.
+ * @param leaf_count Number of transactions in the batch.
+ * @param out        Output 32-byte message.
+ */
+void merkle_signing_hash(sum_blake3_ctx_t *scratch, const uint8_t root[MERKLE_HASH_LEN],
+                         uint32_t leaf_count, uint8_t out[MERKLE_HASH_LEN]);
+
+/*
+ * Reset the accumulator to an empty tree.
+ *
+ * @param acc Accumulator.
+ */
+void merkle_acc_init(merkle_acc_t *acc);
+
+/*
+ * Zeroize the accumulator. Entries at and above stack_len are kept zero by
+ * merkle_acc_push, so only the used ones are written.
+ *
+ * @param acc Accumulator.
+ */
+void merkle_acc_zeroize(merkle_acc_t *acc);
+
+/*
+ * Append the next transaction and merge completed subtrees.
+ *
+ * @param acc       Accumulator.
+ * @param scratch   Hash context (overwritten).
+ * @param tx_digest sum_blake3 hash of the transaction.
+ * @return false if the tree already holds MERKLE_MAX_LEAVES leaves.
+ */
+bool merkle_acc_push(merkle_acc_t *acc, sum_blake3_ctx_t *scratch,
+                     const uint8_t tx_digest[MERKLE_HASH_LEN]);
+
+/*
+ * Fold the subtree roots (right to left) into the tree root.
+ * The accumulator is not modified.
+ *
+ * @param acc     Accumulator.
+ * @param scratch Hash context (overwritten).
+ * @param root    Output root.
+ * @return false if the tree is empty.
+ */
+bool merkle_acc_root(const merkle_acc_t *acc, sum_blake3_ctx_t *scratch,
+                     uint8_t root[MERKLE_HASH_LEN]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MERKLE_H */
@@ -0,0 +1,73 @@
+/*
+ * SUM Chain Ledger App - User Settings Implementation
+ */
+
+#include "settings.h"
+
+#ifdef HAVE_BOLOS_SDK
+
+#include "os.h"
+
+typedef struct {
+    uint8_t initialized;                   /* 1 once defaults were written */
+    uint8_t hash_signing;                  /* INS_SIGN_HASH allowed */
+    uint8_t multi_total_only;              /* Skip per-pair multi-transfer review */
+} settings_storage_t;
+
+/* Lives in flash; must be accessed through PIC and written with nvm_write */
+const settings_storage_t N_settings_real;
+#define N_settings (*(volatile settings_storage_t *)PIC(&N_settings_real))
+
+void settings_init(void) {
+    if (N_settings.initialized != 1) {
+        settings_storage_t storage = { .initialized = 1, .hash_signing = 0, .multi_total_only = 0 };
+        nvm_write((void *)&N_settings, &storage, sizeof(storage));
+    }
+}
+
+bool settings_hash_signing_enabled(void) {
+    return N_settings.hash_signing == 1;
+}
+
+void settings_set_hash_signing(bool enabled) {
+    uint8_t value = enabled ? 1 : 0;
+    nvm_write((void *)&N_settings.hash_signing, &value, sizeof(value));
+}
+
+bool settings_multi_total_only(void) {
+    return N_settings.multi_total_only == 1;
+}
+
+void settings_set_multi_total_only(bool total_only) {
+    uint8_t value = total_only ? 1 : 0;
+    nvm_write((void *)&N_settings.multi_total_only, &value, sizeof(value));
+}
+
+#else
+/* Host-side: settings live in RAM */
+
+static bool g_hash_signing;
+static bool g_multi_total_only;
+
+void settings_init(void) {
+    g_hash_signing = false;
+    g_multi_total_only = false;
+}
+
+bool settings_hash_signing_enabled(void) {
+    return g_hash_signing;
+}
+
+void settings_set_hash_signing(bool enabled) {
+    g_hash_signing = enabled;
+}
+
+bool settings_multi_total_only(void) {
+    return g_multi_total_only;
+}
+
+void settings_set_multi_total_only(bool total_only) {
+    g_multi_total_only = total_only;
+}
+
+#endif /* HAVE_BOLOS_SDK */
@@ -0,0 +1,52 @@
+/*
+ * SUM Chain Ledger App - User Settings
+ * Persistent on-device settings (NVM), changed only from the idle menu.
+ */
+
+#ifndef SETTINGS_H
+#define SETTINGS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Write defaults to NVM on first launch (every setting off).
+ * Call once at startup, before any APDU is handled.
+ */
+void settings_init(void);
+
+/*
+ * @return true if INS_SIGN_HASH (blind signing of a digest) is allowed.
+ */
+bool settings_hash_signing_enabled(void);
+
+/*
+ * Enable or disable INS_SIGN_HASH. Only the idle menu (and host tests)
+ * call this; no APDU can change a setting.
+ *
+ * @param enabled New value.
+ */
+void settings_set_hash_signing(bool enabled);
+
+/*
+ * @return true if multi-transfers are approved by recipient count and total
+ *         only; false (default) to review every (recipient, amount) pair.
+ */
+bool settings_multi_total_only(void);
+
+/*
+ * Choose how multi-transfers are reviewed (idle menu and host tests only).
+ *
+ * @param total_only New value.
+ */
+void settings_set_multi_total_only(bool total_only);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SETTINGS_H */
@@ -0,0 +1,57 @@
+/*
+ * SUM Chain Ledger App - Last-Signature Cache Implementation
+ */
+
+#include "sig_cache.h"
+#include <string.h>
+
+static bool same_path(const sig_cache_t *cache, const bip32_path_t *path) {
+    return cache->valid && path->length == cache->path.length && path->scheme == cache->path.scheme &&
+           memcmp(path->path, cache->path.path, path->length * sizeof(path->path[0])) == 0;
+}
+
+void sig_cache_store(const bip32_path_t *path, const tx_parsed_t *parsed,
+                     const uint8_t hash32[32], const uint8_t sig64[64]) {
+    sig_cache_t *cache = &G_state.sig_cache;
+
+    memcpy(&cache->path, path, sizeof(cache->path));
+    cache->chain_id = parsed->chain_id;
+    cache->nonce = parsed->nonce;
+    memcpy(cache->hash, hash32, sizeof(cache->hash));
+    memcpy(cache->signature, sig64, sizeof(cache->signature));
+    cache->ticks_left = SIG_CACHE_WINDOW_TICKS;
+    cache->valid = true;
+}
+
+bool sig_cache_lookup(const bip32_path_t *path, const uint8_t hash32[32], uint8_t sig64[64]) {
+    const sig_cache_t *cache = &G_state.sig_cache;
+
+    if (!same_path(cache, path) || memcmp(hash32, cache->hash, sizeof(cache->hash)) != 0) {
+        return false;
+    }
+
+    memcpy(sig64, cache->signature, sizeof(cache->signature));
+    return true;
+}
+
+bool sig_cache_expect(const bip32_path_t *path, const tx_parsed_t *parsed) {
+    const sig_cache_t *cache = &G_state.sig_cache;
+
+    return same_path(cache, path) && parsed->chain_id == cache->chain_id &&
+           parsed->nonce == cache->nonce;
+}
+
+void sig_cache_tick(void) {
+    sig_cache_t *cache = &G_state.sig_cache;
+
+    if (!cache->valid) {
+        return;
+    }
+    if (--cache->ticks_left == 0) {
+        sig_cache_clear();
+    }
+}
+
+void sig_cache_clear(void) {
+    SECURE_ZEROIZE(&G_state.sig_cache, sizeof(G_state.sig_cache));
+}
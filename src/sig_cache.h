@@ -0,0 +1,83 @@
+/*
+ * SUM Chain Ledger App - Last-Signature Cache
+ *
+ * When the response to the final SIGN_TX APDU is lost, the host re-sends
+ * the whole transaction. If it finalizes to the digest that was approved
+ * last, for the same path, within SIG_CACHE_WINDOW_TICKS, the cached
+ * signature is returned without a second review. Ed25519 is deterministic,
+ * so this returns exactly the signature the user already approved.
+ *
+ * Multi-transfer pairs are reviewed while the transaction streams in, long
+ * before the digest is known. A multi-transfer whose chain ID and nonce
+ * match the entry (sig_cache_expect) skips pair review and can then only
+ * be signed from the cache: if it finalizes to another digest the session
+ * fails with SW_SESSION_ERROR and the entry is dropped, so sending it again
+ * gets the full review.
+ */
+
+#ifndef SIG_CACHE_H
+#define SIG_CACHE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "globals.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Lifetime of an entry in SEPROXYHAL ticker events (100 ms each): 30 s.
+ * The ticker only advances while the app waits for I/O, which is when a
+ * retry is pending.
+ */
+#define SIG_CACHE_WINDOW_TICKS    300
+
+/*
+ * Remember an approved signature, replacing any previous entry and
+ * restarting the window.
+ *
+ * @param path       Signing path.
+ * @param parsed     Parsed transaction (chain ID and nonce are kept).
+ * @param hash32     Transaction digest.
+ * @param sig64      Signature over hash32.
+ */
+void sig_cache_store(const bip32_path_t *path, const tx_parsed_t *parsed,
+                     const uint8_t hash32[32], const uint8_t sig64[64]);
+
+/*
+ * Check whether a transaction still streaming in looks like a re-send of
+ * the cached one (same path, chain ID and nonce).
+ *
+ * @param path       Signing path.
+ * @param parsed     Parsed header of the transaction.
+ * @return true if the entry is live and matches.
+ */
+bool sig_cache_expect(const bip32_path_t *path, const tx_parsed_t *parsed);
+
+/*
+ * Look up the signature of a digest. Hits do not extend the window.
+ *
+ * @param path       Signing path (length, scheme and components must match).
+ * @param hash32     Transaction digest.
+ * @param sig64      Output: cached signature (only written on a hit).
+ * @return true on a hit.
+ */
+bool sig_cache_lookup(const bip32_path_t *path, const uint8_t hash32[32], uint8_t sig64[64]);
+
+/*
+ * Advance the window by one ticker event; zeroizes the entry when it ends.
+ * Called from io_event on SEPROXYHAL_TAG_TICKER_EVENT.
+ */
+void sig_cache_tick(void);
+
+/*
+ * Zeroize the entry (timeout, app exit).
+ */
+void sig_cache_clear(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SIG_CACHE_H */
@@ -46,30 +46,14 @@ size_t format_u64_decimal(uint64_t value, char *out, size_t out_len) {
     return pos;
 }
 
-/*
- * Format a 128-bit fee (low, high) as decimal string.
- * If overflow flag is set, return "Overflow".
- */
-static size_t format_fee(uint64_t fee_low, uint64_t fee_high, bool overflow,
-                         char *out, size_t out_len) {
+size_t format_u128_decimal(uint64_t lo, uint64_t hi, char *out, size_t out_len) {
     if (out == NULL || out_len == 0) {
         return 0;
     }
 
-    if (overflow) {
-        const char *msg = "Overflow";
-        size_t len = strlen(msg);
-        if (len + 1 > out_len) {
-            out[0] = '\0';
-            return 0;
-        }
-        memcpy(out, msg, len + 1);
-        return len;
-    }
-
     /* If high part is zero, just format the low part */
-    if (fee_high == 0) {
-        return format_u64_decimal(fee_low, out, out_len);
+    if (hi == 0) {
+        return format_u64_decimal(lo, out, out_len);
     }
 
     /*
@@ -77,8 +61,6 @@ static size_t format_fee(uint64_t fee_low, uint64_t fee_high, bool overflow,
      * We need to handle up to 39 digits (2^128 - 1 ≈ 3.4e38).
      * Use repeated division by 10 on 128-bit value.
      */
-    uint64_t lo = fee_low;
-    uint64_t hi = fee_high;
     char buf[48];
     size_t pos = 0;
 
@@ -87,24 +69,25 @@ static size_t format_fee(uint64_t fee_low, uint64_t fee_high, bool overflow,
         uint64_t hi_div = hi / 10;
         uint64_t hi_rem = hi % 10;
 
-        /* Bring remainder into low part: (hi_rem * 2^64 + lo) / 10 */
-        /* hi_rem * 2^64 = hi_rem << 64, but we need to handle this carefully */
-        /* lo_new = ((hi_rem * 2^64) + lo) / 10 */
-        /* = (hi_rem * 0x1999999999999999 + hi_rem * 6 + lo) / 10  (since 2^64 / 10 = 0x1999...9 * 10 + 6) */
-
-        /* Simpler approach: use 128-bit arithmetic */
-        /* (hi_rem << 64 | lo) / 10 */
-        /* Since hi_rem < 10, (hi_rem << 64) < 2^68, which fits in 128 bits */
-
-        /* We'll compute: quotient = (hi_rem * (2^64 / 10)) + ((hi_rem * (2^64 % 10) + lo) / 10) */
-        /* 2^64 = 1844674407370955161 * 10 + 6 */
+        /*
+         * (hi_rem * 2^64 + lo) / 10 with hi_rem < 10:
+         * 2^64 = 1844674407370955161 * 10 + 6, so the quotient is
+         * hi_rem * 1844674407370955161 + (hi_rem * 6 + lo) / 10.
+         */
         const uint64_t q_factor = 1844674407370955161ULL;
         const uint64_t r_factor = 6;
 
         uint64_t lo_contrib = hi_rem * r_factor + lo;
+        uint64_t carry = (lo_contrib < lo) ? 1 : 0;   /* hi_rem * 6 + lo wrapped */
         uint64_t lo_div = lo_contrib / 10;
         uint64_t lo_rem = lo_contrib % 10;
 
+        /* A wrapped sum lost 2^64 = 1844674407370955161 * 10 + 6 */
+        if (carry) {
+            lo_div += q_factor + (lo_rem + r_factor) / 10;
+            lo_rem = (lo_rem + r_factor) % 10;
+        }
+
         uint64_t lo_new = hi_rem * q_factor + lo_div;
 
         buf[pos++] = '0' + (char)lo_rem;
@@ -128,6 +111,30 @@ static size_t format_fee(uint64_t fee_low, uint64_t fee_high, bool overflow,
     return pos;
 }
 
+/*
+ * Format a 128-bit fee (low, high) as decimal string.
+ * If overflow flag is set, return "Overflow".
+ */
+static size_t format_fee(uint64_t fee_low, uint64_t fee_high, bool overflow,
+                         char *out, size_t out_len) {
+    if (out == NULL || out_len == 0) {
+        return 0;
+    }
+
+    if (overflow) {
+        const char *msg = "Overflow";
+        size_t len = strlen(msg);
+        if (len + 1 > out_len) {
+            out[0] = '\0';
+            return 0;
+        }
+        memcpy(out, msg, len + 1);
+        return len;
+    }
+
+    return format_u128_decimal(fee_low, fee_high, out, out_len);
+}
+
 size_t format_address(const uint8_t addr20[20], char *out, size_t out_len) {
     return sumchain_address_to_base58(addr20, out, out_len);
 }
@@ -139,14 +146,25 @@ bool tx_display_format(const tx_parsed_t *parsed, tx_display_t *display) {
 
     memset(display, 0, sizeof(tx_display_t));
 
-    /* Format amount */
-    if (format_u64_decimal(parsed->amount, display->amount, sizeof(display->amount)) == 0) {
-        return false;
-    }
+    if (parsed->tx_type == TX_TYPE_MULTI_TRANSFER) {
+        /* Format recipient count and total; pairs were shown as they arrived */
+        if (format_u64_decimal(parsed->recipient_count, display->recipient_count,
+                               sizeof(display->recipient_count)) == 0 ||
+            format_u128_decimal(parsed->total_amount_lo, parsed->total_amount_hi,
+                                display->total_amount, sizeof(display->total_amount)) == 0) {
+            return false;
+        }
+        display->has_recipients = true;
+    } else {
+        /* Format amount */
+        if (format_u64_decimal(parsed->amount, display->amount, sizeof(display->amount)) == 0) {
+            return false;
+        }
 
-    /* Format recipient */
-    if (format_address(parsed->recipient, display->recipient, sizeof(display->recipient)) == 0) {
-        return false;
+        /* Format recipient */
+        if (format_address(parsed->recipient, display->recipient, sizeof(display->recipient)) == 0) {
+            return false;
+        }
     }
 
     /* Format fee */
@@ -170,6 +188,107 @@ bool tx_display_format(const tx_parsed_t *parsed, tx_display_t *display) {
         return false;
     }
 
+    /* Format data length and fingerprint */
+    if (parsed->tx_type == TX_TYPE_CALL) {
+        static const char suffix[] = " bytes";
+        static const char hex[] = "0123456789abcdef";
+
+        size_t len = format_u64_decimal(parsed->data_len, display->data_len,
+                                        sizeof(display->data_len));
+        if (len == 0 || len + sizeof(suffix) > sizeof(display->data_len)) {
+            return false;
+        }
+        memcpy(display->data_len + len, suffix, sizeof(suffix));
+
+        for (size_t i = 0; i < TX_DISPLAY_FINGERPRINT_BYTES; i++) {
+            display->data_hash[2 * i] = hex[parsed->data_hash[i] >> 4];
+            display->data_hash[2 * i + 1] = hex[parsed->data_hash[i] & 0x0F];
+        }
+        display->data_hash[2 * TX_DISPLAY_FINGERPRINT_BYTES] = '\0';
+        display->has_data = true;
+    }
+
+    return true;
+}
+
+bool tx_pair_display_format(const tx_parsed_t *parsed, tx_pair_display_t *display) {
+    static const char sep[] = " of ";
+
+    if (parsed == NULL || display == NULL || parsed->recipient_index == 0) {
+        return false;
+    }
+
+    memset(display, 0, sizeof(tx_pair_display_t));
+
+    size_t len = format_u64_decimal(parsed->recipient_index, display->index, sizeof(display->index));
+    if (len == 0 || len + sizeof(sep) > sizeof(display->index)) {
+        return false;
+    }
+    memcpy(display->index + len, sep, sizeof(sep));
+    len += sizeof(sep) - 1;
+    if (format_u64_decimal(parsed->recipient_count, display->index + len,
+                           sizeof(display->index) - len) == 0) {
+        return false;
+    }
+
+    if (format_address(parsed->recipient, display->recipient, sizeof(display->recipient)) == 0 ||
+        format_u64_decimal(parsed->amount, display->amount, sizeof(display->amount)) == 0) {
+        return false;
+    }
+
+    return true;
+}
+
+bool tx_batch_display_format(const merkle_batch_t *batch, tx_batch_display_t *display) {
+    if (batch == NULL || display == NULL || batch->tree.count == 0) {
+        return false;
+    }
+
+    memset(display, 0, sizeof(tx_batch_display_t));
+
+    if (format_u64_decimal(batch->tree.count, display->count, sizeof(display->count)) == 0) {
+        return false;
+    }
+
+    if (format_u64_decimal(batch->chain_id, display->chain_id, sizeof(display->chain_id)) == 0) {
+        return false;
+    }
+
+    if (format_u128_decimal(batch->amount_lo, batch->amount_hi,
+                            display->total_amount, sizeof(display->total_amount)) == 0) {
+        return false;
+    }
+
+    if (format_u128_decimal(batch->fee_lo, batch->fee_hi,
+                            display->total_fee, sizeof(display->total_fee)) == 0) {
+        return false;
+    }
+
+    return true;
+}
+
+bool tx_hash_display_format(uint64_t chain_id, uint64_t nonce, uint64_t fee,
+                            const uint8_t hash[HASH_LEN], tx_hash_display_t *display) {
+    static const char hex[] = "0123456789abcdef";
+
+    if (hash == NULL || display == NULL) {
+        return false;
+    }
+
+    memset(display, 0, sizeof(tx_hash_display_t));
+
+    if (format_u64_decimal(chain_id, display->chain_id, sizeof(display->chain_id)) == 0 ||
+        format_u64_decimal(nonce, display->nonce, sizeof(display->nonce)) == 0 ||
+        format_u64_decimal(fee, display->fee, sizeof(display->fee)) == 0) {
+        return false;
+    }
+
+    for (size_t i = 0; i < HASH_LEN; i++) {
+        display->hash[2 * i] = hex[hash[i] >> 4];
+        display->hash[2 * i + 1] = hex[hash[i] & 0x0F];
+    }
+    display->hash[2 * HASH_LEN] = '\0';
+
     return true;
 }
 
@@ -191,6 +310,13 @@ static tx_display_t *g_display_ptr;
 /* Forward declarations */
 static void display_next_step(void);
 
+/* Approve/reject callback: record the decision and leave the flow */
+static void ui_decide(ui_result_t result) {
+    G_state.ui_result = result;
+    APP_TRACE(APP_TRACE_UI_DECISION, result, 0);
+    ux_flow_over();
+}
+
 /* UX step definitions */
 UX_STEP_NOCB(
     ux_tx_review_step,
@@ -233,10 +359,42 @@ UX_STEP_NOCB(
         .text = g_display_ptr->fee,
     });
 
+UX_STEP_NOCB(
+    ux_tx_data_len_step,
+    bnnn_paging,
+    {
+        .title = "Data",
+        .text = g_display_ptr->data_len,
+    });
+
+UX_STEP_NOCB(
+    ux_tx_data_hash_step,
+    bnnn_paging,
+    {
+        .title = "Data Hash",
+        .text = g_display_ptr->data_hash,
+    });
+
+UX_STEP_NOCB(
+    ux_tx_recipient_count_step,
+    bnnn_paging,
+    {
+        .title = "Recipients",
+        .text = g_display_ptr->recipient_count,
+    });
+
+UX_STEP_NOCB(
+    ux_tx_total_amount_step,
+    bnnn_paging,
+    {
+        .title = "Total Amount",
+        .text = g_display_ptr->total_amount,
+    });
+
 UX_STEP_CB(
     ux_tx_approve_step,
     pb,
-    G_state.ui_result = UI_RESULT_APPROVED; ux_flow_over(),
+    ui_decide(UI_RESULT_APPROVED),
     {
         &C_icon_validate_14,
         "Approve",
@@ -245,7 +403,7 @@ UX_STEP_CB(
 UX_STEP_CB(
     ux_tx_reject_step,
     pb,
-    G_state.ui_result = UI_RESULT_REJECTED; ux_flow_over(),
+    ui_decide(UI_RESULT_REJECTED),
     {
         &C_icon_crossmark,
         "Reject",
@@ -260,6 +418,26 @@ UX_FLOW(ux_tx_flow,
     &ux_tx_approve_step,
     &ux_tx_reject_step);
 
+UX_FLOW(ux_call_flow,
+    &ux_tx_review_step,
+    &ux_tx_chain_step,
+    &ux_tx_recipient_step,
+    &ux_tx_amount_step,
+    &ux_tx_data_len_step,
+    &ux_tx_data_hash_step,
+    &ux_tx_fee_step,
+    &ux_tx_approve_step,
+    &ux_tx_reject_step);
+
+UX_FLOW(ux_multi_flow,
+    &ux_tx_review_step,
+    &ux_tx_chain_step,
+    &ux_tx_recipient_count_step,
+    &ux_tx_total_amount_step,
+    &ux_tx_fee_step,
+    &ux_tx_approve_step,
+    &ux_tx_reject_step);
+
 ui_result_t tx_display_show_approval(const tx_display_t *display) {
     if (display == NULL) {
         return UI_RESULT_REJECTED;
@@ -275,7 +453,12 @@ ui_result_t tx_display_show_approval(const tx_display_t *display) {
     }
 
     /* Start UX flow */
-    ux_flow_init(0, ux_tx_flow, NULL);
+    APP_TRACE(APP_TRACE_UI_SHOW, APP_TRACE_UI_TX, 0);
+    if (display->has_recipients) {
+        ux_flow_init(0, ux_multi_flow, NULL);
+    } else {
+        ux_flow_init(0, display->has_data ? ux_call_flow : ux_tx_flow, NULL);
+    }
 
     /* Wait for user interaction (handled by event loop) */
     /* The result will be set by the callback and returned when flow completes */
@@ -283,12 +466,235 @@ ui_result_t tx_display_show_approval(const tx_display_t *display) {
     return G_state.ui_result;
 }
 
+/* UX flow for one multi-transfer pair, shown while the tx streams in */
+
+static tx_pair_display_t *g_pair_ptr;
+
+UX_STEP_NOCB(
+    ux_pair_index_step,
+    bnnn_paging,
+    {
+        .title = "Recipient",
+        .text = g_pair_ptr->index,
+    });
+
+UX_STEP_NOCB(
+    ux_pair_recipient_step,
+    bnnn_paging,
+    {
+        .title = "To",
+        .text = g_pair_ptr->recipient,
+    });
+
+UX_STEP_NOCB(
+    ux_pair_amount_step,
+    bnnn_paging,
+    {
+        .title = "Amount",
+        .text = g_pair_ptr->amount,
+    });
+
+UX_STEP_CB(
+    ux_pair_next_step,
+    pb,
+    ui_decide(UI_RESULT_APPROVED),
+    {
+        &C_icon_validate_14,
+        "Next",
+    });
+
+UX_FLOW(ux_pair_flow,
+    &ux_pair_index_step,
+    &ux_pair_recipient_step,
+    &ux_pair_amount_step,
+    &ux_pair_next_step,
+    &ux_tx_reject_step);
+
+ui_result_t tx_display_show_pair(const tx_pair_display_t *display) {
+    if (display == NULL) {
+        return UI_RESULT_REJECTED;
+    }
+
+    /* Store pointer for UX macros */
+    g_pair_ptr = (tx_pair_display_t *)display;
+    G_state.ui_result = UI_RESULT_NONE;
+    APP_TRACE(APP_TRACE_UI_SHOW, APP_TRACE_UI_PAIR, 0);
+
+    ux_flow_init(0, ux_pair_flow, NULL);
+
+    return G_state.ui_result;
+}
+
+/* UX flow for Merkle batch approval */
+
+static tx_batch_display_t *g_batch_ptr;
+
+UX_STEP_NOCB(
+    ux_batch_review_step,
+    pnn,
+    {
+        &C_icon_eye,
+        "Review",
+        "Batch",
+    });
+
+UX_STEP_NOCB(
+    ux_batch_count_step,
+    bnnn_paging,
+    {
+        .title = "Transactions",
+        .text = g_batch_ptr->count,
+    });
+
+UX_STEP_NOCB(
+    ux_batch_chain_step,
+    bnnn_paging,
+    {
+        .title = "Chain ID",
+        .text = g_batch_ptr->chain_id,
+    });
+
+UX_STEP_NOCB(
+    ux_batch_amount_step,
+    bnnn_paging,
+    {
+        .title = "Total Amount",
+        .text = g_batch_ptr->total_amount,
+    });
+
+UX_STEP_NOCB(
+    ux_batch_fee_step,
+    bnnn_paging,
+    {
+        .title = "Total Max Fee",
+        .text = g_batch_ptr->total_fee,
+    });
+
+UX_FLOW(ux_batch_flow,
+    &ux_batch_review_step,
+    &ux_batch_count_step,
+    &ux_batch_chain_step,
+    &ux_batch_amount_step,
+    &ux_batch_fee_step,
+    &ux_tx_approve_step,
+    &ux_tx_reject_step);
+
+ui_result_t tx_display_show_batch_approval(const tx_batch_display_t *display) {
+    if (display == NULL) {
+        return UI_RESULT_REJECTED;
+    }
+
+    /* Store pointer for UX macros */
+    g_batch_ptr = (tx_batch_display_t *)display;
+    G_state.ui_result = UI_RESULT_NONE;
+    APP_TRACE(APP_TRACE_UI_SHOW, APP_TRACE_UI_BATCH, 0);
+
+    ux_flow_init(0, ux_batch_flow, NULL);
+
+    return G_state.ui_result;
+}
+
+/* UX flow for hash-only signing: warning first, header marked unverified */
+
+static tx_hash_display_t *g_hash_ptr;
+
+UX_STEP_NOCB(
+    ux_hash_warning_step,
+    pnn,
+    {
+        &C_icon_warning,
+        "Blind signing",
+        "Tx not shown",
+    });
+
+UX_STEP_NOCB(
+    ux_hash_chain_step,
+    bnnn_paging,
+    {
+        .title = "Chain ID (host)",
+        .text = g_hash_ptr->chain_id,
+    });
+
+UX_STEP_NOCB(
+    ux_hash_nonce_step,
+    bnnn_paging,
+    {
+        .title = "Nonce (host)",
+        .text = g_hash_ptr->nonce,
+    });
+
+UX_STEP_NOCB(
+    ux_hash_fee_step,
+    bnnn_paging,
+    {
+        .title = "Fee (host)",
+        .text = g_hash_ptr->fee,
+    });
+
+UX_STEP_NOCB(
+    ux_hash_digest_step,
+    bnnn_paging,
+    {
+        .title = "Tx Hash",
+        .text = g_hash_ptr->hash,
+    });
+
+UX_FLOW(ux_hash_flow,
+    &ux_hash_warning_step,
+    &ux_hash_chain_step,
+    &ux_hash_nonce_step,
+    &ux_hash_fee_step,
+    &ux_hash_digest_step,
+    &ux_tx_approve_step,
+    &ux_tx_reject_step);
+
+ui_result_t tx_display_show_hash_approval(const tx_hash_display_t *display) {
+    if (display == NULL) {
+        return UI_RESULT_REJECTED;
+    }
+
+    /* Store pointer for UX macros */
+    g_hash_ptr = (tx_hash_display_t *)display;
+    G_state.ui_result = UI_RESULT_NONE;
+    APP_TRACE(APP_TRACE_UI_SHOW, APP_TRACE_UI_HASH, 0);
+
+    ux_flow_init(0, ux_hash_flow, NULL);
+
+    return G_state.ui_result;
+}
+
 #else
 /* Stub for host-side testing */
 
 ui_result_t tx_display_show_approval(const tx_display_t *display) {
     (void)display;
     /* In test mode, auto-approve */
+    APP_TRACE(APP_TRACE_UI_SHOW, APP_TRACE_UI_TX, 0);
+    APP_TRACE(APP_TRACE_UI_DECISION, UI_RESULT_APPROVED, 0);
+    return UI_RESULT_APPROVED;
+}
+
+ui_result_t tx_display_show_pair(const tx_pair_display_t *display) {
+    (void)display;
+    /* In test mode, auto-approve */
+    APP_TRACE(APP_TRACE_UI_SHOW, APP_TRACE_UI_PAIR, 0);
+    APP_TRACE(APP_TRACE_UI_DECISION, UI_RESULT_APPROVED, 0);
+    return UI_RESULT_APPROVED;
+}
+
+ui_result_t tx_display_show_batch_approval(const tx_batch_display_t *display) {
+    (void)display;
+    /* In test mode, auto-approve */
+    APP_TRACE(APP_TRACE_UI_SHOW, APP_TRACE_UI_BATCH, 0);
+    APP_TRACE(APP_TRACE_UI_DECISION, UI_RESULT_APPROVED, 0);
+    return UI_RESULT_APPROVED;
+}
+
+ui_result_t tx_display_show_hash_approval(const tx_hash_display_t *display) {
+    (void)display;
+    /* In test mode, auto-approve */
+    APP_TRACE(APP_TRACE_UI_SHOW, APP_TRACE_UI_HASH, 0);
+    APP_TRACE(APP_TRACE_UI_DECISION, UI_RESULT_APPROVED, 0);
     return UI_RESULT_APPROVED;
 }
 
@@ -15,22 +15,7 @@
 extern "C" {
 #endif
 
-/* Maximum display string lengths */
-#define TX_DISPLAY_AMOUNT_MAX_LEN    32   /* e.g., "18446744073709551615" + null */
-#define TX_DISPLAY_FEE_MAX_LEN       40   /* "Overflow" or large number */
-#define TX_DISPLAY_CHAIN_ID_MAX_LEN  24   /* Chain ID as decimal */
-
-/*
- * Display strings for a transaction.
- */
-typedef struct {
-    char amount[TX_DISPLAY_AMOUNT_MAX_LEN];
-    char recipient[ADDRESS_BASE58_MAX_LEN];
-    char fee[TX_DISPLAY_FEE_MAX_LEN];
-    char chain_id[TX_DISPLAY_CHAIN_ID_MAX_LEN];
-    char sender[ADDRESS_BASE58_MAX_LEN];
-    char nonce[TX_DISPLAY_AMOUNT_MAX_LEN];
-} tx_display_t;
+/* Display string types and lengths are in globals.h (they are part of G_state.work) */
 
 /*
  * Format the parsed transaction for display.
@@ -41,6 +26,15 @@ typedef struct {
  */
 bool tx_display_format(const tx_parsed_t *parsed, tx_display_t *display);
 
+/*
+ * Format the multi-transfer pair the parser just completed.
+ *
+ * @param parsed  Parsed transaction data (tx_parser_pair_ready() true).
+ * @param display Output display strings.
+ * @return true on success, false on error.
+ */
+bool tx_pair_display_format(const tx_parsed_t *parsed, tx_pair_display_t *display);
+
 /*
  * Format a u64 value as a decimal string.
  *
@@ -51,6 +45,39 @@ bool tx_display_format(const tx_parsed_t *parsed, tx_display_t *display);
  */
 size_t format_u64_decimal(uint64_t value, char *out, size_t out_len);
 
+/*
+ * Format a 128-bit value (lo, hi) as a decimal string.
+ *
+ * @param lo      Low 64 bits.
+ * @param hi      High 64 bits.
+ * @param out     Output buffer (TX_DISPLAY_U128_MAX_LEN always fits).
+ * @param out_len Size of output buffer.
+ * @return Number of characters written (excluding null), or 0 on error.
+ */
+size_t format_u128_decimal(uint64_t lo, uint64_t hi, char *out, size_t out_len);
+
+/*
+ * Format a Merkle batch summary for display.
+ *
+ * @param batch   Batch state with at least one transaction.
+ * @param display Output display strings.
+ * @return true on success, false on error.
+ */
+bool tx_batch_display_format(const merkle_batch_t *batch, tx_batch_display_t *display);
+
+/*
+ * Format an INS_SIGN_HASH request for display.
+ *
+ * @param chain_id Chain ID from the request header.
+ * @param nonce    Nonce from the request header.
+ * @param fee      Fee from the request header.
+ * @param hash     Digest to be signed.
+ * @param display  Output display strings.
+ * @return true on success, false on error.
+ */
+bool tx_hash_display_format(uint64_t chain_id, uint64_t nonce, uint64_t fee,
+                            const uint8_t hash[HASH_LEN], tx_hash_display_t *display);
+
 /*
  * Format a 20-byte address as Base58.
  *
@@ -70,6 +97,31 @@ size_t format_address(const uint8_t addr20[20], char *out, size_t out_len);
  */
 ui_result_t tx_display_show_approval(const tx_display_t *display);
 
+/*
+ * Show one multi-transfer pair ("Next" or "Reject"). Not shown when the
+ * user chose to approve multi-transfers by total only (Settings).
+ *
+ * @param display Formatted pair.
+ * @return UI_RESULT_APPROVED to continue, UI_RESULT_REJECTED otherwise.
+ */
+ui_result_t tx_display_show_pair(const tx_pair_display_t *display);
+
+/*
+ * Show the batch approval UI flow (transaction count, chain ID and totals).
+ *
+ * @param display Formatted batch summary.
+ * @return UI_RESULT_APPROVED if user approved, UI_RESULT_REJECTED otherwise.
+ */
+ui_result_t tx_display_show_batch_approval(const tx_batch_display_t *display);
+
+/*
+ * Show the blind-signing warning and the INS_SIGN_HASH approval flow.
+ *
+ * @param display Formatted request.
+ * @return UI_RESULT_APPROVED if user approved, UI_RESULT_REJECTED otherwise.
+ */
+ui_result_t tx_display_show_hash_approval(const tx_hash_display_t *display);
+
 #ifdef __cplusplus
 }
 #endif
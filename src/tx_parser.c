@@ -15,9 +15,30 @@
  *   amount       : 8 bytes (u64 LE)  [TODO: upgrade to u128 if needed]
  *
  * Total for Transfer: 1 + 8 + 20 + 8 + 8 + 8 + 1 + 20 + 8 = 82 bytes
+ *
+ * For tx_type == 0x01 (Call), after the Transfer fields:
+ *   data_len     : 4 bytes (u32 LE)
+ *   data         : data_len bytes, opaque
+ *
+ * Total for Call: 86 + data_len bytes (at most MAX_TX_SIZE). The data is
+ * never copied: tx_parser_consume feeds it straight from the input buffer
+ * into a BLAKE3 hasher whose digest is shown as a fingerprint, so RAM use
+ * does not depend on data_len.
+ *
+ * For tx_type == 0x02 (Multi-transfer), after tx_type:
+ *   count        : 2 bytes (u16 LE), at least 1
+ *   count times:
+ *     recipient  : 20 bytes
+ *     amount     : 8 bytes (u64 LE)
+ *
+ * Total for Multi-transfer: 56 + 28 * count bytes (at most MAX_TX_SIZE).
+ * Only the current pair and a 128-bit running total are kept. After each
+ * pair tx_parser_consume returns early with tx_parser_pair_ready() set, so
+ * the caller can show the pair before the next one overwrites it.
  */
 
 #include "tx_parser.h"
+#include "crypto/sum_blake3.h"
 #include <string.h>
 
 /* Field sizes */
@@ -30,6 +51,11 @@
 #define FIELD_SIZE_TX_TYPE    1
 #define FIELD_SIZE_RECIPIENT  20
 #define FIELD_SIZE_AMOUNT     8   /* TODO: 16 for u128 */
+#define FIELD_SIZE_DATA_LEN   4
+#define FIELD_SIZE_RECIPIENT_COUNT 2
+
+/* Bytes per multi-transfer (recipient, amount) pair */
+#define MULTI_TRANSFER_PAIR_SIZE   (FIELD_SIZE_RECIPIENT + FIELD_SIZE_AMOUNT)
 
 /* Helper: read u64 little-endian from buffer */
 static uint64_t read_u64_le(const uint8_t *buf) {
@@ -43,6 +69,19 @@ static uint64_t read_u64_le(const uint8_t *buf) {
          | ((uint64_t)buf[7] << 56);
 }
 
+/* Helper: read u32 little-endian from buffer */
+static uint32_t read_u32_le(const uint8_t *buf) {
+    return ((uint32_t)buf[0])
+         | ((uint32_t)buf[1] << 8)
+         | ((uint32_t)buf[2] << 16)
+         | ((uint32_t)buf[3] << 24);
+}
+
+/* Helper: read u16 little-endian from buffer */
+static uint16_t read_u16_le(const uint8_t *buf) {
+    return (uint16_t)(buf[0] | (buf[1] << 8));
+}
+
 /* Get the size of the current field being parsed */
 static size_t get_field_size(tx_parse_state_t state) {
     switch (state) {
@@ -55,10 +94,26 @@ static size_t get_field_size(tx_parse_state_t state) {
         case TX_PARSE_STATE_TX_TYPE:    return FIELD_SIZE_TX_TYPE;
         case TX_PARSE_STATE_RECIPIENT:  return FIELD_SIZE_RECIPIENT;
         case TX_PARSE_STATE_AMOUNT:     return FIELD_SIZE_AMOUNT;
+        case TX_PARSE_STATE_DATA_LEN:   return FIELD_SIZE_DATA_LEN;
+        case TX_PARSE_STATE_RECIPIENT_COUNT: return FIELD_SIZE_RECIPIENT_COUNT;
         default:                        return 0;
     }
 }
 
+/* Enter the terminal state and compute derived fields */
+static void finish_tx(tx_parser_ctx_t *ctx) {
+    if (ctx->parsed.tx_type == TX_TYPE_CALL) {
+        sum_blake3_finalize32(&ctx->data_hash_ctx, ctx->parsed.data_hash);
+        sum_blake3_zeroize_used(&ctx->data_hash_ctx);
+    }
+    if (ctx->parsed.tx_type != TX_TYPE_MULTI_TRANSFER) {
+        ctx->parsed.total_amount_lo = ctx->parsed.amount;
+        ctx->parsed.total_amount_hi = 0;
+    }
+    ctx->state = TX_PARSE_STATE_DONE;
+    tx_parser_compute_fee(&ctx->parsed);
+}
+
 /* Process a complete field from the scratch buffer */
 static bool process_complete_field(tx_parser_ctx_t *ctx) {
     tx_parsed_t *p = &ctx->parsed;
@@ -101,8 +156,10 @@ static bool process_complete_field(tx_parser_ctx_t *ctx) {
         case TX_PARSE_STATE_TX_TYPE:
             p->tx_type = ctx->scratch[0];
             /* Route to tx-type-specific fields */
-            if (p->tx_type == TX_TYPE_TRANSFER) {
+            if (p->tx_type == TX_TYPE_TRANSFER || p->tx_type == TX_TYPE_CALL) {
                 ctx->state = TX_PARSE_STATE_RECIPIENT;
+            } else if (p->tx_type == TX_TYPE_MULTI_TRANSFER) {
+                ctx->state = TX_PARSE_STATE_RECIPIENT_COUNT;
             } else {
                 /* Unsupported tx type */
                 return false;
@@ -116,10 +173,48 @@ static bool process_complete_field(tx_parser_ctx_t *ctx) {
 
         case TX_PARSE_STATE_AMOUNT:
             p->amount = read_u64_le(ctx->scratch);
-            /* Parsing complete */
-            ctx->state = TX_PARSE_STATE_DONE;
-            /* Compute fee */
-            tx_parser_compute_fee(p);
+            if (p->tx_type == TX_TYPE_MULTI_TRANSFER) {
+                p->total_amount_lo += p->amount;
+                p->total_amount_hi += (p->total_amount_lo < p->amount) ? 1 : 0;
+                p->recipient_index++;
+                ctx->pair_ready = true;
+                if (p->recipient_index == p->recipient_count) {
+                    finish_tx(ctx);
+                } else {
+                    ctx->state = TX_PARSE_STATE_RECIPIENT;
+                }
+            } else if (p->tx_type == TX_TYPE_CALL) {
+                ctx->state = TX_PARSE_STATE_DATA_LEN;
+            } else {
+                /* Parsing complete */
+                finish_tx(ctx);
+            }
+            break;
+
+        case TX_PARSE_STATE_DATA_LEN:
+            p->data_len = read_u32_le(ctx->scratch);
+            /* Reject up front rather than after hashing up to MAX_TX_SIZE bytes */
+            if (p->data_len > MAX_TX_SIZE - ctx->total_consumed) {
+                return false;
+            }
+            sum_blake3_init(&ctx->data_hash_ctx);
+            ctx->data_remaining = p->data_len;
+            if (ctx->data_remaining == 0) {
+                finish_tx(ctx);
+            } else {
+                ctx->state = TX_PARSE_STATE_DATA;
+            }
+            break;
+
+        case TX_PARSE_STATE_RECIPIENT_COUNT:
+            p->recipient_count = read_u16_le(ctx->scratch);
+            /* Reject up front rather than after parsing up to MAX_TX_SIZE bytes */
+            if (p->recipient_count == 0 ||
+                (size_t)p->recipient_count * MULTI_TRANSFER_PAIR_SIZE >
+                    MAX_TX_SIZE - ctx->total_consumed) {
+                return false;
+            }
+            ctx->state = TX_PARSE_STATE_RECIPIENT;
             break;
 
         default:
@@ -135,7 +230,9 @@ void tx_parser_init(tx_parser_ctx_t *ctx) {
     if (ctx == NULL) {
         return;
     }
-    memset(ctx, 0, sizeof(tx_parser_ctx_t));
+    /* Whole data hasher: later wipes only cover the part it used */
+    memset(ctx, 0, offsetof(tx_parser_ctx_t, data_hash_ctx));
+    sum_blake3_zeroize(&ctx->data_hash_ctx);
     ctx->state = TX_PARSE_STATE_VERSION;
     ctx->field_offset = 0;
     ctx->total_consumed = 0;
@@ -155,18 +252,42 @@ size_t tx_parser_consume(tx_parser_ctx_t *ctx, const uint8_t *data, size_t data_
     }
 
     size_t consumed = 0;
+    tx_parse_state_t traced = ctx->state;
+    ctx->pair_ready = false;
+
+    while (consumed < data_len && !ctx->pair_ready &&
+           ctx->state != TX_PARSE_STATE_DONE && ctx->state != TX_PARSE_STATE_ERROR) {
+        if (ctx->state != traced) {
+            traced = ctx->state;
+            APP_TRACE(APP_TRACE_PARSE_STATE, traced, ctx->total_consumed);
+        }
 
-    while (consumed < data_len && ctx->state != TX_PARSE_STATE_DONE && ctx->state != TX_PARSE_STATE_ERROR) {
         /* Check for maximum transaction size */
         if (ctx->total_consumed >= MAX_TX_SIZE) {
             ctx->state = TX_PARSE_STATE_ERROR;
-            return consumed;
+            break;
+        }
+
+        /* Opaque data: hash straight from the input, no scratch copy */
+        if (ctx->state == TX_PARSE_STATE_DATA) {
+            size_t available = data_len - consumed;
+            size_t take = (available < ctx->data_remaining) ? available : ctx->data_remaining;
+
+            sum_blake3_update(&ctx->data_hash_ctx, &data[consumed], take);
+            ctx->data_remaining -= (uint32_t)take;
+            consumed += take;
+            ctx->total_consumed += take;
+
+            if (ctx->data_remaining == 0) {
+                finish_tx(ctx);
+            }
+            continue;
         }
 
         size_t field_size = get_field_size(ctx->state);
         if (field_size == 0) {
             ctx->state = TX_PARSE_STATE_ERROR;
-            return consumed;
+            break;
         }
 
         /* How many bytes still needed for current field */
@@ -177,7 +298,7 @@ size_t tx_parser_consume(tx_parser_ctx_t *ctx, const uint8_t *data, size_t data_
         /* Bounds check on scratch buffer */
         if (ctx->field_offset + take > sizeof(ctx->scratch)) {
             ctx->state = TX_PARSE_STATE_ERROR;
-            return consumed;
+            break;
         }
 
         /* Copy into scratch buffer */
@@ -190,11 +311,15 @@ size_t tx_parser_consume(tx_parser_ctx_t *ctx, const uint8_t *data, size_t data_
         if (ctx->field_offset >= field_size) {
             if (!process_complete_field(ctx)) {
                 ctx->state = TX_PARSE_STATE_ERROR;
-                return consumed;
+                break;
             }
         }
     }
 
+    if (ctx->state != traced) {
+        APP_TRACE(APP_TRACE_PARSE_STATE, ctx->state, ctx->total_consumed);
+    }
+
     return consumed;
 }
 
@@ -202,6 +327,10 @@ bool tx_parser_is_done(const tx_parser_ctx_t *ctx) {
     return ctx != NULL && ctx->state == TX_PARSE_STATE_DONE;
 }
 
+bool tx_parser_pair_ready(const tx_parser_ctx_t *ctx) {
+    return ctx != NULL && ctx->pair_ready;
+}
+
 bool tx_parser_has_error(const tx_parser_ctx_t *ctx) {
     return ctx != NULL && ctx->state == TX_PARSE_STATE_ERROR;
 }
@@ -254,5 +383,6 @@ void tx_parser_zeroize(tx_parser_ctx_t *ctx) {
     if (ctx == NULL) {
         return;
     }
-    SECURE_ZEROIZE(ctx, sizeof(tx_parser_ctx_t));
+    SECURE_ZEROIZE(ctx, offsetof(tx_parser_ctx_t, data_hash_ctx));
+    sum_blake3_zeroize_used(&ctx->data_hash_ctx);
 }
@@ -36,6 +36,9 @@ void tx_parser_reset(tx_parser_ctx_t *ctx);
  * @param ctx      Parser context.
  * @param data     Input data chunk.
  * @param data_len Length of input data.
+ * Stops early at the end of the transaction and, for multi-transfers,
+ * after each (recipient, amount) pair (see tx_parser_pair_ready).
+ *
  * @return Number of bytes consumed, or 0 on error (check ctx->state).
  */
 size_t tx_parser_consume(tx_parser_ctx_t *ctx, const uint8_t *data, size_t data_len);
@@ -48,6 +51,16 @@ size_t tx_parser_consume(tx_parser_ctx_t *ctx, const uint8_t *data, size_t data_
  */
 bool tx_parser_is_done(const tx_parser_ctx_t *ctx);
 
+/*
+ * Check if the last tx_parser_consume call completed a multi-transfer pair.
+ * The pair is in parsed.recipient / parsed.amount (number parsed.recipient_index
+ * of parsed.recipient_count) until the next call.
+ *
+ * @param ctx Parser context.
+ * @return true if a pair is ready for review.
+ */
+bool tx_parser_pair_ready(const tx_parser_ctx_t *ctx);
+
 /*
  * Check if parser is in error state.
  *
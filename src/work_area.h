@@ -0,0 +1,84 @@
+/*
+ * SUM Chain Ledger App - Per-Command Working Set
+ *
+ * Key material, digests, signatures and display strings that only live for
+ * one APDU share G_state.work instead of separate buffers in G_state and on
+ * the stack. Each accessor returns one layout of the union and records how
+ * far into the arena the command has written; apdu_dispatch calls
+ * work_area_clear() once on exit, which zeroizes exactly that prefix.
+ * Handlers therefore do not zeroize these buffers themselves.
+ *
+ * Values that must survive to the next APDU (sign_session, sig_cache) are
+ * not part of the arena.
+ */
+
+#ifndef WORK_AREA_H
+#define WORK_AREA_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "globals.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Mark the first end bytes of the arena as in use */
+static inline void work_area_claim(size_t end) {
+    if (end > G_state.work_used) {
+        G_state.work_used = (uint16_t)end;
+    }
+}
+
+/*
+ * Zeroize what the current command used. Called by apdu_dispatch on exit
+ * and, on the device, after an exception escapes a handler.
+ */
+static inline void work_area_clear(void) {
+    SECURE_ZEROIZE(&G_state.work, G_state.work_used);
+    G_state.work_used = 0;
+}
+
+/* GET_PUBLIC_KEY, GET_XPUB */
+static inline work_key_t *work_key(void) {
+    work_area_claim(sizeof(work_key_t));
+    return &G_state.work.key;
+}
+
+/* GET_ADDRESS */
+static inline work_address_t *work_address(void) {
+    work_area_claim(sizeof(work_address_t));
+    return &G_state.work.address;
+}
+
+/* Digest and signature of the signing commands, without the display strings */
+static inline work_sign_t *work_sign(void) {
+    work_area_claim(offsetof(work_sign_t, display));
+    return &G_state.work.sign;
+}
+
+static inline tx_display_t *work_tx_display(void) {
+    work_area_claim(offsetof(work_sign_t, display) + sizeof(tx_display_t));
+    return &G_state.work.sign.display.tx;
+}
+
+static inline tx_pair_display_t *work_pair_display(void) {
+    work_area_claim(offsetof(work_sign_t, display) + sizeof(tx_pair_display_t));
+    return &G_state.work.sign.display.pair;
+}
+
+static inline tx_batch_display_t *work_batch_display(void) {
+    work_area_claim(offsetof(work_sign_t, display) + sizeof(tx_batch_display_t));
+    return &G_state.work.sign.display.batch;
+}
+
+static inline tx_hash_display_t *work_hash_display(void) {
+    work_area_claim(offsetof(work_sign_t, display) + sizeof(tx_hash_display_t));
+    return &G_state.work.sign.display.digest;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WORK_AREA_H */
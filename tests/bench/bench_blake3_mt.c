@@ -0,0 +1,112 @@
+/*
+ * SUM Chain Ledger App - Multi-Threaded BLAKE3 Benchmark
+ *
+ * Hashes 1 MB, 16 MB, 256 MB, 1 GB and 10 GB (up to max_bytes) with
+ * blake3_hasher_update_tbb on the pthread pool, at 1, 2, 4, ... threads up
+ * to max_threads, and prints MB/s and the speedup over one thread:
+ *   ./bench_blake3_mt [max_bytes [max_threads]]
+ * max_bytes takes a K/M/G suffix (default 1G); max_threads 0 means online
+ * CPUs (the default).
+ *
+ * Inputs up to STREAM_LEN are hashed in one update. Larger ones are fed
+ * STREAM_LEN bytes at a time, the way host tools hash files, so memory use
+ * stays fixed. The digest at every thread count is checked against the
+ * one-thread digest; a mismatch fails the run.
+ */
+
+#include "blake3.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define STREAM_LEN  (64u << 20)
+
+static uint8_t g_stream[STREAM_LEN];
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static uint64_t parse_size(const char *s) {
+    char *end;
+    uint64_t v = strtoull(s, &end, 10);
+
+    switch (*end) {
+        case 'K': case 'k': return v << 10;
+        case 'M': case 'm': return v << 20;
+        case 'G': case 'g': return v << 30;
+        default:            return v;
+    }
+}
+
+/* Hash total bytes of the stream pattern; returns seconds */
+static double hash_bytes(uint64_t total, uint8_t out[BLAKE3_OUT_LEN]) {
+    static blake3_hasher hasher;
+    double start = now_seconds();
+
+    blake3_hasher_init(&hasher);
+    for (uint64_t done = 0; done < total; ) {
+        size_t take = (total - done < STREAM_LEN) ? (size_t)(total - done) : STREAM_LEN;
+        blake3_hasher_update_tbb(&hasher, g_stream, take);
+        done += take;
+    }
+    blake3_hasher_finalize(&hasher, out, BLAKE3_OUT_LEN);
+    return now_seconds() - start;
+}
+
+int main(int argc, char **argv) {
+    static const uint64_t sizes[] = {
+        1ull << 20, 16ull << 20, 256ull << 20, 1ull << 30, 10ull << 30,
+    };
+    uint64_t max_bytes = (argc > 1) ? parse_size(argv[1]) : (1ull << 30);
+    unsigned max_threads = (argc > 2) ? (unsigned)strtoul(argv[2], NULL, 10) : 0;
+    int status = 0;
+
+    if (max_threads == 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        max_threads = (cpus > 0) ? (unsigned)cpus : 1;
+    }
+    if (max_threads > BLAKE3_PTHREAD_MAX_THREADS) {
+        max_threads = BLAKE3_PTHREAD_MAX_THREADS;
+    }
+    for (size_t i = 0; i < sizeof(g_stream); i++) {
+        g_stream[i] = (uint8_t)(i % 251);
+    }
+
+    printf("%-12s %8s %10s %8s\n", "input", "threads", "MB/s", "speedup");
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]) && sizes[s] <= max_bytes; s++) {
+        uint8_t base[BLAKE3_OUT_LEN];
+        uint8_t out[BLAKE3_OUT_LEN];
+        double base_time = 0.0;
+
+        /* Small inputs are repeated so each timing covers at least 256 MB */
+        uint64_t reps = (sizes[s] < (256ull << 20)) ? (256ull << 20) / sizes[s] : 1;
+
+        for (unsigned t = 1; ; t = (t * 2 > max_threads && t < max_threads) ? max_threads : t * 2) {
+            double elapsed = 0.0;
+            blake3_pthread_set_threads(t);
+            for (uint64_t r = 0; r < reps; r++) {
+                elapsed += hash_bytes(sizes[s], out);
+            }
+
+            if (t == 1) {
+                memcpy(base, out, sizeof(base));
+                base_time = elapsed;
+            } else if (memcmp(out, base, sizeof(base)) != 0) {
+                printf("%-12llu %8u  digest mismatch\n", (unsigned long long)sizes[s], t);
+                status = 1;
+            }
+            printf("%-12llu %8u %10.1f %7.2fx\n", (unsigned long long)sizes[s], t,
+                   (double)(sizes[s] * reps) / elapsed / 1e6, base_time / elapsed);
+            if (t >= max_threads) {
+                break;
+            }
+        }
+    }
+
+    return status;
+}
@@ -0,0 +1,172 @@
+/*
+ * SUM Chain Ledger App - Kernel Benchmarks
+ *
+ * Runs one hot kernel of the app in a loop:
+ *   ./bench_kernels list               names of the operations
+ *   ./bench_kernels <op> <iterations>  run one operation
+ *   ./bench_kernels all [iterations]   run every operation, print ns/op
+ *
+ * Built natively (make -C tests bench) it reports wall-clock ns/op. Built
+ * for ARM (make bench-arm) it runs under qemu-arm with an instruction-
+ * counting plugin; tools/bench_arm.py runs each operation at 0 and N
+ * iterations and reports the difference divided by N, so process startup
+ * and setup cancel out. Inputs are fixed, so counts are reproducible.
+ */
+
+#include "globals.h"
+#include "address.h"
+#include "tx_parser.h"
+#include "tx_display.h"
+#include "sum_blake3.h"
+#include "blake3_impl.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Global state (normally in main.c); only linked in for address.c */
+app_state_t G_app_state;
+
+/* Results are folded in here so the compiler cannot drop the work */
+static volatile uint32_t g_sink;
+
+static uint8_t g_tx[82];
+static uint8_t g_block[BLAKE3_BLOCK_LEN];
+static uint8_t g_input[1024];
+static uint8_t g_addr[ADDRESS_LEN];
+
+static void setup(void) {
+    for (size_t i = 0; i < sizeof(g_input); i++) {
+        g_input[i] = (uint8_t)(i % 251);
+    }
+    memcpy(g_block, g_input, sizeof(g_block));
+    for (size_t i = 0; i < sizeof(g_addr); i++) {
+        g_addr[i] = (uint8_t)(0xA0 + i * 7);
+    }
+
+    /* Transfer: version 1, every integer field with high bytes set */
+    memset(g_tx, 0, sizeof(g_tx));
+    g_tx[0] = 1;
+    for (size_t i = 1; i < sizeof(g_tx); i++) {
+        g_tx[i] = (uint8_t)(i * 13 + 5);
+    }
+    g_tx[53] = TX_TYPE_TRANSFER;
+}
+
+static void op_blake3_compress(void) {
+    uint32_t cv[8];
+    memcpy(cv, IV, sizeof(cv));
+    blake3_compress_in_place_portable(cv, g_block, BLAKE3_BLOCK_LEN, 0, CHUNK_START | CHUNK_END | ROOT);
+    g_sink ^= cv[0];
+}
+
+static void op_blake3_tx(void) {
+    uint8_t out[HASH_LEN];
+    sum_blake3_hash(g_tx, sizeof(g_tx), out);
+    g_sink ^= out[0];
+}
+
+static void op_blake3_1k(void) {
+    uint8_t out[HASH_LEN];
+    sum_blake3_hash(g_input, sizeof(g_input), out);
+    g_sink ^= out[0];
+}
+
+static void op_base58_encode(void) {
+    char out[ADDRESS_BASE58_MAX_LEN];
+    g_sink ^= (uint32_t)base58_encode(g_addr, sizeof(g_addr), out, sizeof(out));
+}
+
+/* format_fee's work for a fee that does not overflow: 128-bit to decimal */
+static void op_format_fee(void) {
+    char out[TX_DISPLAY_FEE_MAX_LEN];
+    g_sink ^= (uint32_t)format_u128_decimal(0xFEDCBA9876543210ULL, 0x0123456789ABCDEFULL,
+                                            out, sizeof(out));
+}
+
+static void op_format_u64(void) {
+    char out[TX_DISPLAY_AMOUNT_MAX_LEN];
+    g_sink ^= (uint32_t)format_u64_decimal(0xFEDCBA9876543210ULL, out, sizeof(out));
+}
+
+static void op_tx_parse(void) {
+    static tx_parser_ctx_t ctx;
+    tx_parser_init(&ctx);
+    g_sink ^= (uint32_t)tx_parser_consume(&ctx, g_tx, sizeof(g_tx));
+}
+
+static void op_tx_display(void) {
+    static tx_parser_ctx_t ctx;
+    static tx_display_t display;
+    tx_parser_init(&ctx);
+    tx_parser_consume(&ctx, g_tx, sizeof(g_tx));
+    g_sink ^= (uint32_t)tx_display_format(tx_parser_get_parsed(&ctx), &display);
+}
+
+typedef struct {
+    const char *name;
+    void (*run)(void);
+} bench_op_t;
+
+static const bench_op_t OPS[] = {
+    { "blake3_compress",  op_blake3_compress },   /* One 64-byte block, portable */
+    { "blake3_tx",        op_blake3_tx },         /* sum_blake3_hash, 82-byte transfer */
+    { "blake3_1k",        op_blake3_1k },         /* sum_blake3_hash, one 1024-byte chunk */
+    { "base58_encode",    op_base58_encode },     /* 20-byte address */
+    { "format_fee",       op_format_fee },        /* 128-bit decimal */
+    { "format_u64",       op_format_u64 },
+    { "tx_parse",         op_tx_parse },          /* tx_parser_consume, transfer */
+    { "tx_display",       op_tx_display },        /* parse + tx_display_format */
+};
+
+#define OP_COUNT (sizeof(OPS) / sizeof(OPS[0]))
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static const bench_op_t *find_op(const char *name) {
+    for (size_t i = 0; i < OP_COUNT; i++) {
+        if (strcmp(OPS[i].name, name) == 0) {
+            return &OPS[i];
+        }
+    }
+    return NULL;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2 || strcmp(argv[1], "list") == 0) {
+        for (size_t i = 0; i < OP_COUNT; i++) {
+            printf("%s\n", OPS[i].name);
+        }
+        return argc < 2 ? 1 : 0;
+    }
+
+    unsigned long iterations = (argc > 2) ? strtoul(argv[2], NULL, 0) : 100000;
+    setup();
+
+    if (strcmp(argv[1], "all") == 0) {
+        for (size_t i = 0; i < OP_COUNT; i++) {
+            double start = now_ns();
+            for (unsigned long n = 0; n < iterations; n++) {
+                OPS[i].run();
+            }
+            double elapsed = now_ns() - start;
+            printf("%-18s %10.1f ns/op\n", OPS[i].name,
+                   iterations ? elapsed / (double)iterations : 0.0);
+        }
+        return 0;
+    }
+
+    const bench_op_t *op = find_op(argv[1]);
+    if (op == NULL) {
+        fprintf(stderr, "bench_kernels: unknown operation %s\n", argv[1]);
+        return 1;
+    }
+    for (unsigned long n = 0; n < iterations; n++) {
+        op->run();
+    }
+    return 0;
+}
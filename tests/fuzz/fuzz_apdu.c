@@ -0,0 +1,544 @@
+/*
+ * SUM Chain Ledger App - APDU State-Machine Fuzzer
+ *
+ * Every input is a sequence of APDUs run through apdu_dispatch of the host
+ * build (the simulator behind apdu_loopback, UI auto-approves). Input
+ * layout:
+ *   [settings:1]                bit 0: hash signing, bit 1: multi total-only
+ *   records until the input ends:
+ *     [ctl:1] [ins:1] [p1:1] [p2:1] [lc:1] [data: lc bytes]
+ *   ctl bit 0: send CLA 0xE1 instead of 0xE0
+ *   ctl bit 1: advance the sig_cache ticker (ctl >> 2) * 16 times first
+ * A record cut short by the end of the input is sent with the bytes left.
+ *
+ * After each APDU the session invariants below are checked; any violation
+ * aborts:
+ *   - a failed APDU returns no data, and no response exceeds 255 bytes;
+ *   - the per-command working set (G_state.work) is zero and unclaimed;
+ *   - an inactive sign_session is all zero; an active one has a valid path,
+ *     at most MAX_TX_SIZE bytes, no pending last chunk, a parser that is
+ *     not in error and (SIGN_TX) has consumed exactly the bytes received;
+ *   - instructions other than SIGN_TX / SIGN_MERKLE leave the session as is;
+ *   - a final chunk returns the signature (SIGN_MERKLE: root then
+ *     signature) and closes the session;
+ *   - the sig_cache entry is either all zero or valid inside its window.
+ *
+ * libFuzzer (clang):  make -C tests fuzz-apdu
+ *                     ./fuzz_apdu -max_len=4096 corpus/
+ * Standalone (gcc):   make -C tests fuzz-apdu-replay
+ *                     ./fuzz_apdu_replay [-n iterations] [-s seed] [file...]
+ *
+ * Both builds use ASan/UBSan. The standalone driver replays files or, by
+ * default, generates interleaved SIGN_TX / SIGN_MERKLE / SIGN_HASH sessions
+ * with truncated paths, bad P1/P2, dropped chunks and oversized streams,
+ * and prints execs/s and APDUs/s so hot-path changes can be timed under the
+ * same checks.
+ */
+
+#include "apdu_handlers.h"
+#include "crypto.h"
+#include "settings.h"
+#include "merkle.h"
+#include "tx_parser.h"
+#include "sig_cache.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Global state (normally in main.c) */
+app_state_t G_app_state;
+
+#define FUZZ_RECORD_HEADER     5
+#define FUZZ_CTL_BAD_CLA       0x01
+#define FUZZ_CTL_TICK          0x02
+#define FUZZ_MAX_RESP          255
+
+static const char *g_input_name = "(generated)";
+static const uint8_t *g_input;
+static size_t g_input_len;
+static size_t g_apdu_index;
+
+static void violation(const char *what, uint8_t ins, uint16_t sw) {
+    fprintf(stderr, "fuzz_apdu: %s after APDU %zu (INS 0x%02X, SW %04X) for input %s\n",
+            what, g_apdu_index, ins, sw, g_input_name);
+#ifdef FUZZ_STANDALONE
+    /* libFuzzer saves its own crash artifacts */
+    FILE *f = fopen("crash-apdu.bin", "wb");
+    if (f != NULL) {
+        fwrite(g_input, 1, g_input_len, f);
+        fclose(f);
+        fprintf(stderr, "fuzz_apdu: input saved to crash-apdu.bin\n");
+    }
+#endif
+    abort();
+}
+
+static bool all_zero(const void *p, size_t len) {
+    const uint8_t *b = (const uint8_t *)p;
+    for (size_t i = 0; i < len; i++) {
+        if (b[i] != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void check_invariants(uint8_t cla, uint8_t ins, uint8_t p2, uint16_t sw, size_t resp_len,
+                             const sign_session_t *before) {
+    const sign_session_t *session = &G_state.sign_session;
+    const sig_cache_t *cache = &G_state.sig_cache;
+    bool session_ins = (cla == CLA_SUMCHAIN && (ins == INS_SIGN_TX || ins == INS_SIGN_MERKLE));
+
+    if (resp_len > FUZZ_MAX_RESP) {
+        violation("response too long", ins, sw);
+    }
+    if (sw != SW_OK && resp_len != 0) {
+        violation("data returned with an error", ins, sw);
+    }
+    if (G_state.work_used != 0 || !all_zero(&G_state.work, sizeof(G_state.work))) {
+        violation("working set not zeroized", ins, sw);
+    }
+
+    if (!session->initialized) {
+        if (!all_zero(session, sizeof(*session))) {
+            violation("inactive session not zeroized", ins, sw);
+        }
+    } else {
+        if (!crypto_validate_path(&session->path)) {
+            violation("active session with an invalid path", ins, sw);
+        }
+        if (session->total_received > MAX_TX_SIZE) {
+            violation("session over MAX_TX_SIZE", ins, sw);
+        }
+        if (session->last_chunk_received) {
+            violation("session kept after its last chunk", ins, sw);
+        }
+        if (tx_parser_has_error(&session->parser)) {
+            violation("session kept after a parse error", ins, sw);
+        }
+        if (!session->is_batch && session->parser.total_consumed != session->total_received) {
+            violation("parser and session byte counts differ", ins, sw);
+        }
+    }
+
+    if (!session_ins && memcmp(before, session, sizeof(*session)) != 0) {
+        violation("non-signing instruction changed the session", ins, sw);
+    }
+
+    if (session_ins && sw == SW_OK) {
+        size_t final_len = (ins == INS_SIGN_MERKLE) ? MERKLE_HASH_LEN + SIGNATURE_LEN : SIGNATURE_LEN;
+        if (p2 == P2_LAST_CHUNK && (resp_len != final_len || session->initialized)) {
+            violation("final chunk did not return its signature and close", ins, sw);
+        }
+        if (p2 == P2_MORE_CHUNKS && (resp_len != 0 || !session->initialized)) {
+            violation("intermediate chunk closed the session or returned data", ins, sw);
+        }
+    }
+
+    if (cache->valid) {
+        if (cache->ticks_left == 0 || cache->ticks_left > SIG_CACHE_WINDOW_TICKS ||
+            !crypto_validate_path(&cache->path)) {
+            violation("sig_cache entry out of its window", ins, sw);
+        }
+    } else if (!all_zero(cache, sizeof(*cache))) {
+        violation("expired sig_cache entry not zeroized", ins, sw);
+    }
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    static sign_session_t before;
+    uint8_t buf[FUZZ_MAX_RESP + 1];
+    uint8_t resp[512];
+    size_t pos = 1;
+
+    if (size == 0) {
+        return 0;
+    }
+    g_input = data;
+    g_input_len = size;
+
+    memset(&G_app_state, 0, sizeof(G_app_state));
+    settings_set_hash_signing((data[0] & 0x01) != 0);
+    settings_set_multi_total_only((data[0] & 0x02) != 0);
+
+    for (g_apdu_index = 0; pos + FUZZ_RECORD_HEADER <= size; g_apdu_index++) {
+        const uint8_t *rec = &data[pos];
+        uint8_t cla = (rec[0] & FUZZ_CTL_BAD_CLA) ? (CLA_SUMCHAIN | 0x01) : CLA_SUMCHAIN;
+        size_t lc = rec[4];
+
+        pos += FUZZ_RECORD_HEADER;
+        if (lc > size - pos) {
+            lc = size - pos;
+        }
+        memcpy(buf, &data[pos], lc);
+        pos += lc;
+
+        if (rec[0] & FUZZ_CTL_TICK) {
+            for (unsigned i = 0; i < (unsigned)(rec[0] >> 2) * 16; i++) {
+                sig_cache_tick();
+            }
+        }
+
+        memcpy(&before, &G_state.sign_session, sizeof(before));
+        uint8_t *tx = resp;
+        uint16_t sw = apdu_dispatch(cla, rec[1], rec[2], rec[3], (uint8_t)lc, buf, &tx);
+        check_invariants(cla, rec[1], rec[3], sw, (size_t)(tx - resp), &before);
+    }
+
+    return 0;
+}
+
+#ifdef FUZZ_STANDALONE
+
+#include <time.h>
+
+#define GEN_MAX_INPUT          (1u << 20)
+#define GEN_MAX_STREAM         (MAX_TX_SIZE + 2048)
+#define GEN_MAX_APDUS          600
+#define GEN_CHUNK_MAX          255
+
+static uint8_t g_buf[GEN_MAX_INPUT];
+
+static uint64_t xorshift64(uint64_t *state) {
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+static uint64_t rnd(uint64_t *rng, uint64_t n) {
+    return xorshift64(rng) % n;
+}
+
+static void put_le(uint8_t *p, uint64_t v, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        p[i] = (uint8_t)(v >> (i * 8));
+    }
+}
+
+/* One generated APDU, before it is written as a record */
+typedef struct {
+    uint8_t ctl;
+    uint8_t ins;
+    uint8_t p1;
+    uint8_t p2;
+    uint8_t lc;
+    uint8_t data[GEN_CHUNK_MAX];
+} gen_apdu_t;
+
+typedef struct {
+    gen_apdu_t apdus[GEN_MAX_APDUS];
+    size_t     count;
+} gen_script_t;
+
+static gen_apdu_t *script_add(gen_script_t *s, uint8_t ins, uint8_t p1, uint8_t p2) {
+    if (s->count == GEN_MAX_APDUS) {
+        return NULL;
+    }
+    gen_apdu_t *a = &s->apdus[s->count++];
+    memset(a, 0, sizeof(*a));
+    a->ins = ins;
+    a->p1 = p1;
+    a->p2 = p2;
+    return a;
+}
+
+/* Serialized path; sometimes unhardened, too deep or with a lying length */
+static size_t gen_path(uint64_t *rng, uint8_t *out) {
+    bool bip32 = rnd(rng, 4) == 0;
+    size_t depth = bip32 ? 5 : 3 + rnd(rng, 3);
+    uint32_t comps[MAX_BIP32_PATH_LEN + 2];
+
+    comps[0] = 0x80000000u | 44;
+    comps[1] = 0x80000000u | 12345;
+    comps[2] = 0x80000000u | (uint32_t)rnd(rng, 3);
+    for (size_t i = 3; i < MAX_BIP32_PATH_LEN + 2; i++) {
+        comps[i] = (bip32 ? 0 : 0x80000000u) | (uint32_t)rnd(rng, 4);
+    }
+
+    switch (rnd(rng, 12)) {
+        case 0: depth = MAX_BIP32_PATH_LEN + 1 + rnd(rng, 2); break;
+        case 1: comps[2] &= 0x7FFFFFFFu; break;
+        case 2: depth = 0; break;
+        default: break;
+    }
+
+    out[0] = (uint8_t)depth | (bip32 ? PATH_LEN_FLAG_BIP32_ED25519 : 0);
+    for (size_t i = 0; i < depth && i < MAX_BIP32_PATH_LEN + 2; i++) {
+        out[1 + 4 * i] = (uint8_t)(comps[i] >> 24);
+        out[2 + 4 * i] = (uint8_t)(comps[i] >> 16);
+        out[3 + 4 * i] = (uint8_t)(comps[i] >> 8);
+        out[4 + 4 * i] = (uint8_t)comps[i];
+    }
+    size_t len = 1 + 4 * depth;
+    /* Truncated path: the length byte promises more than follows */
+    if (len > 1 && rnd(rng, 10) == 0) {
+        len -= 1 + rnd(rng, 4);
+    }
+    return len;
+}
+
+/* A valid transaction of a random type; `big` asks for a MAX_TX_SIZE-sized call */
+static size_t gen_tx(uint64_t *rng, uint8_t *out, bool big) {
+    size_t len;
+
+    out[0] = 1;
+    put_le(&out[1], 1 + rnd(rng, 3), 8);
+    for (size_t i = 9; i < 29; i++) {
+        out[i] = (uint8_t)xorshift64(rng);
+    }
+    put_le(&out[29], rnd(rng, 100), 8);
+    put_le(&out[37], rnd(rng, 1000), 8);
+    put_le(&out[45], 21000, 8);
+    out[53] = big ? TX_TYPE_CALL : (uint8_t)rnd(rng, 3);
+
+    if (out[53] == TX_TYPE_MULTI_TRANSFER) {
+        size_t count = 1 + rnd(rng, 12);
+        put_le(&out[54], count, 2);
+        len = 56;
+        for (size_t i = 0; i < count; i++) {
+            for (size_t b = 0; b < ADDRESS_LEN; b++) {
+                out[len++] = (uint8_t)xorshift64(rng);
+            }
+            put_le(&out[len], rnd(rng, 1u << 20), 8);
+            len += 8;
+        }
+        return len;
+    }
+
+    for (size_t i = 54; i < 74; i++) {
+        out[i] = (uint8_t)xorshift64(rng);
+    }
+    put_le(&out[74], rnd(rng, 1u << 20), 8);
+    len = 82;
+    if (out[53] == TX_TYPE_CALL) {
+        /* Oversized streams run past MAX_TX_SIZE */
+        size_t data_len = big ? MAX_TX_SIZE - 86 + rnd(rng, 2) * rnd(rng, 1024) : rnd(rng, 400);
+        put_le(&out[82], data_len, 4);
+        len = 86;
+        for (size_t i = 0; i < data_len && len < GEN_MAX_STREAM; i++) {
+            out[len++] = (uint8_t)i;
+        }
+    }
+    return len;
+}
+
+/* Path and stream as SIGN_TX / SIGN_MERKLE chunks, with occasional damage */
+static void gen_session(uint64_t *rng, gen_script_t *s, uint8_t ins) {
+    static uint8_t stream[GEN_MAX_STREAM + 4 * 512];
+    uint8_t path[1 + 4 * (MAX_BIP32_PATH_LEN + 2)];
+    size_t path_len = gen_path(rng, path);
+    size_t len = 0;
+    bool big = rnd(rng, 40) == 0;
+    size_t txs = (ins == INS_SIGN_MERKLE && !big) ? 1 + rnd(rng, 4) : 1;
+
+    for (size_t t = 0; t < txs; t++) {
+        len += gen_tx(rng, &stream[len], big);
+    }
+    if (rnd(rng, 8) == 0) {
+        len = rnd(rng, len + 1);                       /* Truncated stream */
+    } else if (rnd(rng, 8) == 0) {
+        stream[rnd(rng, len)] ^= (uint8_t)(1 + rnd(rng, 255));
+    }
+
+    size_t off = 0;
+    bool first = true;
+    do {
+        size_t room = first ? GEN_CHUNK_MAX - path_len : GEN_CHUNK_MAX;
+        size_t take = 1 + rnd(rng, (rnd(rng, 4) == 0) ? room : (room < 64 ? room : 64));
+        if (big) {
+            take = room;
+        }
+        if (take > len - off) {
+            take = len - off;
+        }
+        bool last = (off + take == len);
+
+        gen_apdu_t *a = script_add(s, ins, first ? P1_FIRST_CHUNK : P1_MORE_CHUNK,
+                                   last ? P2_LAST_CHUNK : P2_MORE_CHUNKS);
+        if (a == NULL) {
+            return;
+        }
+        if (first) {
+            memcpy(a->data, path, path_len);
+            a->lc = (uint8_t)path_len;
+        }
+        memcpy(&a->data[a->lc], &stream[off], take);
+        a->lc = (uint8_t)(a->lc + take);
+
+        switch (rnd(rng, 40)) {
+            case 0: a->p1 = (uint8_t)xorshift64(rng); break;          /* Bad P1 */
+            case 1: a->p2 ^= P2_MORE_CHUNKS; break;                     /* Early/late last */
+            case 2: s->count--; break;                                  /* Dropped chunk */
+            default: break;
+        }
+
+        off += take;
+        first = false;
+    } while (off < len);
+}
+
+static void gen_other(uint64_t *rng, gen_script_t *s) {
+    uint8_t path[1 + 4 * (MAX_BIP32_PATH_LEN + 2)];
+    gen_apdu_t *a;
+
+    switch (rnd(rng, 7)) {
+        case 0:
+            /* SIGN_HASH: path, header, digest (sometimes the wrong length) */
+            if ((a = script_add(s, INS_SIGN_HASH, 0, 0)) != NULL) {
+                a->lc = (uint8_t)gen_path(rng, path);
+                memcpy(a->data, path, a->lc);
+                for (size_t i = 0; i < SIGN_HASH_HEADER_LEN + HASH_LEN - rnd(rng, 2); i++) {
+                    a->data[a->lc++] = (uint8_t)xorshift64(rng);
+                }
+            }
+            break;
+        case 1:
+        case 2:
+            if ((a = script_add(s, INS_RESUME, 0, 0)) != NULL && rnd(rng, 2)) {
+                a->lc = (uint8_t)gen_path(rng, path);
+                memcpy(a->data, path, a->lc);
+            }
+            break;
+        case 3: {
+            static const uint8_t path_ins[] = { INS_GET_PUBLIC_KEY, INS_GET_ADDRESS, INS_GET_XPUB };
+            if ((a = script_add(s, path_ins[rnd(rng, 3)], 0, 0)) != NULL) {
+                a->lc = (uint8_t)gen_path(rng, path);
+                memcpy(a->data, path, a->lc);
+            }
+            break;
+        }
+        case 4:
+            /* Time passes: may expire the cached signature */
+            if ((a = script_add(s, INS_GET_VERSION, 0, 0)) != NULL) {
+                a->ctl = (uint8_t)(FUZZ_CTL_TICK | (rnd(rng, 32) << 2));
+            }
+            break;
+        default:
+            /* Anything: random CLA, INS, P1/P2 and data */
+            if ((a = script_add(s, (uint8_t)rnd(rng, 16), (uint8_t)xorshift64(rng),
+                                (uint8_t)xorshift64(rng))) != NULL) {
+                a->ctl = (uint8_t)rnd(rng, 2);
+                a->lc = (uint8_t)rnd(rng, 64);
+                for (size_t i = 0; i < a->lc; i++) {
+                    a->data[i] = (uint8_t)xorshift64(rng);
+                }
+            }
+            break;
+    }
+}
+
+/* Two scripts merged in random order: sessions interleave */
+static size_t generate(uint64_t *rng, uint8_t *out, size_t cap) {
+    static gen_script_t scripts[2];
+    size_t len = 0;
+
+    out[len++] = (uint8_t)rnd(rng, 4);
+
+    for (int k = 0; k < 2; k++) {
+        gen_script_t *s = &scripts[k];
+        s->count = 0;
+        for (uint64_t n = 1 + rnd(rng, 4); n > 0; n--) {
+            switch (rnd(rng, 5)) {
+                case 0:
+                case 1: gen_session(rng, s, INS_SIGN_TX); break;
+                case 2: gen_session(rng, s, INS_SIGN_MERKLE); break;
+                default: gen_other(rng, s); break;
+            }
+            /* A re-sent transaction exercises the signature cache */
+            if (s->count > 0 && s->count < GEN_MAX_APDUS / 2 && rnd(rng, 6) == 0) {
+                memcpy(&s->apdus[s->count], s->apdus, s->count * sizeof(s->apdus[0]));
+                s->count *= 2;
+            }
+        }
+    }
+
+    size_t next[2] = { 0, 0 };
+    bool interleave = rnd(rng, 3) == 0;
+    while (next[0] < scripts[0].count || next[1] < scripts[1].count) {
+        int k = (next[0] == scripts[0].count) ? 1
+              : (next[1] == scripts[1].count) ? 0
+              : interleave ? (int)rnd(rng, 2) : 0;
+        const gen_apdu_t *a = &scripts[k].apdus[next[k]++];
+        if (len + FUZZ_RECORD_HEADER + a->lc > cap) {
+            break;
+        }
+        out[len++] = a->ctl;
+        out[len++] = a->ins;
+        out[len++] = a->p1;
+        out[len++] = a->p2;
+        out[len++] = a->lc;
+        memcpy(&out[len], a->data, a->lc);
+        len += a->lc;
+    }
+
+    /* Sometimes cut the last record short */
+    if (len > 1 && rnd(rng, 10) == 0) {
+        len -= rnd(rng, len < 8 ? len : 8);
+    }
+    return len;
+}
+
+static size_t count_records(const uint8_t *data, size_t size) {
+    size_t n = 0;
+    for (size_t pos = 1; pos + FUZZ_RECORD_HEADER <= size; n++) {
+        pos += FUZZ_RECORD_HEADER + data[pos + 4];
+    }
+    return n;
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char **argv) {
+    unsigned long iterations = 2000;
+    uint64_t rng = 0x5eed;
+    size_t apdus = 0;
+    int files = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            iterations = strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            /* xorshift64 needs a non-zero state; keep every seed distinct */
+            rng = strtoull(argv[++i], NULL, 0) * 0x9E3779B97F4A7C15ull + 0x5eed;
+        } else {
+            FILE *f = fopen(argv[i], "rb");
+            if (f == NULL) {
+                fprintf(stderr, "fuzz_apdu: cannot open %s\n", argv[i]);
+                return 1;
+            }
+            size_t len = fread(g_buf, 1, sizeof(g_buf), f);
+            fclose(f);
+            g_input_name = argv[i];
+            LLVMFuzzerTestOneInput(g_buf, len);
+            printf("%s: ok (%zu APDUs)\n", argv[i], count_records(g_buf, len));
+            files++;
+        }
+    }
+    if (files > 0) {
+        return 0;
+    }
+
+    double start = now_seconds();
+    for (unsigned long i = 0; i < iterations; i++) {
+        size_t len = generate(&rng, g_buf, sizeof(g_buf));
+        LLVMFuzzerTestOneInput(g_buf, len);
+        apdus += count_records(g_buf, len);
+    }
+    double elapsed = now_seconds() - start;
+
+    printf("fuzz_apdu: %lu inputs, %zu APDUs, %.2f s, %.0f execs/s, %.0f APDUs/s\n",
+           iterations, apdus, elapsed,
+           elapsed > 0 ? (double)iterations / elapsed : 0.0,
+           elapsed > 0 ? (double)apdus / elapsed : 0.0);
+
+    return 0;
+}
+
+#endif /* FUZZ_STANDALONE */
@@ -0,0 +1,524 @@
+/*
+ * SUM Chain Ledger App - Differential Chunk-Boundary Fuzzer for tx_parser
+ *
+ * Every input is treated as a transaction stream and decoded
+ *   - by tx_parser_consume in one call (looping over the early returns
+ *     after multi-transfer pairs),
+ *   - by a reference decoder written straight from the format comment in
+ *     src/tx_parser.c (whole buffer, no state machine),
+ *   - by tx_parser_consume in many chunkings: every fixed chunk size up to
+ *     FUZZ_MAX_FIXED_CHUNK, every two-way split for inputs up to
+ *     FUZZ_MAX_SPLIT_LEN bytes, and FUZZ_RANDOM_PATTERNS random patterns
+ *     seeded from the input.
+ * All decodes must agree on the outcome (done / error / needs more), the
+ * bytes consumed, every parsed field and the sequence of multi-transfer
+ * pairs reported through tx_parser_pair_ready. Any mismatch aborts.
+ *
+ * libFuzzer (clang):  make -C tests fuzz
+ *                     ./fuzz_tx_parser -max_len=70000 corpus/
+ * Standalone (gcc):   make -C tests fuzz-replay
+ *                     ./fuzz_tx_parser_replay [-n iterations] [-s seed] [file...]
+ *
+ * The standalone build replays the given files (e.g. libFuzzer crash
+ * artifacts) or, without files, generates mutated transactions of every
+ * type. It prints execs/s so parser fast paths can be measured against the
+ * same differential checks.
+ */
+
+#include "tx_parser.h"
+#include "tx_display.h"
+#include "crypto/sum_blake3.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Global state (normally in main.c); only linked in for address.c */
+app_state_t G_app_state;
+
+#define FUZZ_MAX_FIXED_CHUNK   64
+#define FUZZ_MAX_SPLIT_LEN     512
+#define FUZZ_RANDOM_PATTERNS   4
+#define FUZZ_MAX_INPUT         (MAX_TX_SIZE + 64)
+
+/* Wire layout (see src/tx_parser.c) */
+#define OFF_TX_TYPE            53
+#define TRANSFER_LEN           82
+#define CALL_HEADER_LEN        86
+#define MULTI_HEADER_LEN       56
+#define MULTI_PAIR_LEN         28
+
+typedef enum {
+    OUTCOME_MORE = 0,                      /* Input ended before the tx did */
+    OUTCOME_DONE,
+    OUTCOME_ERROR
+} outcome_t;
+
+typedef struct {
+    outcome_t   outcome;
+    size_t      consumed;                  /* Bytes accepted, including a failing field */
+    tx_parsed_t parsed;
+    uint32_t    pairs;                     /* Multi-transfer pairs reported */
+    uint64_t    pair_digest;               /* FNV-1a over (index, recipient, amount) */
+} fuzz_result_t;
+
+typedef enum {
+    CHUNK_ONE_SHOT = 0,
+    CHUNK_FIXED,
+    CHUNK_SPLIT,
+    CHUNK_RANDOM
+} chunk_kind_t;
+
+typedef struct {
+    chunk_kind_t kind;
+    size_t       arg;                      /* Chunk size, split point or unused */
+    uint64_t     rng;                      /* CHUNK_RANDOM state */
+    size_t       calls;
+} chunker_t;
+
+static uint64_t fnv1a(uint64_t h, const uint8_t *data, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        h ^= data[i];
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+static uint64_t xorshift64(uint64_t *state) {
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+static void record_pair(fuzz_result_t *r, uint16_t index, const uint8_t recipient[ADDRESS_LEN],
+                        uint64_t amount) {
+    uint8_t buf[2 + ADDRESS_LEN + 8];
+
+    buf[0] = (uint8_t)index;
+    buf[1] = (uint8_t)(index >> 8);
+    memcpy(&buf[2], recipient, ADDRESS_LEN);
+    for (int i = 0; i < 8; i++) {
+        buf[2 + ADDRESS_LEN + i] = (uint8_t)(amount >> (i * 8));
+    }
+    r->pair_digest = fnv1a(r->pair_digest, buf, sizeof(buf));
+    r->pairs++;
+}
+
+static size_t next_chunk(chunker_t *ch, size_t remaining) {
+    size_t n;
+
+    switch (ch->kind) {
+        case CHUNK_FIXED:
+            n = ch->arg;
+            break;
+        case CHUNK_SPLIT:
+            n = (ch->calls == 0 && ch->arg > 0) ? ch->arg : remaining;
+            break;
+        case CHUNK_RANDOM:
+            /* Mostly small, sometimes larger than one APDU */
+            n = 1 + (size_t)(xorshift64(&ch->rng) % ((ch->calls & 3) ? 32 : 300));
+            break;
+        default:
+            n = remaining;
+            break;
+    }
+    ch->calls++;
+    return (n < remaining) ? n : remaining;
+}
+
+/* Decode with tx_parser_consume, feeding chunks chosen by `ch` */
+static void run_parser(const uint8_t *data, size_t len, chunker_t *ch, fuzz_result_t *r) {
+    static tx_parser_ctx_t ctx;
+    size_t offset = 0;
+
+    memset(r, 0, sizeof(*r));
+    r->pair_digest = 0xcbf29ce484222325ULL;
+    tx_parser_init(&ctx);
+
+    while (offset < len && !tx_parser_is_done(&ctx) && !tx_parser_has_error(&ctx)) {
+        size_t end = offset + next_chunk(ch, len - offset);
+
+        while (offset < end) {
+            size_t consumed = tx_parser_consume(&ctx, &data[offset], end - offset);
+            offset += consumed;
+            if (tx_parser_pair_ready(&ctx)) {
+                const tx_parsed_t *p = tx_parser_get_parsed(&ctx);
+                record_pair(r, p->recipient_index, p->recipient, p->amount);
+            }
+            if (consumed == 0 || tx_parser_is_done(&ctx) || tx_parser_has_error(&ctx)) {
+                break;
+            }
+        }
+    }
+
+    r->outcome = tx_parser_has_error(&ctx) ? OUTCOME_ERROR
+               : tx_parser_is_done(&ctx)   ? OUTCOME_DONE
+               : OUTCOME_MORE;
+    r->consumed = ctx.total_consumed;
+    r->parsed = ctx.parsed;
+}
+
+/*
+ * Reference decoder
+ */
+
+typedef struct {
+    const uint8_t *data;
+    size_t         len;
+    size_t         pos;
+} ref_cursor_t;
+
+static bool ref_take(ref_cursor_t *c, size_t n, const uint8_t **field) {
+    if (c->len - c->pos < n) {
+        return false;
+    }
+    *field = &c->data[c->pos];
+    c->pos += n;
+    return true;
+}
+
+static uint64_t ref_le(const uint8_t *p, size_t n) {
+    uint64_t v = 0;
+    for (size_t i = n; i > 0; i--) {
+        v = (v << 8) | p[i - 1];
+    }
+    return v;
+}
+
+static void ref_decode(const uint8_t *data, size_t len, fuzz_result_t *r) {
+    ref_cursor_t c = { data, len, 0 };
+    tx_parsed_t *t = &r->parsed;
+    const uint8_t *f;
+
+    memset(r, 0, sizeof(*r));
+    r->pair_digest = 0xcbf29ce484222325ULL;
+    r->outcome = OUTCOME_MORE;
+    r->consumed = len;
+
+#define TAKE(n) do { if (!ref_take(&c, (n), &f)) return; } while (0)
+#define FAIL()  do { r->outcome = OUTCOME_ERROR; r->consumed = c.pos; return; } while (0)
+
+    TAKE(1); t->version = f[0];
+    if (t->version != 1) FAIL();
+    TAKE(8); t->chain_id = ref_le(f, 8);
+    TAKE(ADDRESS_LEN); memcpy(t->sender, f, ADDRESS_LEN);
+    TAKE(8); t->nonce = ref_le(f, 8);
+    TAKE(8); t->gas_price = ref_le(f, 8);
+    TAKE(8); t->gas_limit = ref_le(f, 8);
+    TAKE(1); t->tx_type = f[0];
+
+    unsigned __int128 total = 0;
+
+    if (t->tx_type == TX_TYPE_TRANSFER || t->tx_type == TX_TYPE_CALL) {
+        TAKE(ADDRESS_LEN); memcpy(t->recipient, f, ADDRESS_LEN);
+        TAKE(8); t->amount = ref_le(f, 8);
+        total = t->amount;
+        if (t->tx_type == TX_TYPE_CALL) {
+            TAKE(4); t->data_len = (uint32_t)ref_le(f, 4);
+            if (t->data_len > MAX_TX_SIZE - CALL_HEADER_LEN) FAIL();
+            TAKE(t->data_len);
+            sum_blake3_hash(f, t->data_len, t->data_hash);
+        }
+    } else if (t->tx_type == TX_TYPE_MULTI_TRANSFER) {
+        TAKE(2); t->recipient_count = (uint16_t)ref_le(f, 2);
+        if (t->recipient_count == 0 ||
+            (size_t)t->recipient_count * MULTI_PAIR_LEN > MAX_TX_SIZE - MULTI_HEADER_LEN) FAIL();
+        for (uint16_t i = 0; i < t->recipient_count; i++) {
+            TAKE(ADDRESS_LEN); memcpy(t->recipient, f, ADDRESS_LEN);
+            TAKE(8); t->amount = ref_le(f, 8);
+            total += t->amount;
+            t->recipient_index = (uint16_t)(i + 1);
+            t->total_amount_lo = (uint64_t)total;
+            t->total_amount_hi = (uint64_t)(total >> 64);
+            record_pair(r, t->recipient_index, t->recipient, t->amount);
+        }
+    } else {
+        FAIL();
+    }
+
+#undef TAKE
+#undef FAIL
+
+    unsigned __int128 fee = (unsigned __int128)t->gas_price * t->gas_limit;
+    t->fee_low = (uint64_t)fee;
+    t->fee_high = (uint64_t)(fee >> 64);
+    t->fee_overflow = (t->fee_high != 0);
+    t->total_amount_lo = (uint64_t)total;
+    t->total_amount_hi = (uint64_t)(total >> 64);
+
+    r->outcome = OUTCOME_DONE;
+    r->consumed = c.pos;
+}
+
+/*
+ * Comparison
+ */
+
+static const char *g_input_name = "(generated)";
+static const uint8_t *g_input;
+static size_t g_input_len;
+
+static void mismatch(const char *what, const char *how) {
+    fprintf(stderr, "fuzz_tx_parser: %s differs (%s) for input %s\n", what, how, g_input_name);
+#ifdef FUZZ_STANDALONE
+    /* libFuzzer saves its own crash artifacts */
+    FILE *f = fopen("crash-tx_parser.bin", "wb");
+    if (f != NULL) {
+        fwrite(g_input, 1, g_input_len, f);
+        fclose(f);
+        fprintf(stderr, "fuzz_tx_parser: input saved to crash-tx_parser.bin\n");
+    }
+#endif
+    abort();
+}
+
+/* Fields a finished tx must agree on (partial decodes only fill a prefix) */
+static void compare_parsed(const tx_parsed_t *a, const tx_parsed_t *b, const char *how) {
+    if (a->version != b->version || a->chain_id != b->chain_id ||
+        memcmp(a->sender, b->sender, ADDRESS_LEN) != 0 || a->nonce != b->nonce ||
+        a->gas_price != b->gas_price || a->gas_limit != b->gas_limit || a->tx_type != b->tx_type) {
+        mismatch("header", how);
+    }
+    if (memcmp(a->recipient, b->recipient, ADDRESS_LEN) != 0 || a->amount != b->amount ||
+        a->total_amount_lo != b->total_amount_lo || a->total_amount_hi != b->total_amount_hi) {
+        mismatch("recipient/amount", how);
+    }
+    if (a->data_len != b->data_len || memcmp(a->data_hash, b->data_hash, HASH_LEN) != 0) {
+        mismatch("call data", how);
+    }
+    if (a->recipient_count != b->recipient_count || a->recipient_index != b->recipient_index) {
+        mismatch("recipient count", how);
+    }
+    if (a->fee_low != b->fee_low || a->fee_high != b->fee_high || a->fee_overflow != b->fee_overflow) {
+        mismatch("fee", how);
+    }
+}
+
+static void compare_results(const fuzz_result_t *a, const fuzz_result_t *b, const char *how) {
+    if (a->outcome != b->outcome) {
+        mismatch("outcome", how);
+    }
+    if (a->consumed != b->consumed) {
+        mismatch("bytes consumed", how);
+    }
+    if (a->pairs != b->pairs || a->pair_digest != b->pair_digest) {
+        mismatch("reported pairs", how);
+    }
+    if (a->outcome == OUTCOME_DONE) {
+        compare_parsed(&a->parsed, &b->parsed, how);
+    }
+}
+
+static void check_chunking(const uint8_t *data, size_t len, chunker_t *ch,
+                           const fuzz_result_t *expected, const char *how) {
+    static fuzz_result_t r;
+
+    run_parser(data, len, ch, &r);
+    compare_results(&r, expected, how);
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    static fuzz_result_t ref, one_shot;
+    chunker_t ch;
+
+    if (size > FUZZ_MAX_INPUT) {
+        return 0;
+    }
+    g_input = data;
+    g_input_len = size;
+
+    ref_decode(data, size, &ref);
+
+    memset(&ch, 0, sizeof(ch));
+    run_parser(data, size, &ch, &one_shot);
+    compare_results(&one_shot, &ref, "one-shot vs reference");
+
+    if (one_shot.outcome == OUTCOME_DONE) {
+        static tx_display_t display;
+        if (!tx_display_format(&one_shot.parsed, &display)) {
+            mismatch("display", "tx_display_format failed on a parsed tx");
+        }
+    }
+
+    for (size_t k = 1; k <= FUZZ_MAX_FIXED_CHUNK && k < size; k++) {
+        memset(&ch, 0, sizeof(ch));
+        ch.kind = CHUNK_FIXED;
+        ch.arg = k;
+        check_chunking(data, size, &ch, &one_shot, "fixed chunk size");
+    }
+
+    if (size <= FUZZ_MAX_SPLIT_LEN) {
+        for (size_t split = 1; split < size; split++) {
+            memset(&ch, 0, sizeof(ch));
+            ch.kind = CHUNK_SPLIT;
+            ch.arg = split;
+            check_chunking(data, size, &ch, &one_shot, "two-way split");
+        }
+    }
+
+    uint64_t seed = fnv1a(0xcbf29ce484222325ULL, data, size) | 1;
+    for (int i = 0; i < FUZZ_RANDOM_PATTERNS; i++) {
+        memset(&ch, 0, sizeof(ch));
+        ch.kind = CHUNK_RANDOM;
+        ch.rng = seed + 2 * (uint64_t)i;
+        check_chunking(data, size, &ch, &one_shot, "random pattern");
+    }
+
+    return 0;
+}
+
+#ifdef FUZZ_STANDALONE
+
+#include <time.h>
+
+static uint8_t g_buf[FUZZ_MAX_INPUT];
+
+static void put_le(uint8_t *p, uint64_t v, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        p[i] = (uint8_t)(v >> (i * 8));
+    }
+}
+
+static uint64_t rand_u64(uint64_t *rng) {
+    /* Bias toward edge values: zero, small, all ones */
+    switch (xorshift64(rng) % 8) {
+        case 0:  return 0;
+        case 1:  return xorshift64(rng) % 1000;
+        case 2:  return UINT64_MAX - (xorshift64(rng) % 4);
+        default: return xorshift64(rng);
+    }
+}
+
+/* A valid transaction of a random type, then random damage */
+static size_t generate(uint64_t *rng, uint8_t *out, size_t cap) {
+    size_t len;
+
+    out[0] = 1;
+    put_le(&out[1], rand_u64(rng), 8);
+    for (size_t i = 9; i < 29; i++) {
+        out[i] = (uint8_t)xorshift64(rng);
+    }
+    put_le(&out[29], rand_u64(rng), 8);
+    put_le(&out[37], rand_u64(rng), 8);
+    put_le(&out[45], rand_u64(rng), 8);
+    out[OFF_TX_TYPE] = (uint8_t)(xorshift64(rng) % 3);
+
+    if (out[OFF_TX_TYPE] == TX_TYPE_MULTI_TRANSFER) {
+        size_t count = (xorshift64(rng) % 16 == 0)
+                     ? 1 + xorshift64(rng) % ((MAX_TX_SIZE - MULTI_HEADER_LEN) / MULTI_PAIR_LEN)
+                     : 1 + xorshift64(rng) % 40;
+        put_le(&out[54], count, 2);
+        len = MULTI_HEADER_LEN;
+        for (size_t i = 0; i < count; i++) {
+            for (size_t b = 0; b < ADDRESS_LEN; b++) {
+                out[len++] = (uint8_t)xorshift64(rng);
+            }
+            put_le(&out[len], rand_u64(rng), 8);
+            len += 8;
+        }
+    } else {
+        for (size_t i = 54; i < 74; i++) {
+            out[i] = (uint8_t)xorshift64(rng);
+        }
+        put_le(&out[74], rand_u64(rng), 8);
+        len = TRANSFER_LEN;
+        if (out[OFF_TX_TYPE] == TX_TYPE_CALL) {
+            size_t data_len = (xorshift64(rng) % 16 == 0)
+                            ? xorshift64(rng) % (MAX_TX_SIZE - CALL_HEADER_LEN + 1)
+                            : xorshift64(rng) % 600;
+            put_le(&out[82], data_len, 4);
+            len = CALL_HEADER_LEN;
+            for (size_t i = 0; i < data_len; i++) {
+                out[len++] = (uint8_t)xorshift64(rng);
+            }
+        }
+    }
+
+    /* Damage: flip bytes (often in the header), truncate, or append */
+    switch (xorshift64(rng) % 4) {
+        case 0: {
+            size_t flips = 1 + xorshift64(rng) % 4;
+            for (size_t i = 0; i < flips; i++) {
+                size_t at = (xorshift64(rng) & 1) ? xorshift64(rng) % (MULTI_HEADER_LEN + 32)
+                                                  : xorshift64(rng) % len;
+                if (at < len) {
+                    out[at] ^= (uint8_t)(1 + xorshift64(rng) % 255);
+                }
+            }
+            break;
+        }
+        case 1:
+            len = xorshift64(rng) % (len + 1);
+            break;
+        case 2: {
+            size_t extra = 1 + xorshift64(rng) % 32;
+            for (size_t i = 0; i < extra && len < cap; i++) {
+                out[len++] = (uint8_t)xorshift64(rng);
+            }
+            break;
+        }
+        default:
+            break;
+    }
+
+    return len;
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char **argv) {
+    unsigned long iterations = 20000;
+    uint64_t rng = 0x5eed;
+    unsigned long outcomes[3] = { 0, 0, 0 };
+    size_t bytes = 0;
+    int files = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            iterations = strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            rng = strtoull(argv[++i], NULL, 0) | 1;
+        } else {
+            FILE *f = fopen(argv[i], "rb");
+            if (f == NULL) {
+                fprintf(stderr, "fuzz_tx_parser: cannot open %s\n", argv[i]);
+                return 1;
+            }
+            size_t len = fread(g_buf, 1, sizeof(g_buf), f);
+            fclose(f);
+            g_input_name = argv[i];
+            LLVMFuzzerTestOneInput(g_buf, len);
+            printf("%s: ok (%zu bytes)\n", argv[i], len);
+            files++;
+        }
+    }
+    if (files > 0) {
+        return 0;
+    }
+
+    fuzz_result_t ref;
+    double start = now_seconds();
+    for (unsigned long i = 0; i < iterations; i++) {
+        size_t len = generate(&rng, g_buf, sizeof(g_buf));
+        LLVMFuzzerTestOneInput(g_buf, len);
+        ref_decode(g_buf, len, &ref);
+        outcomes[ref.outcome]++;
+        bytes += len;
+    }
+    double elapsed = now_seconds() - start;
+
+    printf("fuzz_tx_parser: %lu inputs, %zu bytes, %.2f s, %.0f execs/s\n",
+           iterations, bytes, elapsed, elapsed > 0 ? (double)iterations / elapsed : 0.0);
+    printf("  outcomes: done %lu, error %lu, incomplete %lu\n",
+           outcomes[OUTCOME_DONE], outcomes[OUTCOME_ERROR], outcomes[OUTCOME_MORE]);
+
+    return 0;
+}
+
+#endif /* FUZZ_STANDALONE */
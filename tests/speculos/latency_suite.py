@@ -0,0 +1,293 @@
+#!/usr/bin/env python3
+"""
+SUM Chain Ledger App - end-to-end latency suite (Speculos).
+
+Boots bin/app.elf in a headless Speculos emulator and drives the device
+path (io loop, apdu_dispatch, parser, hashing) through the Speculos REST
+API:
+
+  get_address       GET_ADDRESS, no display
+  sign_tx_stream    call with 1200 data bytes: every SIGN_TX chunk except
+                    the last, which would open the review
+
+Reviewed APDUs are left out. On the device tx_display_show_approval()
+returns as soon as the flow is started, before the user decides, so the
+last SIGN_TX chunk is answered 0x6985 without a review; its latency and
+status say nothing about signing. Add signing scenarios once approvals
+reply asynchronously (see README "Known Limitations").
+
+Each scenario runs --runs times; medians are compared with the baseline
+file. A latency regresses when it exceeds baseline * (1 + --tolerance) +
+--slack-ms. With no baseline file, or with --update-baseline, the results
+are written as the new baseline.
+
+Usage (normally through `make test-speculos-latency`):
+  latency_suite.py --elf ../bin/app.elf --baseline speculos/latency_baseline.json
+  latency_suite.py --api-url http://127.0.0.1:5000 ...   # attach, don't launch
+"""
+
+import argparse
+import json
+import os
+import statistics
+import struct
+import subprocess
+import sys
+import time
+import urllib.error
+import urllib.request
+
+CLA = 0xE0
+INS_GET_ADDRESS = 0x03
+INS_SIGN_TX = 0x04
+P1_FIRST_CHUNK = 0x00
+P1_MORE_CHUNKS = 0x80
+P2_LAST_CHUNK = 0x00
+P2_MORE_CHUNKS = 0x80
+SW_OK = 0x9000
+MAX_APDU_DATA = 255
+
+TX_TYPE_TRANSFER = 0x00
+TX_TYPE_CALL = 0x01
+
+HARDENED = 0x80000000
+PATH = [HARDENED | 44, HARDENED | 12345, HARDENED, HARDENED, HARDENED]
+
+APDU_TIMEOUT = 60.0
+
+
+class SuiteError(Exception):
+    pass
+
+
+# ---------------------------------------------------------------------------
+# Encoding (README "Transaction Format", "SIGN_TX")
+
+def encode_path(path):
+    return bytes([len(path)]) + b"".join(struct.pack(">I", p) for p in path)
+
+
+def encode_tx(tx_type, nonce, amount, data=None):
+    tx = bytes([1])                              # version
+    tx += struct.pack("<Q", 1)                   # chain_id
+    tx += bytes([0x11]) * 20                     # sender
+    tx += struct.pack("<QQQ", nonce, 10, 21000)  # nonce, gas_price, gas_limit
+    tx += bytes([tx_type])
+    tx += bytes([0x22]) * 20                     # recipient
+    tx += struct.pack("<Q", amount)
+    if tx_type == TX_TYPE_CALL:
+        tx += struct.pack("<I", len(data)) + data
+    return tx
+
+
+def sign_tx_apdus(tx):
+    """SIGN_TX chunks: path + tx bytes, each APDU at most 255 data bytes."""
+    first = encode_path(PATH)
+    body = first + tx
+    chunks = [body[:MAX_APDU_DATA]]
+    pos = MAX_APDU_DATA
+    while pos < len(body):
+        chunks.append(body[pos:pos + MAX_APDU_DATA])
+        pos += MAX_APDU_DATA
+
+    apdus = []
+    for i, chunk in enumerate(chunks):
+        p1 = P1_FIRST_CHUNK if i == 0 else P1_MORE_CHUNKS
+        p2 = P2_LAST_CHUNK if i == len(chunks) - 1 else P2_MORE_CHUNKS
+        apdus.append(bytes([CLA, INS_SIGN_TX, p1, p2, len(chunk)]) + chunk)
+    return apdus
+
+
+def get_address_apdu():
+    data = encode_path(PATH)
+    return bytes([CLA, INS_GET_ADDRESS, 0x00, 0x00, len(data)]) + data
+
+
+# ---------------------------------------------------------------------------
+# Speculos REST client
+
+class Speculos:
+    def __init__(self, api_url):
+        self.api_url = api_url.rstrip("/")
+
+    def _request(self, method, path, body=None, timeout=APDU_TIMEOUT):
+        data = json.dumps(body).encode() if body is not None else None
+        req = urllib.request.Request(self.api_url + path, data=data, method=method,
+                                     headers={"Content-Type": "application/json"})
+        with urllib.request.urlopen(req, timeout=timeout) as resp:
+            payload = resp.read()
+        return json.loads(payload) if payload else None
+
+    def wait_ready(self, timeout):
+        deadline = time.monotonic() + timeout
+        while time.monotonic() < deadline:
+            try:
+                self._request("GET", "/events?currentscreenonly=true", timeout=1.0)
+                return
+            except (urllib.error.URLError, ConnectionError, OSError):
+                time.sleep(0.2)
+        raise SuiteError("Speculos API not reachable at %s" % self.api_url)
+
+    def exchange(self, apdu):
+        """Returns (response data, status word)."""
+        resp = self._request("POST", "/apdu", {"data": apdu.hex()})
+        raw = bytes.fromhex(resp["data"])
+        if len(raw) < 2:
+            raise SuiteError("short APDU response")
+        return raw[:-2], (raw[-2] << 8) | raw[-1]
+
+
+# ---------------------------------------------------------------------------
+# Scenarios
+
+def run_apdus(dev, apdus):
+    """Sends the APDUs in order, each expected to return 0x9000.
+    Returns one {"latency_ms": ...} record per APDU."""
+    records = []
+    for i, apdu in enumerate(apdus):
+        start = time.monotonic()
+        data, sw = dev.exchange(apdu)
+        records.append({"latency_ms": (time.monotonic() - start) * 1000.0})
+        if sw != SW_OK:
+            raise SuiteError("APDU %d returned 0x%04X" % (i, sw))
+    return records, data
+
+
+def scenario_get_address(dev, run):
+    records, data = run_apdus(dev, [get_address_apdu()])
+    if not data:
+        raise SuiteError("GET_ADDRESS returned no address")
+    return records
+
+
+def scenario_sign_stream(dev, run):
+    payload = bytes((i * 7 + run) & 0xFF for i in range(1200))
+    apdus = sign_tx_apdus(encode_tx(TX_TYPE_CALL, run, 5, payload))
+    # The session is abandoned; the next first chunk resets it
+    records, _ = run_apdus(dev, apdus[:-1])
+    return records
+
+
+SCENARIOS = [
+    ("get_address", scenario_get_address),
+    ("sign_tx_stream", scenario_sign_stream),
+]
+
+
+# ---------------------------------------------------------------------------
+# Aggregation and baseline
+
+def summarize(runs):
+    """Per-APDU medians over the runs of one scenario."""
+    out = []
+    for i in range(len(runs[0])):
+        apdu = {}
+        for key in runs[0][i]:
+            values = [r[i][key] for r in runs]
+            apdu[key] = round(statistics.median(values), 2)
+        out.append(apdu)
+    return out
+
+
+def compare(results, baseline, tolerance, slack_ms):
+    failures = []
+    for name, apdus in results.items():
+        base = baseline.get(name)
+        if base is None:
+            print("  %s: not in baseline" % name)
+            continue
+        if len(base) != len(apdus):
+            failures.append("%s: %d APDUs, baseline has %d" % (name, len(apdus), len(base)))
+            continue
+        for i, (cur, ref) in enumerate(zip(apdus, base)):
+            for key, value in cur.items():
+                if key not in ref:
+                    continue
+                if value > ref[key] * (1.0 + tolerance) + slack_ms:
+                    failures.append("%s[%d]: %s %.2f ms, baseline %.2f ms" %
+                                    (name, i, key, value, ref[key]))
+    return failures
+
+
+def print_results(results):
+    for name, apdus in results.items():
+        for i, apdu in enumerate(apdus):
+            fields = "  ".join("%s=%s" % (k, v) for k, v in apdu.items())
+            print("  %-16s apdu %-2d %s" % (name, i, fields))
+
+
+def launch(args):
+    cmd = [args.speculos, "--model", args.model, "--display", "headless",
+           "--api-port", str(args.api_port), "--apdu-port", "0", args.elf]
+    log = open(os.devnull, "w")
+    return subprocess.Popen(cmd, stdout=log, stderr=log)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__,
+                                 formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("--elf", default="bin/app.elf")
+    ap.add_argument("--model", default="nanosp")
+    ap.add_argument("--speculos", default="speculos")
+    ap.add_argument("--api-port", type=int, default=5000)
+    ap.add_argument("--api-url", help="attach to a running Speculos instead of launching")
+    ap.add_argument("--baseline", default="tests/speculos/latency_baseline.json")
+    ap.add_argument("--update-baseline", action="store_true")
+    ap.add_argument("--runs", type=int, default=5)
+    ap.add_argument("--tolerance", type=float, default=0.25)
+    ap.add_argument("--slack-ms", type=float, default=5.0)
+    ap.add_argument("--out", help="also write this run's results here")
+    args = ap.parse_args()
+
+    proc = None
+    if args.api_url is None:
+        if not os.path.exists(args.elf):
+            print("latency_suite: %s not found (build the app first)" % args.elf, file=sys.stderr)
+            return 1
+        try:
+            proc = launch(args)
+        except OSError as e:
+            print("latency_suite: cannot start %s: %s" % (args.speculos, e), file=sys.stderr)
+            return 1
+        args.api_url = "http://127.0.0.1:%d" % args.api_port
+
+    dev = Speculos(args.api_url)
+    results = {}
+    try:
+        dev.wait_ready(30.0)
+        for name, scenario in SCENARIOS:
+            runs = [scenario(dev, run) for run in range(args.runs)]
+            results[name] = summarize(runs)
+    except (SuiteError, urllib.error.URLError, OSError) as e:
+        print("latency_suite: %s" % e, file=sys.stderr)
+        return 1
+    finally:
+        if proc is not None:
+            proc.terminate()
+            proc.wait()
+
+    print("Speculos latency (%s, median of %d runs):" % (args.model, args.runs))
+    print_results(results)
+
+    if args.out:
+        with open(args.out, "w") as f:
+            json.dump(results, f, indent=2)
+            f.write("\n")
+
+    if args.update_baseline or not os.path.exists(args.baseline):
+        with open(args.baseline, "w") as f:
+            json.dump(results, f, indent=2)
+            f.write("\n")
+        print("Baseline written to %s" % args.baseline)
+        return 0
+
+    with open(args.baseline) as f:
+        baseline = json.load(f)
+    failures = compare(results, baseline, args.tolerance, args.slack_ms)
+    for failure in failures:
+        print("  REGRESSION %s" % failure)
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,185 @@
+/*
+ * SUM Chain Ledger App - APDU Client Integration Test (Speculos)
+ *
+ * Drives one or more Speculos instances concurrently through the host APDU
+ * client. Start each emulator with the approval automation, e.g.:
+ *
+ *   speculos --model nanosp --display headless --apdu-port 9999 \
+ *            --automation file:tests/speculos/approve_all.json bin/app.elf
+ *
+ * then run:
+ *
+ *   SPECULOS_APDU_PORTS=9999,9998 make -C tests test-speculos
+ *
+ * Skipped (exit 0) when SPECULOS_APDU_PORTS is not set.
+ *
+ * Checks that need a signature are expected failures until the on-device
+ * approval replies after the user decides (README "Known Limitations");
+ * build with -DHAVE_ASYNC_APPROVAL to assert them.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+int g_tests_run = 0;
+int g_tests_passed = 0;
+int g_tests_failed = 0;
+
+#include "test_utils.h"
+#include "apdu_client.h"
+#include "sign_scheduler.h"
+#include "tx_encoder.h"
+#include "ed25519.h"
+#include "crypto/sum_blake3.h"
+
+/* Expected failure: reported as XFAIL/XPASS, not counted */
+#ifdef HAVE_ASYNC_APPROVAL
+#define TEST_ASSERT_APPROVED(cond, msg) TEST_ASSERT_TRUE(cond, msg)
+#else
+#define TEST_ASSERT_APPROVED(cond, msg) do { \
+    printf("  %s: %s\n", (cond) ? "XPASS" : "XFAIL", msg); \
+} while(0)
+#endif
+
+#define MAX_INSTANCES 8
+#define SCHED_JOBS    8
+
+/* Call data so the tx spans frame 0 and two full continuation frames, plus a tail */
+#define CALL_DATA_LEN 700
+#define CALL_TX_LEN   (TX_CALL_HEADER_LEN + CALL_DATA_LEN)
+
+int main(void) {
+    const char *ports_env = getenv("SPECULOS_APDU_PORTS");
+    const char *host = getenv("SPECULOS_HOST");
+    apdu_transport_tcp_t transports[MAX_INSTANCES];
+    apdu_device_t devs[MAX_INSTANCES];
+    apdu_device_t *dev_ptrs[MAX_INSTANCES];
+    apdu_request_t name_req[MAX_INSTANCES];
+    apdu_request_t sign_req[MAX_INSTANCES];
+    apdu_request_t pubkey_req[MAX_INSTANCES];
+    apdu_request_t call_req[MAX_INSTANCES];
+    uint8_t txs[MAX_INSTANCES][TX_TRANSFER_ENCODED_LEN];
+    static uint8_t call_txs[MAX_INSTANCES][CALL_TX_LEN];
+    uint8_t call_data[CALL_DATA_LEN];
+    uint8_t path_data[APDU_MAX_DATA_LEN];
+    size_t n = 0;
+    bip32_path_t path;
+
+    if (ports_env == NULL || ports_env[0] == '\0') {
+        printf("SPECULOS_APDU_PORTS not set, skipping Speculos integration test\n");
+        return 0;
+    }
+    if (host == NULL) {
+        host = "127.0.0.1";
+    }
+
+    TEST_SUITE_START("APDU Client (Speculos)");
+
+    make_path(&path, 5, 0);
+    size_t path_len = apdu_serialize_path(&path, path_data, sizeof(path_data));
+    for (size_t i = 0; i < CALL_DATA_LEN; i++) {
+        call_data[i] = (uint8_t)(i * 7);
+    }
+
+    char ports[256];
+    snprintf(ports, sizeof(ports), "%s", ports_env);
+    for (char *tok = strtok(ports, ","); tok != NULL && n < MAX_INSTANCES; tok = strtok(NULL, ",")) {
+        uint16_t port = (uint16_t)atoi(tok);
+        char msg[64];
+        snprintf(msg, sizeof(msg), "Connect to %s:%u", host, (unsigned)port);
+        bool ok = apdu_transport_tcp_open(&transports[n], host, port) == 0;
+        TEST_ASSERT_TRUE(ok, msg);
+        if (!ok) {
+            continue;
+        }
+        apdu_device_init(&devs[n], &transports[n].base);
+        dev_ptrs[n] = &devs[n];
+        n++;
+    }
+    if (n == 0) {
+        TEST_SUITE_END();
+        print_test_summary();
+        return 1;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        tx_parsed_t tx;
+        memset(&tx, 0, sizeof(tx));
+        tx.version = 1;
+        tx.chain_id = 1;
+        memset(tx.sender, 0x11, ADDRESS_LEN);
+        tx.nonce = i;
+        tx.gas_price = 10;
+        tx.gas_limit = 21000;
+        memset(tx.recipient, 0x22, ADDRESS_LEN);
+        tx.amount = 1000 + i;
+        tx_encode_transfer(&tx, txs[i], sizeof(txs[i]));
+
+        tx_encode_call(&tx, call_data, CALL_DATA_LEN, call_txs[i], sizeof(call_txs[i]));
+
+        apdu_request_init_raw(&name_req[i], INS_GET_APP_NAME, 0, 0, NULL, 0, NULL, NULL);
+        apdu_request_init_sign_tx(&sign_req[i], &path, txs[i], sizeof(txs[i]), 0, NULL, NULL);
+        apdu_request_init_raw(&pubkey_req[i], INS_GET_PUBLIC_KEY, 0, 0, path_data, path_len, NULL, NULL);
+        apdu_request_init_sign_tx(&call_req[i], &path, call_txs[i], sizeof(call_txs[i]), 0, NULL, NULL);
+        apdu_device_submit(&devs[i], &name_req[i]);
+        apdu_device_submit(&devs[i], &sign_req[i]);
+        apdu_device_submit(&devs[i], &pubkey_req[i]);
+        apdu_device_submit(&devs[i], &call_req[i]);
+    }
+
+    TEST_ASSERT_EQ(apdu_client_run(dev_ptrs, n, 30000), 0, "All instances drained");
+
+    /* Speculos instances share the default test seed: one seed group */
+    sign_worker_t workers[MAX_INSTANCES];
+    sign_scheduler_t sched;
+    sign_job_t jobs[SCHED_JOBS];
+    bip32_path_t prefix = path;
+    prefix.length = 2;
+
+    for (size_t i = 0; i < n; i++) {
+        sign_worker_init(&workers[i], &devs[i], 1, &prefix, 1);
+    }
+    sign_scheduler_init(&sched, workers, n, 3);
+    for (size_t j = 0; j < SCHED_JOBS; j++) {
+        sign_job_init(&jobs[j], &path, txs[j % n], sizeof(txs[0]), NULL, NULL);
+        sign_scheduler_submit(&sched, &jobs[j]);
+    }
+
+    TEST_ASSERT_EQ(sign_scheduler_run(&sched, 30000), 0, "Scheduler batch drained");
+    bool sched_ok = true;
+    for (size_t j = 0; j < SCHED_JOBS; j++) {
+        if (jobs[j].status != SIGN_JOB_SIGNED) {
+            sched_ok = false;
+        }
+    }
+    TEST_ASSERT_APPROVED(sched_ok, "Scheduler signs every job");
+
+    for (size_t i = 0; i < n; i++) {
+        TEST_ASSERT_TRUE(name_req[i].status == APDU_STATUS_OK &&
+                         name_req[i].resp_len == strlen("SUM Chain") &&
+                         memcmp(name_req[i].resp, "SUM Chain", name_req[i].resp_len) == 0,
+                         "GET_APP_NAME over TCP");
+        TEST_ASSERT_APPROVED(sign_req[i].status == APDU_STATUS_OK &&
+                             sign_req[i].resp_len == SIGNATURE_LEN,
+                             "SIGN_TX returns a signature");
+
+        /* Frame 0 and the next two carry APDU_MAX_DATA_LEN bytes each */
+        TEST_ASSERT_TRUE(call_req[i].plan.frame_count >= 4 &&
+                         path_len + call_req[i].plan.first_take == APDU_MAX_DATA_LEN,
+                         "Multi-APDU SIGN_TX: three maximal frames and a tail");
+        bool call_ok = call_req[i].status == APDU_STATUS_OK && call_req[i].resp_len == SIGNATURE_LEN &&
+                       pubkey_req[i].status == APDU_STATUS_OK && pubkey_req[i].resp_len == PUBKEY_LEN;
+        if (call_ok) {
+            uint8_t hash[HASH_LEN];
+            sum_blake3_hash(call_txs[i], sizeof(call_txs[i]), hash);
+            call_ok = ed25519_verify(pubkey_req[i].resp, hash, HASH_LEN, call_req[i].resp);
+        }
+        TEST_ASSERT_APPROVED(call_ok, "Multi-APDU SIGN_TX signature verifies");
+        transports[i].base.close(&transports[i].base);
+    }
+
+    TEST_SUITE_END();
+    print_test_summary();
+
+    return (g_tests_failed > 0) ? 1 : 0;
+}
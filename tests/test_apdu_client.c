@@ -0,0 +1,370 @@
+/*
+ * SUM Chain Ledger App - APDU Client Unit Tests
+ */
+
+#include "test_utils.h"
+#include "apdu_client.h"
+#include "apdu_loopback.h"
+#include "tx_encoder.h"
+#include "apdu_handlers.h"
+#include "settings.h"
+#include "crypto.h"
+#include "ed25519.h"
+#include <string.h>
+
+#define NUM_DEVICES 3
+
+/* Check frame count, fullness, flags and payload of a plan against the input */
+static bool check_plan(const bip32_path_t *path, const uint8_t *tx, size_t tx_len) {
+    apdu_sign_tx_plan_t plan;
+    apdu_frame_t frame;
+    uint8_t joined[1 + 4 * MAX_BIP32_PATH_LEN + 4096];
+    size_t joined_len = 0;
+
+    if (!apdu_sign_tx_plan_init(&plan, path, tx, tx_len, 0)) {
+        return false;
+    }
+
+    size_t total = plan.path_len + tx_len;
+    size_t expected_frames = (total + APDU_MAX_DATA_LEN - 1) / APDU_MAX_DATA_LEN;
+    if (plan.frame_count != expected_frames) {
+        return false;
+    }
+
+    for (size_t i = 0; i < plan.frame_count; i++) {
+        if (!apdu_sign_tx_plan_frame(&plan, i, &frame)) {
+            return false;
+        }
+        size_t lc = frame.bytes[4];
+        bool last = (i + 1 == plan.frame_count);
+        if (frame.bytes[0] != CLA_SUMCHAIN || frame.bytes[1] != INS_SIGN_TX) return false;
+        if (frame.bytes[2] != (i == 0 ? P1_FIRST_CHUNK : P1_MORE_CHUNK)) return false;
+        if (frame.bytes[3] != (last ? P2_LAST_CHUNK : P2_MORE_CHUNKS)) return false;
+        if (!last && lc != APDU_MAX_DATA_LEN) return false;
+        if (frame.len != APDU_HEADER_LEN + lc) return false;
+        memcpy(&joined[joined_len], &frame.bytes[APDU_HEADER_LEN], lc);
+        joined_len += lc;
+    }
+
+    return joined_len == total &&
+           memcmp(joined, plan.path_buf, plan.path_len) == 0 &&
+           memcmp(&joined[plan.path_len], tx, tx_len) == 0;
+}
+
+void test_packer_minimal_frames(void) {
+    static uint8_t tx[4096];
+    bip32_path_t path;
+
+    for (size_t i = 0; i < sizeof(tx); i++) {
+        tx[i] = (uint8_t)(i * 7);
+    }
+
+    make_path(&path, 5, 0);   /* 21 path bytes: 234 tx bytes fit in frame 0 */
+
+    TEST_ASSERT_TRUE(check_plan(&path, tx, 0), "Packer: empty tx is one frame");
+    TEST_ASSERT_TRUE(check_plan(&path, tx, 82), "Packer: transfer fits one frame");
+    TEST_ASSERT_TRUE(check_plan(&path, tx, 234), "Packer: exactly full first frame");
+    TEST_ASSERT_TRUE(check_plan(&path, tx, 235), "Packer: one byte spills to frame 1");
+    TEST_ASSERT_TRUE(check_plan(&path, tx, 234 + 255), "Packer: exactly two full frames");
+    TEST_ASSERT_TRUE(check_plan(&path, tx, sizeof(tx)), "Packer: large tx uses maximal frames");
+
+    make_path(&path, MAX_BIP32_PATH_LEN, 0);
+    TEST_ASSERT_TRUE(check_plan(&path, tx, 1000), "Packer: deepest path");
+}
+
+void test_packer_resume_offset(void) {
+    static uint8_t tx[1000];
+    bip32_path_t path;
+    apdu_sign_tx_plan_t plan;
+    apdu_frame_t frame;
+
+    memset(tx, 0x5A, sizeof(tx));
+    make_path(&path, 3, 0);
+
+    TEST_ASSERT_TRUE(apdu_sign_tx_plan_init(&plan, &path, tx, sizeof(tx), 300),
+                     "Packer: resume plan builds");
+    TEST_ASSERT_EQ(plan.frame_count, 3, "Packer: resume covers 700 bytes in 3 frames");
+    TEST_ASSERT_TRUE(apdu_sign_tx_plan_frame(&plan, 0, &frame), "Packer: resume frame 0");
+    TEST_ASSERT_EQ(frame.bytes[2], P1_MORE_CHUNK, "Packer: resume starts with continuation");
+
+    TEST_ASSERT_TRUE(apdu_sign_tx_plan_init(&plan, &path, tx, sizeof(tx), sizeof(tx)),
+                     "Packer: resume at end builds");
+    TEST_ASSERT_TRUE(apdu_sign_tx_plan_frame(&plan, 0, &frame) &&
+                     frame.bytes[3] == P2_LAST_CHUNK && frame.bytes[4] == 0,
+                     "Packer: resume at end sends empty last chunk");
+
+    TEST_ASSERT_FALSE(apdu_sign_tx_plan_init(&plan, &path, tx, sizeof(tx), sizeof(tx) + 1),
+                      "Packer: offset past end rejected");
+}
+
+/* Completion log shared by the callbacks below */
+static int g_done_order[16];
+static int g_done_count;
+
+static void record_done(apdu_request_t *req, void *user) {
+    (void)req;
+    g_done_order[g_done_count++] = (int)(intptr_t)user;
+}
+
+void test_client_concurrent_devices(void) {
+    apdu_transport_loopback_t sims[NUM_DEVICES];
+    apdu_device_t devs[NUM_DEVICES];
+    apdu_device_t *dev_ptrs[NUM_DEVICES];
+    apdu_request_t sign[NUM_DEVICES];
+    apdu_request_t version[NUM_DEVICES];
+    uint8_t txs[NUM_DEVICES][TX_TRANSFER_ENCODED_LEN];
+    bip32_path_t path;
+
+    make_path(&path, 5, 0);
+    g_done_count = 0;
+
+    /* Device 0 is the slowest, device 2 the fastest */
+    for (int i = 0; i < NUM_DEVICES; i++) {
+        unsigned slowness = (unsigned)(NUM_DEVICES - i);
+        apdu_transport_loopback_init(&sims[i], slowness * slowness * 4);
+        apdu_device_init(&devs[i], &sims[i].base);
+        dev_ptrs[i] = &devs[i];
+
+        make_transfer_tx(txs[i], (uint64_t)i, 500);
+        apdu_request_init_sign_tx(&sign[i], &path, txs[i], sizeof(txs[i]), 0,
+                                  record_done, (void *)(intptr_t)i);
+        apdu_request_init_raw(&version[i], INS_GET_VERSION, 0, 0, NULL, 0,
+                              record_done, (void *)(intptr_t)(10 + i));
+        apdu_device_submit(&devs[i], &sign[i]);
+        apdu_device_submit(&devs[i], &version[i]);
+    }
+
+    TEST_ASSERT_EQ(apdu_client_run(dev_ptrs, NUM_DEVICES, 1000), 0, "Client: all devices drained");
+    TEST_ASSERT_EQ(g_done_count, 2 * NUM_DEVICES, "Client: every request completed");
+
+    bool all_ok = true;
+    for (int i = 0; i < NUM_DEVICES; i++) {
+        if (sign[i].status != APDU_STATUS_OK || sign[i].sw != SW_OK ||
+            sign[i].resp_len != SIGNATURE_LEN ||
+            version[i].status != APDU_STATUS_OK || version[i].resp_len != 3) {
+            all_ok = false;
+        }
+    }
+    TEST_ASSERT_TRUE(all_ok, "Client: signatures and versions returned");
+
+    /* The fast device finished both requests before the slow one finished its first */
+    TEST_ASSERT_TRUE(g_done_order[0] == 2 && g_done_order[1] == 12,
+                     "Client: fast device is not blocked by slow device");
+
+    /* Per-device FIFO order is preserved */
+    int pos_sign0 = -1, pos_ver0 = -1;
+    for (int k = 0; k < g_done_count; k++) {
+        if (g_done_order[k] == 0) pos_sign0 = k;
+        if (g_done_order[k] == 10) pos_ver0 = k;
+    }
+    TEST_ASSERT_TRUE(pos_sign0 >= 0 && pos_sign0 < pos_ver0, "Client: per-device order kept");
+
+    for (int i = 0; i < NUM_DEVICES; i++) {
+        sims[i].base.close(&sims[i].base);
+    }
+}
+
+void test_client_sw_error(void) {
+    apdu_transport_loopback_t sim;
+    apdu_device_t dev;
+    apdu_device_t *dev_ptr = &dev;
+    apdu_request_t req;
+    uint8_t tx[TX_TRANSFER_ENCODED_LEN];
+    bip32_path_t path;
+
+    make_path(&path, 3, 0);
+    make_transfer_tx(tx, 1, 500);
+
+    apdu_transport_loopback_init(&sim, 0);
+    apdu_device_init(&dev, &sim.base);
+
+    /* Truncated tx: device reports a parse error on the last chunk */
+    apdu_request_init_sign_tx(&req, &path, tx, sizeof(tx) - 1, 0, NULL, NULL);
+    apdu_device_submit(&dev, &req);
+    apdu_client_run(&dev_ptr, 1, 1000);
+
+    TEST_ASSERT_EQ(req.status, APDU_STATUS_SW_ERROR, "Client: device error surfaces as SW error");
+    TEST_ASSERT_EQ(req.sw, SW_TX_PARSE_ERROR, "Client: parse error SW reported");
+    TEST_ASSERT_FALSE(dev.failed, "Client: SW error does not fail the device");
+}
+
+void test_client_large_call(void) {
+    static uint8_t tx[TX_CALL_HEADER_LEN + 50000];
+    static uint8_t data[50000];
+    apdu_transport_loopback_t sim;
+    apdu_device_t dev;
+    apdu_device_t *dev_ptr = &dev;
+    apdu_request_t req;
+    tx_parsed_t fields;
+    bip32_path_t path;
+
+    make_path(&path, 5, 0);
+    memset(&fields, 0, sizeof(fields));
+    fields.version = 1;
+    fields.chain_id = 1;
+    fields.gas_price = 1;
+    fields.gas_limit = 1000000;
+    for (size_t i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t)(i ^ (i >> 8));
+    }
+    size_t tx_len = tx_encode_call(&fields, data, sizeof(data), tx, sizeof(tx));
+    TEST_ASSERT_EQ(tx_len, TX_CALL_HEADER_LEN + sizeof(data), "Client: call encoded");
+
+    apdu_transport_loopback_init(&sim, 0);
+    apdu_device_init(&dev, &sim.base);
+    apdu_request_init_sign_tx(&req, &path, tx, tx_len, 0, NULL, NULL);
+    apdu_device_submit(&dev, &req);
+    apdu_client_run(&dev_ptr, 1, 1000);
+
+    TEST_ASSERT_TRUE(req.status == APDU_STATUS_OK && req.resp_len == SIGNATURE_LEN,
+                     "Client: 50 KB call signed without buffering");
+    TEST_ASSERT_EQ(tx_encode_call(&fields, data, MAX_TX_SIZE, tx, sizeof(tx)), 0,
+                   "Client: oversized call not encoded");
+}
+
+void test_client_multi_transfer(void) {
+    static uint8_t tx[TX_MULTI_HEADER_LEN + 400 * TX_MULTI_PAIR_LEN];
+    static uint8_t recipients[400][ADDRESS_LEN];
+    static uint64_t amounts[400];
+    apdu_transport_loopback_t sim;
+    apdu_device_t dev;
+    apdu_device_t *dev_ptr = &dev;
+    apdu_request_t req;
+    tx_parsed_t fields;
+    bip32_path_t path;
+    uint8_t hash[HASH_LEN];
+    uint8_t pubkey[PUBKEY_LEN];
+    uint8_t sig[SIGNATURE_LEN];
+
+    make_path(&path, 5, 0);
+    memset(&fields, 0, sizeof(fields));
+    fields.version = 1;
+    fields.chain_id = 1;
+    fields.gas_price = 1;
+    fields.gas_limit = 21000;
+    for (size_t i = 0; i < 400; i++) {
+        memset(recipients[i], (int)(i & 0xFF), ADDRESS_LEN);
+        amounts[i] = 1000 + i;
+    }
+    size_t tx_len = tx_encode_multi_transfer(&fields, recipients, amounts, 400, tx, sizeof(tx));
+    TEST_ASSERT_EQ(tx_len, sizeof(tx), "Client: multi-transfer encoded");
+
+    /* Per-recipient review (default), then total only: same signature */
+    for (int total_only = 0; total_only < 2; total_only++) {
+        settings_set_multi_total_only(total_only != 0);
+        apdu_transport_loopback_init(&sim, 0);
+        apdu_device_init(&dev, &sim.base);
+        apdu_request_init_sign_tx(&req, &path, tx, tx_len, 0, NULL, NULL);
+        apdu_device_submit(&dev, &req);
+        apdu_client_run(&dev_ptr, 1, 1000);
+
+        TEST_ASSERT_TRUE(req.status == APDU_STATUS_OK && req.resp_len == SIGNATURE_LEN,
+                         "Client: 400-recipient payout signed once");
+        if (total_only == 0) {
+            memcpy(sig, req.resp, SIGNATURE_LEN);
+        } else {
+            TEST_ASSERT_MEM_EQ(req.resp, sig, SIGNATURE_LEN, "Client: review mode does not change the signature");
+        }
+    }
+    settings_set_multi_total_only(false);
+
+    sum_blake3_hash(tx, tx_len, hash);
+    crypto_derive_pubkey(&path, pubkey);
+    TEST_ASSERT_TRUE(ed25519_verify(pubkey, hash, HASH_LEN, sig), "Client: payout signature verifies");
+}
+
+/* Dispatch one frame to the in-process app; returns SW, response in out */
+static uint16_t dispatch_frame(const apdu_frame_t *frame, uint8_t *out, size_t *out_len) {
+    uint8_t data[APDU_MAX_DATA_LEN];
+    uint8_t *tx = out;
+    uint8_t lc = frame->bytes[4];
+
+    memcpy(data, &frame->bytes[APDU_HEADER_LEN], lc);
+    uint16_t sw = apdu_dispatch(frame->bytes[0], frame->bytes[1], frame->bytes[2],
+                                frame->bytes[3], lc, data, &tx);
+    *out_len = (size_t)(tx - out);
+    return sw;
+}
+
+static bool query_resume(const bip32_path_t *path, uint8_t *kind, size_t *offset) {
+    apdu_frame_t frame;
+    uint8_t path_buf[1 + 4 * MAX_BIP32_PATH_LEN];
+    uint8_t out[APDU_MAX_RESP_LEN];
+    size_t out_len;
+    size_t path_len = apdu_serialize_path(path, path_buf, sizeof(path_buf));
+
+    apdu_frame_build(&frame, CLA_SUMCHAIN, INS_RESUME, 0, 0, path_buf, path_len);
+    return dispatch_frame(&frame, out, &out_len) == SW_OK &&
+           apdu_parse_resume(out, out_len, kind, offset);
+}
+
+void test_client_resume_after_reset(void) {
+    static uint8_t tx[TX_CALL_HEADER_LEN + 4000];
+    static uint8_t data[4000];
+    apdu_sign_tx_plan_t plan;
+    apdu_frame_t frame;
+    tx_parsed_t fields;
+    bip32_path_t path, other;
+    uint8_t sig_ref[SIGNATURE_LEN];
+    uint8_t out[APDU_MAX_RESP_LEN];
+    size_t out_len = 0;
+    uint16_t sw = SW_OK;
+    uint8_t kind;
+    size_t offset;
+
+    make_path(&path, 5, 0);
+    make_path(&other, 4, 0);
+    memset(&fields, 0, sizeof(fields));
+    fields.version = 1;
+    fields.chain_id = 1;
+    memset(data, 0xA5, sizeof(data));
+    size_t tx_len = tx_encode_call(&fields, data, sizeof(data), tx, sizeof(tx));
+
+    /* Reference signature from an uninterrupted stream */
+    reset_sign_session();
+    apdu_sign_tx_plan_init(&plan, &path, tx, tx_len, 0);
+    for (size_t i = 0; i < plan.frame_count && sw == SW_OK; i++) {
+        apdu_sign_tx_plan_frame(&plan, i, &frame);
+        sw = dispatch_frame(&frame, out, &out_len);
+    }
+    memcpy(sig_ref, out, SIGNATURE_LEN);
+    TEST_ASSERT_TRUE(sw == SW_OK && out_len == SIGNATURE_LEN, "Resume: reference signature");
+    TEST_ASSERT_TRUE(query_resume(&path, &kind, &offset) && kind == RESUME_KIND_NONE,
+                     "Resume: nothing to resume after signing");
+
+    /* Link drops after 6 frames; the app keeps the session across the reset */
+    for (size_t i = 0; i < 6; i++) {
+        apdu_sign_tx_plan_frame(&plan, i, &frame);
+        dispatch_frame(&frame, out, &out_len);
+    }
+    TEST_ASSERT_TRUE(query_resume(&other, &kind, &offset) && kind == RESUME_KIND_NONE,
+                     "Resume: other path sees no session");
+    TEST_ASSERT_TRUE(query_resume(&path, &kind, &offset) && kind == RESUME_KIND_SIGN_TX,
+                     "Resume: open SIGN_TX session reported");
+    TEST_ASSERT_EQ(offset, plan.first_take + 5 * APDU_MAX_DATA_LEN, "Resume: offset is bytes received");
+
+    /* Continue from the reported offset only */
+    apdu_sign_tx_plan_t rest;
+    apdu_sign_tx_plan_init(&rest, &path, tx, tx_len, offset);
+    TEST_ASSERT_EQ(rest.frame_count, plan.frame_count - 6, "Resume: only missing frames planned");
+    for (size_t i = 0; i < rest.frame_count && sw == SW_OK; i++) {
+        apdu_sign_tx_plan_frame(&rest, i, &frame);
+        sw = dispatch_frame(&frame, out, &out_len);
+    }
+    TEST_ASSERT_TRUE(sw == SW_OK && out_len == SIGNATURE_LEN, "Resume: resumed session signs");
+    TEST_ASSERT_MEM_EQ(out, sig_ref, SIGNATURE_LEN, "Resume: same signature as uninterrupted stream");
+}
+
+void run_apdu_client_tests(void) {
+    TEST_SUITE_START("APDU Client");
+
+    test_packer_minimal_frames();
+    test_packer_resume_offset();
+    test_client_concurrent_devices();
+    test_client_sw_error();
+    test_client_large_call();
+    test_client_multi_transfer();
+    test_client_resume_after_reset();
+
+    TEST_SUITE_END();
+}
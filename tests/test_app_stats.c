@@ -0,0 +1,90 @@
+/*
+ * SUM Chain Ledger App - Performance Counter Tests
+ */
+
+#include "test_utils.h"
+#include "apdu_handlers.h"
+#include "apdu_client.h"
+#include "tx_encoder.h"
+#include "sig_cache.h"
+#include <string.h>
+
+#define STATS_INS_OFFSET(ins)    (7 + (ins) * 12)
+#define STATS_STAGE_OFFSET(st)   (7 + APP_STATS_NUM_INS * 12 + (st) * 8)
+
+static uint32_t read_u32_be(const uint8_t *p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+void test_stats_counters(void) {
+    uint8_t resp[APDU_MAX_RESP_LEN];
+    uint8_t data[APDU_MAX_DATA_LEN];
+    uint8_t tx_bytes[TX_TRANSFER_ENCODED_LEN];
+    size_t resp_len;
+    bip32_path_t path;
+
+    make_path(&path, 3, 0);
+    make_transfer_tx(tx_bytes, 0, 5);
+
+    /* Start from zero; a cached signature would skip the sign stage */
+    sig_cache_clear();
+    dispatch(INS_GET_STATS, 0, 0, NULL, 0, resp, &resp_len);
+
+    size_t path_len = apdu_serialize_path(&path, data, sizeof(data));
+    dispatch(INS_GET_PUBLIC_KEY, 0, 0, data, (uint8_t)path_len, resp, &resp_len);
+    dispatch(INS_GET_VERSION, 0, 0, NULL, 0, resp, &resp_len);
+    dispatch(0x7F, 0, 0, NULL, 0, resp, &resp_len);
+
+    /* Sign in two chunks: path + 40 bytes, then the rest */
+    memcpy(data + path_len, tx_bytes, 40);
+    dispatch(INS_SIGN_TX, P1_FIRST_CHUNK, P2_MORE_CHUNKS, data, (uint8_t)(path_len + 40),
+             resp, &resp_len);
+    uint16_t sw = dispatch(INS_SIGN_TX, P1_MORE_CHUNK, P2_LAST_CHUNK, tx_bytes + 40,
+                           sizeof(tx_bytes) - 40, resp, &resp_len);
+    TEST_ASSERT_EQ(sw, SW_OK, "Stats: instrumented SIGN_TX still signs");
+
+    sw = dispatch(INS_GET_STATS, 0, 0, NULL, 0, resp, &resp_len);
+    TEST_ASSERT_EQ(sw, SW_OK, "Stats: GET_STATS succeeds");
+    TEST_ASSERT_EQ(resp_len, APP_STATS_RESPONSE_LEN, "Stats: response length");
+    TEST_ASSERT_TRUE(resp[0] == APP_STATS_FORMAT && resp[1] == APP_STATS_NUM_INS &&
+                     resp[2] == APP_STAGE_COUNT, "Stats: header");
+    TEST_ASSERT_EQ(read_u32_be(resp + 3), APP_STATS_TICK_US, "Stats: tick unit");
+
+    TEST_ASSERT_EQ(read_u32_be(resp + STATS_INS_OFFSET(INS_GET_PUBLIC_KEY)), 1,
+                   "Stats: GET_PUBLIC_KEY calls");
+    TEST_ASSERT_EQ(read_u32_be(resp + STATS_INS_OFFSET(INS_GET_VERSION)), 1,
+                   "Stats: GET_VERSION calls");
+    TEST_ASSERT_EQ(read_u32_be(resp + STATS_INS_OFFSET(INS_SIGN_TX)), 2,
+                   "Stats: SIGN_TX counted per APDU");
+    TEST_ASSERT_EQ(read_u32_be(resp + STATS_INS_OFFSET(INS_SIGN_TX) + 4), 0,
+                   "Stats: SIGN_TX no errors");
+    TEST_ASSERT_EQ(read_u32_be(resp + STATS_INS_OFFSET(INS_GET_STATS)), 1,
+                   "Stats: previous GET_STATS counted after reset");
+
+    TEST_ASSERT_EQ(read_u32_be(resp + STATS_STAGE_OFFSET(APP_STAGE_DERIVE)), 1,
+                   "Stats: one derivation");
+    TEST_ASSERT_EQ(read_u32_be(resp + STATS_STAGE_OFFSET(APP_STAGE_SIGN)), 1,
+                   "Stats: one signature");
+    TEST_ASSERT_EQ(read_u32_be(resp + STATS_STAGE_OFFSET(APP_STAGE_HASH)), sizeof(tx_bytes),
+                   "Stats: bytes hashed");
+    TEST_ASSERT_EQ(read_u32_be(resp + STATS_STAGE_OFFSET(APP_STAGE_PARSE)), sizeof(tx_bytes),
+                   "Stats: bytes parsed");
+
+    /* Read-and-reset: only the GET_STATS call itself remains */
+    dispatch(INS_GET_STATS, 0, 0, NULL, 0, resp, &resp_len);
+    uint32_t total = 0;
+    for (size_t i = 0; i < APP_STATS_NUM_INS; i++) {
+        total += read_u32_be(resp + STATS_INS_OFFSET(i));
+    }
+    TEST_ASSERT_EQ(total, 1, "Stats: counters reset after read");
+    TEST_ASSERT_EQ(read_u32_be(resp + STATS_STAGE_OFFSET(APP_STAGE_HASH)), 0,
+                   "Stats: stage counters reset after read");
+}
+
+void run_app_stats_tests(void) {
+    TEST_SUITE_START("Performance Counters");
+
+    test_stats_counters();
+
+    TEST_SUITE_END();
+}
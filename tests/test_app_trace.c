@@ -0,0 +1,214 @@
+/*
+ * SUM Chain Ledger App - Event Trace Tests
+ */
+
+#include "test_utils.h"
+#include "apdu_handlers.h"
+#include "apdu_client.h"
+#include "tx_encoder.h"
+#include "sig_cache.h"
+#include <string.h>
+
+#define TRACE_MAX_EVENTS   APP_TRACE_CAPACITY
+
+typedef struct {
+    uint32_t time;
+    uint8_t  event;
+    uint8_t  arg;
+    uint16_t value;
+} trace_event_t;
+
+static uint32_t read_u32_be(const uint8_t *p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+/* Read every page; returns the number of events held, total in *total */
+static size_t read_trace(trace_event_t *events, uint32_t *total) {
+    uint8_t resp[APDU_MAX_RESP_LEN];
+    size_t resp_len;
+    size_t count = 0;
+    size_t held = 0;
+
+    for (uint8_t page = 0; page < APP_TRACE_PAGES; page++) {
+        if (dispatch(INS_GET_TRACE, page, 0, NULL, 0, resp, &resp_len) != SW_OK ||
+            resp_len < APP_TRACE_HEADER_LEN) {
+            return 0;
+        }
+        held = resp[1];
+        *total = read_u32_be(resp + 6);
+        for (size_t off = APP_TRACE_HEADER_LEN; off + APP_TRACE_ENTRY_LEN <= resp_len;
+             off += APP_TRACE_ENTRY_LEN) {
+            events[count].time = read_u32_be(resp + off);
+            events[count].event = resp[off + 4];
+            events[count].arg = resp[off + 5];
+            events[count].value = (uint16_t)((resp[off + 6] << 8) | resp[off + 7]);
+            count++;
+        }
+    }
+    return (count == held) ? count : 0;
+}
+
+static void clear_trace(void) {
+    uint8_t resp[APDU_MAX_RESP_LEN];
+    size_t resp_len;
+    dispatch(INS_GET_TRACE, 0, P2_TRACE_CLEAR, NULL, 0, resp, &resp_len);
+}
+
+/* Index of the next event matching (event, arg) at or after `from`, or count */
+static size_t find_event(const trace_event_t *events, size_t count, size_t from,
+                         uint8_t event, uint8_t arg) {
+    for (size_t i = from; i < count; i++) {
+        if (events[i].event == event && events[i].arg == arg) {
+            return i;
+        }
+    }
+    return count;
+}
+
+void test_trace_sign_tx_timeline(void) {
+    uint8_t resp[APDU_MAX_RESP_LEN];
+    uint8_t data[APDU_MAX_DATA_LEN];
+    uint8_t tx_bytes[TX_TRANSFER_ENCODED_LEN];
+    trace_event_t events[TRACE_MAX_EVENTS];
+    size_t resp_len;
+    uint32_t total = 0;
+    bip32_path_t path;
+
+    make_path(&path, 3, 0);
+    make_transfer_tx(tx_bytes, 0, 5);
+
+    sig_cache_clear();
+    clear_trace();
+
+    /* Sign in two chunks: path + 40 bytes, then the rest */
+    size_t path_len = apdu_serialize_path(&path, data, sizeof(data));
+    memcpy(data + path_len, tx_bytes, 40);
+    dispatch(INS_SIGN_TX, P1_FIRST_CHUNK, P2_MORE_CHUNKS, data, (uint8_t)(path_len + 40),
+             resp, &resp_len);
+    uint16_t sw = dispatch(INS_SIGN_TX, P1_MORE_CHUNK, P2_LAST_CHUNK, tx_bytes + 40,
+                           sizeof(tx_bytes) - 40, resp, &resp_len);
+    TEST_ASSERT_EQ(sw, SW_OK, "Trace: instrumented SIGN_TX still signs");
+
+    size_t count = read_trace(events, &total);
+    TEST_ASSERT_TRUE(count > 0, "Trace: pages read back");
+    TEST_ASSERT_EQ(total, count, "Trace: nothing lost for one session");
+    TEST_ASSERT_TRUE(events[0].event == APP_TRACE_APDU_RX && events[0].arg == INS_SIGN_TX &&
+                     events[0].value == ((P1_FIRST_CHUNK << 8) | (path_len + 40)),
+                     "Trace: first event is the first SIGN_TX chunk");
+    TEST_ASSERT_TRUE(events[count - 1].event == APP_TRACE_APDU_SW &&
+                     events[count - 1].value == SW_OK, "Trace: last event is the final SW");
+
+    /* The expected milestones, in order */
+    static const uint8_t milestones[][2] = {
+        { APP_TRACE_HASH_UPDATE, 0 },
+        { APP_TRACE_APDU_SW, INS_SIGN_TX },
+        { APP_TRACE_APDU_RX, INS_SIGN_TX },
+        { APP_TRACE_HASH_UPDATE, 0 },
+        { APP_TRACE_PARSE_STATE, TX_PARSE_STATE_DONE },
+        { APP_TRACE_HASH_FINAL, 0 },
+        { APP_TRACE_UI_SHOW, APP_TRACE_UI_TX },
+        { APP_TRACE_UI_DECISION, UI_RESULT_APPROVED },
+        { APP_TRACE_DERIVE_BEGIN, 3 },
+        { APP_TRACE_DERIVE_END, 1 },
+        { APP_TRACE_APDU_SW, INS_SIGN_TX },
+    };
+    size_t pos = 0;
+    bool in_order = true;
+    for (size_t m = 0; m < sizeof(milestones) / sizeof(milestones[0]); m++) {
+        pos = find_event(events, count, pos, milestones[m][0], milestones[m][1]);
+        if (pos == count) {
+            in_order = false;
+            break;
+        }
+        pos++;
+    }
+    TEST_ASSERT_TRUE(in_order, "Trace: receipt, hash, parse, final, UI, derive in order");
+
+    size_t first_hash = find_event(events, count, 0, APP_TRACE_HASH_UPDATE, 0);
+    TEST_ASSERT_EQ(events[first_hash].value, 40, "Trace: hash update carries the length");
+
+    /* A transfer walks version .. amount, then done: one event per change */
+    size_t transitions = 0;
+    size_t done = count;
+    for (size_t i = 0; i < count; i++) {
+        if (events[i].event == APP_TRACE_PARSE_STATE) {
+            transitions++;
+            done = i;
+        }
+    }
+    TEST_ASSERT_EQ(transitions, 9, "Trace: every parser state change recorded");
+    TEST_ASSERT_EQ(events[done].value, sizeof(tx_bytes), "Trace: DONE carries the bytes parsed");
+
+    bool monotonic = true;
+    for (size_t i = 1; i < count; i++) {
+        /* Unsigned difference: the 32-bit clock may wrap mid-trace */
+        monotonic = monotonic && (uint32_t)(events[i].time - events[i - 1].time) < 0x80000000u;
+    }
+    TEST_ASSERT_TRUE(monotonic, "Trace: timestamps never go back");
+
+    /* Reading is not traced */
+    uint32_t again = 0;
+    read_trace(events, &again);
+    TEST_ASSERT_EQ(again, total, "Trace: GET_TRACE does not trace itself");
+}
+
+void test_trace_ring_wrap(void) {
+    uint8_t resp[APDU_MAX_RESP_LEN];
+    trace_event_t events[TRACE_MAX_EVENTS];
+    size_t resp_len;
+    uint32_t total = 0;
+
+    clear_trace();
+
+    /* 100 APDUs, two events each: the ring keeps the newest 64 */
+    for (int i = 0; i < 100; i++) {
+        dispatch(INS_GET_VERSION, 0, 0, NULL, 0, resp, &resp_len);
+    }
+
+    size_t count = read_trace(events, &total);
+    TEST_ASSERT_EQ(total, 200, "Trace: total counts overwritten events");
+    TEST_ASSERT_EQ(count, APP_TRACE_CAPACITY, "Trace: full ring held");
+
+    bool alternating = true;
+    for (size_t i = 0; i < count; i++) {
+        uint8_t expected = (i % 2 == 0) ? APP_TRACE_APDU_RX : APP_TRACE_APDU_SW;
+        alternating = alternating && events[i].event == expected && events[i].arg == INS_GET_VERSION;
+    }
+    TEST_ASSERT_TRUE(alternating, "Trace: oldest first across the wrap");
+
+    dispatch(INS_GET_TRACE, APP_TRACE_PAGES - 1, 0, NULL, 0, resp, &resp_len);
+    TEST_ASSERT_EQ(resp_len, APP_TRACE_HEADER_LEN +
+                   (APP_TRACE_CAPACITY - (APP_TRACE_PAGES - 1) * APP_TRACE_PAGE_ENTRIES) * APP_TRACE_ENTRY_LEN,
+                   "Trace: last page holds the remainder");
+    TEST_ASSERT_TRUE(resp[0] == APP_TRACE_FORMAT && read_u32_be(resp + 2) == APP_TRACE_TICK_US,
+                     "Trace: header");
+}
+
+void test_trace_params_and_clear(void) {
+    uint8_t resp[APDU_MAX_RESP_LEN];
+    size_t resp_len;
+
+    dispatch(INS_GET_VERSION, 0, 0, NULL, 0, resp, &resp_len);
+
+    uint16_t sw = dispatch(INS_GET_TRACE, APP_TRACE_PAGES, 0, NULL, 0, resp, &resp_len);
+    TEST_ASSERT_EQ(sw, SW_INVALID_P1P2, "Trace: page past the ring rejected");
+    sw = dispatch(INS_GET_TRACE, 0, 0x02, NULL, 0, resp, &resp_len);
+    TEST_ASSERT_EQ(sw, SW_INVALID_P1P2, "Trace: unknown P2 rejected");
+
+    sw = dispatch(INS_GET_TRACE, 0, P2_TRACE_CLEAR, NULL, 0, resp, &resp_len);
+    TEST_ASSERT_TRUE(sw == SW_OK && resp_len > APP_TRACE_HEADER_LEN, "Trace: clear returns the page first");
+
+    dispatch(INS_GET_TRACE, 0, 0, NULL, 0, resp, &resp_len);
+    TEST_ASSERT_TRUE(resp_len == APP_TRACE_HEADER_LEN && resp[1] == 0 && read_u32_be(resp + 6) == 0,
+                     "Trace: empty after clear");
+}
+
+void run_app_trace_tests(void) {
+    TEST_SUITE_START("Event Trace");
+
+    test_trace_sign_tx_timeline();
+    test_trace_ring_wrap();
+    test_trace_params_and_clear();
+
+    TEST_SUITE_END();
+}
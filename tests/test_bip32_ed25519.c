@@ -0,0 +1,195 @@
+/*
+ * SUM Chain Ledger App - BIP32-Ed25519 Derivation and GET_XPUB Tests
+ */
+
+#include "test_utils.h"
+#include "apdu_handlers.h"
+#include "apdu_client.h"
+#include "address.h"
+#include "bip32_ed25519.h"
+#include "sha256.h"
+#include "ed25519.h"
+#include "crypto.h"
+#include <string.h>
+
+#define DEPOSIT_ADDRESSES 8
+
+static void hex_decode(const char *hex, uint8_t *out, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        unsigned int byte;
+        sscanf(&hex[2 * i], "%2x", &byte);
+        out[i] = (uint8_t)byte;
+    }
+}
+
+/* m/44'/12345'/account' with the BIP32-Ed25519 scheme */
+static void make_account(bip32_path_t *path, uint32_t account) {
+    make_path(path, 3, account);
+    path->scheme = PATH_SCHEME_BIP32_ED25519;
+}
+
+static uint16_t get_xpub(const bip32_path_t *path, uint8_t p1, uint8_t *out, size_t *out_len) {
+    uint8_t data[APDU_MAX_DATA_LEN];
+    size_t lc = apdu_serialize_path(path, data, sizeof(data));
+    return dispatch(INS_GET_XPUB, p1, 0, data, lc, out, out_len);
+}
+
+void test_sha256_vectors(void) {
+    uint8_t out[SHA256_DIGEST_LEN], expected[SHA256_DIGEST_LEN];
+    uint8_t key[20];
+
+    sha256((const uint8_t *)"abc", 3, out);
+    hex_decode("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad", expected, 32);
+    TEST_ASSERT_MEM_EQ(out, expected, 32, "SHA-256(\"abc\") (FIPS 180-4)");
+
+    sha256((const uint8_t *)"abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", 56, out);
+    hex_decode("248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1", expected, 32);
+    TEST_ASSERT_MEM_EQ(out, expected, 32, "SHA-256 two-block message (FIPS 180-4)");
+
+    /* RFC 4231 test case 1 */
+    memset(key, 0x0b, sizeof(key));
+    hmac_sha256(key, sizeof(key), (const uint8_t *)"Hi There", 8, out);
+    hex_decode("b0344c61d8db38535ca8afceaf0bf12b881dc200c9833da726e9376c2e32cff7", expected, 32);
+    TEST_ASSERT_MEM_EQ(out, expected, 32, "HMAC-SHA256 RFC 4231 case 1");
+}
+
+void test_bip32_ed25519_path_rules(void) {
+    bip32_path_t path;
+    uint8_t raw[1 + 4 * 5];
+
+    make_account(&path, 0);
+    path.length = 5;
+    path.path[3] = 0;
+    path.path[4] = 7;
+    TEST_ASSERT_TRUE(crypto_validate_path(&path), "BIP32-Ed25519: non-hardened change/index accepted");
+
+    path.path[2] = 0;
+    TEST_ASSERT_FALSE(crypto_validate_path(&path), "BIP32-Ed25519: non-hardened account rejected");
+
+    path.path[2] = 0x80000000u;
+    path.scheme = PATH_SCHEME_SLIP10;
+    TEST_ASSERT_FALSE(crypto_validate_path(&path), "SLIP-10: non-hardened index still rejected");
+
+    /* Scheme travels in bit 7 of the length byte */
+    path.scheme = PATH_SCHEME_BIP32_ED25519;
+    size_t len = apdu_serialize_path(&path, raw, sizeof(raw));
+    TEST_ASSERT_EQ(raw[0], 5 | PATH_LEN_FLAG_BIP32_ED25519, "BIP32-Ed25519: length byte flagged");
+
+    bip32_path_t parsed;
+    TEST_ASSERT_EQ(crypto_parse_path(raw, len, &parsed), len, "BIP32-Ed25519: path parses");
+    TEST_ASSERT_TRUE(parsed.scheme == PATH_SCHEME_BIP32_ED25519 && parsed.length == 5 &&
+                     memcmp(parsed.path, path.path, sizeof(path.path[0]) * 5) == 0,
+                     "BIP32-Ed25519: scheme and components round-trip");
+}
+
+void test_bip32_ed25519_public_matches_private(void) {
+    uint8_t xpub[XPUB_LEN], pubkey[PUBKEY_LEN], host_pub[PUBKEY_LEN];
+    uint8_t addr[ADDRESS_LEN];
+    char host_str[ADDRESS_BASE58_MAX_LEN], device_str[ADDRESS_BASE58_MAX_LEN];
+    bip32_path_t account, child;
+    bool keys_ok = true, addrs_ok = true;
+
+    make_account(&account, 0);
+    TEST_ASSERT_TRUE(crypto_derive_xpub(&account, xpub, xpub + PUBKEY_LEN),
+                     "BIP32-Ed25519: account xpub derived");
+
+    child = account;
+    child.length = 5;
+    for (uint32_t i = 0; i < DEPOSIT_ADDRESSES; i++) {
+        uint32_t indices[2] = { 0, i * 1000 + 3 };
+        child.path[3] = indices[0];
+        child.path[4] = indices[1];
+
+        crypto_derive_pubkey(&child, pubkey);
+        bip32_ed25519_public_derive(xpub, indices, 2, host_pub);
+        keys_ok = keys_ok && memcmp(pubkey, host_pub, PUBKEY_LEN) == 0;
+
+        /* Deposit service path: xpub -> address, no device */
+        sumchain_get_address_for_path(&child, false, device_str, sizeof(device_str));
+        bip32_ed25519_address(xpub, indices, 2, addr);
+        sumchain_address_to_base58(addr, host_str, sizeof(host_str));
+        addrs_ok = addrs_ok && strcmp(host_str, device_str) == 0;
+    }
+    TEST_ASSERT_TRUE(keys_ok, "BIP32-Ed25519: xpub children match private derivation");
+    TEST_ASSERT_TRUE(addrs_ok, "BIP32-Ed25519: host addresses match GET_ADDRESS");
+
+    /* Pinned: m/44'/12345'/0'/0/3 from the host test seed */
+    uint8_t expected[PUBKEY_LEN];
+    const uint32_t first[2] = { 0, 3 };
+    bip32_ed25519_public_derive(xpub, first, 2, host_pub);
+    hex_decode("fe0130638a6a88385b872064dfb4f187abbb76235da72a5b2b12ee1e19929a95", expected, 32);
+    TEST_ASSERT_MEM_EQ(host_pub, expected, 32, "BIP32-Ed25519: m/44'/12345'/0'/0/3 known answer");
+
+    /* The two schemes give unrelated keys for the same components */
+    uint8_t slip10_pub[PUBKEY_LEN];
+    account.scheme = PATH_SCHEME_SLIP10;
+    crypto_derive_pubkey(&account, slip10_pub);
+    TEST_ASSERT_TRUE(memcmp(slip10_pub, xpub, PUBKEY_LEN) != 0,
+                     "BIP32-Ed25519: differs from SLIP-10 at the same path");
+
+    uint8_t next[XPUB_LEN];
+    TEST_ASSERT_FALSE(bip32_ed25519_public_child(xpub, 0x80000000u, next),
+                      "BIP32-Ed25519: hardened child needs the private key");
+}
+
+void test_bip32_ed25519_sign(void) {
+    bip32_path_t path;
+    uint8_t hash[HASH_LEN], sig[SIGNATURE_LEN], pubkey[PUBKEY_LEN];
+
+    make_account(&path, 2);
+    path.length = 5;
+    path.path[3] = 1;
+    path.path[4] = 42;
+    memset(hash, 0x5A, sizeof(hash));
+
+    TEST_ASSERT_TRUE(crypto_sign_hash(&path, hash, sig), "BIP32-Ed25519: signs");
+    crypto_derive_pubkey(&path, pubkey);
+    TEST_ASSERT_TRUE(ed25519_verify(pubkey, hash, HASH_LEN, sig),
+                     "BIP32-Ed25519: signature verifies under the child key");
+    hash[0] ^= 1;
+    TEST_ASSERT_FALSE(ed25519_verify(pubkey, hash, HASH_LEN, sig),
+                      "BIP32-Ed25519: signature bound to the message");
+}
+
+void test_get_xpub_apdu(void) {
+    uint8_t out[APDU_MAX_RESP_LEN];
+    uint8_t pubkey[PUBKEY_LEN], chain[CHAIN_CODE_LEN];
+    size_t out_len;
+    bip32_path_t path;
+
+    make_account(&path, 1);
+    TEST_ASSERT_EQ(get_xpub(&path, 0, out, &out_len), SW_OK, "GET_XPUB: account path accepted");
+    TEST_ASSERT_EQ(out_len, XPUB_LEN, "GET_XPUB: 64-byte response");
+    crypto_derive_xpub(&path, pubkey, chain);
+    TEST_ASSERT_TRUE(memcmp(out, pubkey, PUBKEY_LEN) == 0 &&
+                     memcmp(out + PUBKEY_LEN, chain, CHAIN_CODE_LEN) == 0,
+                     "GET_XPUB: pubkey || chain code");
+
+    TEST_ASSERT_EQ(get_xpub(&path, 1, out, &out_len), SW_INVALID_P1P2, "GET_XPUB: P1 must be zero");
+
+    path.scheme = PATH_SCHEME_SLIP10;
+    TEST_ASSERT_EQ(get_xpub(&path, 0, out, &out_len), SW_INVALID_PATH,
+                   "GET_XPUB: SLIP-10 path refused");
+    TEST_ASSERT_EQ(out_len, 0, "GET_XPUB: nothing returned on error");
+
+    path.scheme = PATH_SCHEME_BIP32_ED25519;
+    path.path[1] = 12345;
+    TEST_ASSERT_EQ(get_xpub(&path, 0, out, &out_len), SW_INVALID_PATH,
+                   "GET_XPUB: non-hardened coin type refused");
+
+    TEST_ASSERT_EQ(dispatch(INS_GET_XPUB, 0, 0, NULL, 0, out, &out_len), SW_WRONG_LENGTH,
+                   "GET_XPUB: empty data refused");
+    TEST_ASSERT_EQ(out_len, 0, "GET_XPUB: nothing returned for Lc=0");
+}
+
+void run_bip32_ed25519_tests(void) {
+    TEST_SUITE_START("BIP32-Ed25519 / GET_XPUB");
+
+    test_sha256_vectors();
+    test_bip32_ed25519_path_rules();
+    test_bip32_ed25519_public_matches_private();
+    test_bip32_ed25519_sign();
+    test_get_xpub_apdu();
+
+    TEST_SUITE_END();
+}
@@ -2,12 +2,12 @@
  * SUM Chain Ledger App - BLAKE3 Unit Tests
  *
  * Note: These tests verify internal consistency of the BLAKE3 implementation.
- * The implementation should be validated against official test vectors
- * before production use.
+ * Known-answer vectors are in test_blake3_vectors.c.
  */
 
 #include "test_utils.h"
 #include "sum_blake3.h"
+#include <stdbool.h>
 #include <string.h>
 
 void test_blake3_deterministic(void) {
@@ -187,6 +187,73 @@ void test_blake3_zeroize(void) {
     TEST_ASSERT_MEM_EQ(&ctx, zeros, sizeof(ctx), "BLAKE3 context zeroized");
 }
 
+void test_blake3_zeroize_partial(void) {
+    static uint8_t input[300 * 1024];
+    static sum_blake3_ctx_t ctx;
+    static const uint8_t zeros[sizeof(sum_blake3_ctx_t)];
+    static const size_t lengths[] = { 0, 1, 1024, 1025, 4096, 40000, 65536 + 7, sizeof(input) };
+    uint8_t out[32];
+    bool all_zero = true;
+
+    for (size_t i = 0; i < sizeof(input); i++) {
+        input[i] = (uint8_t)(i * 31 + 7);
+    }
+
+    /* Short inputs only touch the start of the 1760-byte CV stack */
+    sum_blake3_init(&ctx);
+    sum_blake3_update(&ctx, input, 4096);
+    TEST_ASSERT_TRUE(ctx.cv_used > 0 && ctx.cv_used <= 4, "BLAKE3 zeroize_used: 4 KiB uses few CV entries");
+    sum_blake3_zeroize_used(&ctx);
+
+    /* One shot and 1000-byte steps, and a long hash re-armed for a short one */
+    for (size_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+        sum_blake3_init(&ctx);
+        sum_blake3_update(&ctx, input, lengths[i]);
+        sum_blake3_finalize32(&ctx, out);
+        sum_blake3_zeroize_used(&ctx);
+        all_zero &= (memcmp(&ctx, zeros, sizeof(ctx)) == 0);
+
+        sum_blake3_init(&ctx);
+        for (size_t pos = 0; pos < lengths[i]; pos += 1000) {
+            size_t take = lengths[i] - pos < 1000 ? lengths[i] - pos : 1000;
+            sum_blake3_update(&ctx, input + pos, take);
+        }
+        sum_blake3_finalize32(&ctx, out);
+        sum_blake3_init(&ctx);
+        sum_blake3_update(&ctx, input, 10);
+        sum_blake3_zeroize_used(&ctx);
+        all_zero &= (memcmp(&ctx, zeros, sizeof(ctx)) == 0);
+    }
+    TEST_ASSERT_TRUE(all_zero, "BLAKE3 zeroize_used: context all zero after partial wipe");
+}
+
+void test_blake3_ctx_init(void) {
+    static const uint8_t zeros[sizeof(sum_blake3_ctx_t)];
+    uint8_t input[4096];
+    uint8_t out[32];
+
+    memset(input, 0x5A, sizeof(input));
+
+    /* A stack context from the initializer supports the partial wipe */
+    sum_blake3_ctx_t ctx = SUM_BLAKE3_CTX_INIT;
+    TEST_ASSERT_MEM_EQ(&ctx, zeros, sizeof(ctx), "BLAKE3 CTX_INIT: context starts zero");
+    sum_blake3_init(&ctx);
+    sum_blake3_update(&ctx, input, sizeof(input));
+    sum_blake3_finalize32(&ctx, out);
+    sum_blake3_zeroize_used(&ctx);
+    TEST_ASSERT_MEM_EQ(&ctx, zeros, sizeof(ctx), "BLAKE3 CTX_INIT: all zero after zeroize_used");
+
+    /* Stale bytes above cv_used survive the partial wipe, not the full one */
+    memset(&ctx, 0xA5, sizeof(ctx));
+    ctx.cv_used = 0;
+    sum_blake3_init(&ctx);
+    sum_blake3_update(&ctx, input, 10);
+    sum_blake3_zeroize_used(&ctx);
+    TEST_ASSERT_FALSE(memcmp(&ctx, zeros, sizeof(ctx)) == 0, "BLAKE3 zeroize_used: stale stack left");
+    sum_blake3_zeroize(&ctx);
+    TEST_ASSERT_MEM_EQ(&ctx, zeros, sizeof(ctx), "BLAKE3 zeroize: dirty context all zero");
+}
+
 void test_blake3_output_length(void) {
     /* Verify we always get 32 bytes */
     uint8_t hash[32];
@@ -216,6 +283,8 @@ void run_blake3_tests(void) {
     test_blake3_block_boundary();
     test_blake3_chunk_boundary();
     test_blake3_zeroize();
+    test_blake3_zeroize_partial();
+    test_blake3_ctx_init();
     test_blake3_output_length();
 
     TEST_SUITE_END();
@@ -0,0 +1,350 @@
+/*
+ * SUM Chain Ledger App - BLAKE3 Test-Vector Suite
+ *
+ * Runs every case of blake3_test_vectors.h (hash, keyed_hash, derive_key,
+ * 131 bytes of XOF output each) through every compression backend linked
+ * into the build (blake3_dispatch.c, BLAKE3_TESTING), then prints the
+ * throughput of each backend per input length. Timings are informational;
+ * only the vectors are asserted.
+ */
+
+#include "test_utils.h"
+#include "sum_blake3.h"
+#include "blake3_impl.h"
+#include "blake3_test_vectors.h"
+#include <string.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define TIMER_UNIT "cycles/byte"
+static uint64_t timer_now(void) {
+    return __rdtsc();
+}
+#else
+#define TIMER_UNIT "ns/byte"
+static uint64_t timer_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+#endif
+
+#define TV_MAX_INPUT     102400
+#define TV_SEEK_OFFSET   31
+#define TV_UPDATE_STEP   97      /* Odd piece size: crosses block and chunk edges */
+
+static uint8_t g_input[TV_MAX_INPUT];
+static uint8_t g_mt_input[(4u << 20) + 3];     /* update_tbb: several queued subtrees */
+
+typedef enum {
+    TV_MODE_HASH = 0,
+    TV_MODE_KEYED,
+    TV_MODE_DERIVE,
+    TV_MODE_COUNT
+} tv_mode_t;
+
+static const char *const TV_MODE_NAMES[TV_MODE_COUNT] = { "hash", "keyed_hash", "derive_key" };
+
+static void hex_decode(const char *hex, uint8_t *out, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        unsigned int byte;
+        sscanf(&hex[2 * i], "%2x", &byte);
+        out[i] = (uint8_t)byte;
+    }
+}
+
+static void init_mode(blake3_hasher *hasher, tv_mode_t mode) {
+    switch (mode) {
+        case TV_MODE_KEYED:
+            blake3_hasher_init_keyed(hasher, (const uint8_t *)BLAKE3_TV_KEY);
+            break;
+        case TV_MODE_DERIVE:
+            blake3_hasher_init_derive_key(hasher, BLAKE3_TV_CONTEXT);
+            break;
+        default:
+            blake3_hasher_init(hasher);
+            break;
+    }
+}
+
+static const char *expected_hex(const blake3_test_vector_t *tv, tv_mode_t mode) {
+    switch (mode) {
+        case TV_MODE_KEYED:  return tv->keyed_hash;
+        case TV_MODE_DERIVE: return tv->derive_key;
+        default:             return tv->hash;
+    }
+}
+
+/* One case in one mode: one-shot, piecewise update, and a seek into the XOF */
+static bool check_case(const blake3_test_vector_t *tv, tv_mode_t mode) {
+    static blake3_hasher hasher;
+    uint8_t expected[BLAKE3_TV_OUT_LEN];
+    uint8_t out[BLAKE3_TV_OUT_LEN];
+
+    hex_decode(expected_hex(tv, mode), expected, sizeof(expected));
+
+    init_mode(&hasher, mode);
+    blake3_hasher_update(&hasher, g_input, tv->input_len);
+    blake3_hasher_finalize(&hasher, out, sizeof(out));
+    if (memcmp(out, expected, sizeof(out)) != 0) {
+        return false;
+    }
+
+    blake3_hasher_finalize_seek(&hasher, TV_SEEK_OFFSET, out, sizeof(out) - TV_SEEK_OFFSET);
+    if (memcmp(out, &expected[TV_SEEK_OFFSET], sizeof(out) - TV_SEEK_OFFSET) != 0) {
+        return false;
+    }
+
+    init_mode(&hasher, mode);
+    for (size_t pos = 0; pos < tv->input_len; pos += TV_UPDATE_STEP) {
+        size_t take = tv->input_len - pos;
+        blake3_hasher_update(&hasher, &g_input[pos], take < TV_UPDATE_STEP ? take : TV_UPDATE_STEP);
+    }
+    blake3_hasher_finalize(&hasher, out, sizeof(out));
+    return memcmp(out, expected, sizeof(out)) == 0;
+}
+
+void test_blake3_vectors_per_backend(void) {
+    char msg[128];
+
+    for (size_t i = 0; i < sizeof(g_input); i++) {
+        g_input[i] = (uint8_t)(i % 251);
+    }
+
+    for (size_t b = 0; b < blake3_backend_count(); b++) {
+        const blake3_backend_t *backend = blake3_backend_get(b);
+        blake3_backend_select(b);
+
+        for (int mode = 0; mode < TV_MODE_COUNT; mode++) {
+            size_t failed = 0;
+            for (size_t c = 0; c < BLAKE3_TEST_VECTOR_COUNT; c++) {
+                if (!check_case(&BLAKE3_TEST_VECTORS[c], (tv_mode_t)mode)) {
+                    printf("    [%s] %s: input_len %zu mismatch\n", backend->name,
+                           TV_MODE_NAMES[mode], BLAKE3_TEST_VECTORS[c].input_len);
+                    failed++;
+                }
+            }
+            snprintf(msg, sizeof(msg), "BLAKE3 vectors [%s]: %s, %zu cases",
+                     backend->name, TV_MODE_NAMES[mode], (size_t)BLAKE3_TEST_VECTOR_COUNT);
+            TEST_ASSERT_EQ(failed, 0, msg);
+        }
+    }
+
+    blake3_backend_select(0);
+}
+
+void test_blake3_vectors_app_wrapper(void) {
+    uint8_t expected[BLAKE3_OUT_LEN];
+    uint8_t out[BLAKE3_OUT_LEN];
+    size_t failed = 0;
+
+    /* sum_blake3_hash is what SIGN_TX signs: plain hash mode, 32 bytes */
+    for (size_t c = 0; c < BLAKE3_TEST_VECTOR_COUNT; c++) {
+        const blake3_test_vector_t *tv = &BLAKE3_TEST_VECTORS[c];
+        hex_decode(tv->hash, expected, sizeof(expected));
+        sum_blake3_hash(g_input, tv->input_len, out);
+        failed += (memcmp(out, expected, sizeof(out)) != 0) ? 1 : 0;
+    }
+
+    TEST_ASSERT_EQ(failed, 0, "BLAKE3 vectors: sum_blake3_hash matches hash mode");
+}
+
+void test_blake3_iterative_subtree(void) {
+    /* The device variant (BLAKE3_ITERATIVE_SUBTREE): one-shot, and in
+     * pieces that are multi-chunk but start off a chunk boundary */
+    static const size_t steps[] = { TV_MAX_INPUT, 3000, 1025 };
+    static blake3_hasher hasher;
+    uint8_t expected[BLAKE3_TV_OUT_LEN];
+    uint8_t out[BLAKE3_TV_OUT_LEN];
+    char msg[128];
+
+    for (int mode = 0; mode < TV_MODE_COUNT; mode++) {
+        size_t failed = 0;
+        for (size_t c = 0; c < BLAKE3_TEST_VECTOR_COUNT; c++) {
+            const blake3_test_vector_t *tv = &BLAKE3_TEST_VECTORS[c];
+            hex_decode(expected_hex(tv, (tv_mode_t)mode), expected, sizeof(expected));
+
+            for (size_t s = 0; s < sizeof(steps) / sizeof(steps[0]); s++) {
+                init_mode(&hasher, (tv_mode_t)mode);
+                for (size_t pos = 0; pos < tv->input_len; pos += steps[s]) {
+                    size_t take = tv->input_len - pos;
+                    blake3_hasher_update_iterative(&hasher, &g_input[pos], take < steps[s] ? take : steps[s]);
+                }
+                blake3_hasher_finalize(&hasher, out, sizeof(out));
+                failed += (memcmp(out, expected, sizeof(out)) != 0) ? 1 : 0;
+            }
+        }
+        snprintf(msg, sizeof(msg), "BLAKE3 vectors [iterative subtree]: %s", TV_MODE_NAMES[mode]);
+        TEST_ASSERT_EQ(failed, 0, msg);
+    }
+}
+
+void test_blake3_update_tbb(void) {
+    /* blake3_hasher_update_tbb on the pthread pool (BLAKE3_USE_PTHREADS):
+     * same output for any thread count, one-shot and in uneven pieces */
+    static const unsigned threads[] = { 1, 2, 3, 8 };
+    static const size_t pieces[] = { 1000, 40000, 65536 + 7, 1 << 20 };
+    static blake3_hasher hasher;
+    uint8_t expected[BLAKE3_TV_OUT_LEN];
+    uint8_t out[BLAKE3_TV_OUT_LEN];
+    char msg[128];
+
+    for (size_t i = 0; i < sizeof(g_mt_input); i++) {
+        g_mt_input[i] = (uint8_t)(i % 251);
+    }
+
+    for (size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); t++) {
+        size_t failed = 0;
+        blake3_pthread_set_threads(threads[t]);
+
+        for (size_t c = 0; c < BLAKE3_TEST_VECTOR_COUNT; c++) {
+            const blake3_test_vector_t *tv = &BLAKE3_TEST_VECTORS[c];
+            hex_decode(tv->hash, expected, sizeof(expected));
+            blake3_hasher_init(&hasher);
+            blake3_hasher_update_tbb(&hasher, g_input, tv->input_len);
+            blake3_hasher_finalize(&hasher, out, sizeof(out));
+            failed += (memcmp(out, expected, sizeof(out)) != 0) ? 1 : 0;
+        }
+
+        /* Large enough to queue subtrees; checked against one thread */
+        blake3_hasher_init(&hasher);
+        blake3_hasher_update(&hasher, g_mt_input, sizeof(g_mt_input));
+        blake3_hasher_finalize(&hasher, expected, sizeof(expected));
+
+        blake3_hasher_init(&hasher);
+        blake3_hasher_update_tbb(&hasher, g_mt_input, sizeof(g_mt_input));
+        blake3_hasher_finalize(&hasher, out, sizeof(out));
+        failed += (memcmp(out, expected, sizeof(out)) != 0) ? 1 : 0;
+
+        blake3_hasher_init(&hasher);
+        for (size_t pos = 0, p = 0; pos < sizeof(g_mt_input); p++) {
+            size_t take = sizeof(g_mt_input) - pos;
+            size_t piece = pieces[p % (sizeof(pieces) / sizeof(pieces[0]))];
+            take = take < piece ? take : piece;
+            blake3_hasher_update_tbb(&hasher, &g_mt_input[pos], take);
+            pos += take;
+        }
+        blake3_hasher_finalize(&hasher, out, sizeof(out));
+        failed += (memcmp(out, expected, sizeof(out)) != 0) ? 1 : 0;
+
+        snprintf(msg, sizeof(msg), "BLAKE3 update_tbb: %u thread(s) match single-threaded", threads[t]);
+        TEST_ASSERT_EQ(failed, 0, msg);
+    }
+
+    blake3_pthread_set_threads(0);
+}
+
+static bool hasher_state_equal(const blake3_hasher *a, const blake3_hasher *b) {
+    uint8_t out_a[2 * BLAKE3_OUT_LEN];
+    uint8_t out_b[2 * BLAKE3_OUT_LEN];
+
+    blake3_hasher_finalize(a, out_a, sizeof(out_a));
+    blake3_hasher_finalize(b, out_b, sizeof(out_b));
+    return memcmp(a->chunk.cv, b->chunk.cv, sizeof(a->chunk.cv)) == 0 &&
+           a->chunk.chunk_counter == b->chunk.chunk_counter &&
+           memcmp(a->chunk.buf, b->chunk.buf, sizeof(a->chunk.buf)) == 0 &&
+           a->chunk.buf_len == b->chunk.buf_len &&
+           a->chunk.blocks_compressed == b->chunk.blocks_compressed &&
+           a->cv_stack_len == b->cv_stack_len &&
+           memcmp(a->cv_stack, b->cv_stack, a->cv_stack_len * BLAKE3_OUT_LEN) == 0 &&
+           memcmp(out_a, out_b, sizeof(out_a)) == 0;
+}
+
+void test_blake3_small_update_differential(void) {
+    /* Piece sizes, cycled: APDU-sized, block and chunk edges, and mixes that
+     * enter the fast path with a partly filled chunk and then overflow it */
+    static const struct {
+        size_t len[4];
+        size_t count;
+    } patterns[] = {
+        { { 1 }, 1 },
+        { { 63, 64, 65 }, 3 },
+        { { 255 }, 1 },
+        { { 1024 }, 1 },
+        { { 1000, 24, 1 }, 3 },
+        { { 0, 7, 1100, 3 }, 4 },
+        { { 2048, 1, 1023 }, 3 },
+        { { 200, 3000, 17 }, 3 },
+    };
+    static blake3_hasher fast;
+    static blake3_hasher general;
+    char msg[128];
+
+    for (size_t p = 0; p < sizeof(patterns) / sizeof(patterns[0]); p++) {
+        for (int keyed = 0; keyed < 2; keyed++) {
+            size_t mismatches = 0;
+            size_t pos = 0;
+            size_t step = 0;
+
+            if (keyed) {
+                blake3_hasher_init_keyed(&fast, g_input);
+                blake3_hasher_init_keyed(&general, g_input);
+            } else {
+                blake3_hasher_init(&fast);
+                blake3_hasher_init(&general);
+            }
+            /* Stop well past several chunks so stack merges are exercised */
+            while (pos < 9 * BLAKE3_CHUNK_LEN + 100) {
+                size_t len = patterns[p].len[step++ % patterns[p].count];
+                blake3_hasher_update(&fast, &g_input[pos], len);
+                blake3_hasher_update_general(&general, &g_input[pos], len);
+                pos += len;
+                mismatches += hasher_state_equal(&fast, &general) ? 0 : 1;
+            }
+            int n = snprintf(msg, sizeof(msg), "BLAKE3 fast path: pieces %zu", patterns[p].len[0]);
+            for (size_t i = 1; i < patterns[p].count; i++) {
+                n += snprintf(msg + n, sizeof(msg) - (size_t)n, "/%zu", patterns[p].len[i]);
+            }
+            snprintf(msg + n, sizeof(msg) - (size_t)n, "%s match general path", keyed ? " (keyed)" : "");
+            TEST_ASSERT_EQ(mismatches, 0, msg);
+        }
+    }
+}
+
+void test_blake3_backend_throughput(void) {
+    static const size_t lengths[] = { 64, 1024, 8192, TV_MAX_INPUT };
+    static blake3_hasher hasher;
+    uint8_t out[BLAKE3_OUT_LEN];
+
+    for (size_t b = 0; b < blake3_backend_count(); b++) {
+        blake3_backend_select(b);
+        printf("  [%s]", blake3_backend_get(b)->name);
+
+        for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+            /* About 2 MB per length, at least 4 runs; keep the fastest */
+            size_t runs = (2u << 20) / lengths[l];
+            uint64_t best = UINT64_MAX;
+            if (runs < 4) {
+                runs = 4;
+            }
+            for (size_t r = 0; r < runs; r++) {
+                uint64_t start = timer_now();
+                blake3_hasher_init(&hasher);
+                blake3_hasher_update(&hasher, g_input, lengths[l]);
+                blake3_hasher_finalize(&hasher, out, sizeof(out));
+                uint64_t elapsed = timer_now() - start;
+                if (elapsed < best) {
+                    best = elapsed;
+                }
+            }
+            printf(" %zu B: %.2f", lengths[l], (double)best / (double)lengths[l]);
+        }
+        printf(" (%s)\n", TIMER_UNIT);
+    }
+
+    blake3_backend_select(0);
+}
+
+void run_blake3_vector_tests(void) {
+    TEST_SUITE_START("BLAKE3 Test Vectors");
+
+    test_blake3_vectors_per_backend();
+    test_blake3_vectors_app_wrapper();
+    test_blake3_iterative_subtree();
+    test_blake3_update_tbb();
+    test_blake3_small_update_differential();
+    test_blake3_backend_throughput();
+
+    TEST_SUITE_END();
+}
@@ -0,0 +1,209 @@
+/*
+ * SUM Chain Ledger App - Host Ed25519 / SLIP-10 Tests
+ *
+ * Vectors: FIPS 180-4 (SHA-512 "abc"), RFC 4231 test case 2 (HMAC-SHA512),
+ * RFC 8032 section 7.1 tests 1-3, SLIP-10 Ed25519 test vector 1.
+ */
+
+#include "test_utils.h"
+#include "sha512.h"
+#include "ed25519.h"
+#include "slip10.h"
+#include "crypto.h"
+#include <string.h>
+
+static size_t hex_decode(const char *hex, uint8_t *out, size_t out_len) {
+    size_t n = strlen(hex) / 2;
+    if (n > out_len) {
+        return 0;
+    }
+    for (size_t i = 0; i < n; i++) {
+        unsigned int b;
+        sscanf(hex + 2 * i, "%2x", &b);
+        out[i] = (uint8_t)b;
+    }
+    return n;
+}
+
+void test_sha512_vectors(void) {
+    uint8_t out[SHA512_DIGEST_LEN];
+    uint8_t expected[SHA512_DIGEST_LEN];
+    uint8_t data[1000];
+    sha512_ctx_t ctx;
+
+    sha512((const uint8_t *)"abc", 3, out);
+    hex_decode("ddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a"
+               "2192992a274fc1a836ba3c23a3feebbd454d4423643ce80e2a9ac94fa54ca49f",
+               expected, sizeof(expected));
+    TEST_ASSERT_MEM_EQ(out, expected, 64, "SHA-512(\"abc\")");
+
+    /* Multi-block input fed in odd-sized pieces */
+    memset(data, 'a', sizeof(data));
+    sha512_init(&ctx);
+    sha512_update(&ctx, data, 1);
+    sha512_update(&ctx, data, 300);
+    sha512_update(&ctx, data, 699);
+    sha512_final(&ctx, out);
+    hex_decode("67ba5535a46e3f86dbfbed8cbbaf0125c76ed549ff8b0b9e03e0c88cf90fa634"
+               "fa7b12b47d77b694de488ace8d9a65967dc96df599727d3292a8d9d447709c97",
+               expected, sizeof(expected));
+    TEST_ASSERT_MEM_EQ(out, expected, 64, "SHA-512 1000 x 'a' incremental");
+
+    hmac_sha512((const uint8_t *)"Jefe", 4,
+                (const uint8_t *)"what do ya want for nothing?", 28, out);
+    hex_decode("164b7a7bfcf819e2e395fbe73b56e0a387bd64222e831fd610270cd7ea250554"
+               "9758bf75c05a994a6d034f65f8f0e6fdcaeab1a34d4a6b4b636e070a38bce737",
+               expected, sizeof(expected));
+    TEST_ASSERT_MEM_EQ(out, expected, 64, "HMAC-SHA512 RFC 4231 case 2");
+}
+
+typedef struct {
+    const char *secret;
+    const char *pubkey;
+    const char *msg;
+    const char *sig;
+} rfc8032_vector_t;
+
+static const rfc8032_vector_t RFC8032_VECTORS[] = {
+    {
+        "9d61b19deffd5a60ba844af492ec2cc44449c5697b326919703bac031cae7f60",
+        "d75a980182b10ab7d54bfed3c964073a0ee172f3daa62325af021a68f707511a",
+        "",
+        "e5564300c360ac729086e2cc806e828a84877f1eb8e5d974d873e06522490155"
+        "5fb8821590a33bacc61e39701cf9b46bd25bf5f0595bbe24655141438e7a100b"
+    },
+    {
+        "4ccd089b28ff96da9db6c346ec114e0f5b8a319f35aba624da8cf6ed4fb8a6fb",
+        "3d4017c3e843895a92b70aa74d1b7ebc9c982ccf2ec4968cc0cd55f12af4660c",
+        "72",
+        "92a009a9f0d4cab8720e820b5f642540a2b27b5416503f8fb3762223ebdb69da"
+        "085ac1e43e15996e458f3613d0f11d8c387b2eaeb4302aeeb00d291612bb0c00"
+    },
+    {
+        "c5aa8df43f9f837bedb7442f31dcb7b166d38535076f094b85ce3a2e0b4458f7",
+        "fc51cd8e6218a1a38da47ed00230f0580816ed13ba3303ac5deb911548908025",
+        "af82",
+        "6291d657deec24024827e69c3abe01a30ce548a284743a445e3680d7db5ac3ac"
+        "18ff9b538d16f290ae67f760984dc6594a7c15e9716ed28dc027beceea1ec40a"
+    },
+};
+
+void test_ed25519_rfc8032(void) {
+    for (size_t i = 0; i < sizeof(RFC8032_VECTORS) / sizeof(RFC8032_VECTORS[0]); i++) {
+        const rfc8032_vector_t *v = &RFC8032_VECTORS[i];
+        uint8_t secret[32], pub_expected[32], sig_expected[64], msg[8];
+        uint8_t pub[32], sig[64];
+        char label[64];
+
+        hex_decode(v->secret, secret, sizeof(secret));
+        hex_decode(v->pubkey, pub_expected, sizeof(pub_expected));
+        hex_decode(v->sig, sig_expected, sizeof(sig_expected));
+        size_t msg_len = hex_decode(v->msg, msg, sizeof(msg));
+
+        ed25519_public_key(secret, pub);
+        snprintf(label, sizeof(label), "RFC 8032 test %zu public key", i + 1);
+        TEST_ASSERT_MEM_EQ(pub, pub_expected, 32, label);
+
+        ed25519_sign(secret, pub, msg, msg_len, sig);
+        snprintf(label, sizeof(label), "RFC 8032 test %zu signature", i + 1);
+        TEST_ASSERT_MEM_EQ(sig, sig_expected, 64, label);
+
+        snprintf(label, sizeof(label), "RFC 8032 test %zu verifies", i + 1);
+        TEST_ASSERT_TRUE(ed25519_verify(pub, msg, msg_len, sig), label);
+    }
+}
+
+void test_ed25519_verify_rejects(void) {
+    const rfc8032_vector_t *v = &RFC8032_VECTORS[2];
+    uint8_t pub[32], sig[64], msg[2], bad[64];
+
+    hex_decode(v->pubkey, pub, sizeof(pub));
+    hex_decode(v->sig, sig, sizeof(sig));
+    hex_decode(v->msg, msg, sizeof(msg));
+
+    memcpy(bad, sig, 64);
+    bad[0] ^= 0x01;
+    TEST_ASSERT_FALSE(ed25519_verify(pub, msg, 2, bad), "Ed25519 rejects modified R");
+
+    memcpy(bad, sig, 64);
+    bad[40] ^= 0x01;
+    TEST_ASSERT_FALSE(ed25519_verify(pub, msg, 2, bad), "Ed25519 rejects modified S");
+
+    msg[1] ^= 0x01;
+    TEST_ASSERT_FALSE(ed25519_verify(pub, msg, 2, sig), "Ed25519 rejects modified message");
+    msg[1] ^= 0x01;
+
+    /* S + L is a different encoding of the same scalar: must be rejected */
+    static const uint8_t L[32] = {
+        0xed, 0xd3, 0xf5, 0x5c, 0x1a, 0x63, 0x12, 0x58, 0xd6, 0x9c, 0xf7, 0xa2, 0xde, 0xf9, 0xde, 0x14,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10
+    };
+    memcpy(bad, sig, 64);
+    unsigned int carry = 0;
+    for (int i = 0; i < 32; i++) {
+        carry += (unsigned int)bad[32 + i] + L[i];
+        bad[32 + i] = (uint8_t)carry;
+        carry >>= 8;
+    }
+    TEST_ASSERT_FALSE(ed25519_verify(pub, msg, 2, bad), "Ed25519 rejects non-canonical S");
+}
+
+void test_slip10_vector1(void) {
+    uint8_t seed[16], priv[32], chain[32], expected[32];
+    uint32_t path[2] = { 0x80000000u, 0x80000001u };
+
+    hex_decode("000102030405060708090a0b0c0d0e0f", seed, sizeof(seed));
+
+    slip10_ed25519_derive(seed, sizeof(seed), path, 0, priv, chain);
+    hex_decode("2b4be7f19ee27bbf30c667b642d5f4aa69fd169872f8fc3059c08ebae2eb19e7", expected, 32);
+    TEST_ASSERT_MEM_EQ(priv, expected, 32, "SLIP-10 m private key");
+    hex_decode("90046a93de5380a72b5e45010748567d5ea02bbf6522f979e05c0d8d8ca9fffb", expected, 32);
+    TEST_ASSERT_MEM_EQ(chain, expected, 32, "SLIP-10 m chain code");
+
+    slip10_ed25519_derive(seed, sizeof(seed), path, 2, priv, chain);
+    hex_decode("b1d0bad404bf35da785a64ca1ac54b2617211d2777696fbffaf208f746ae84f2", expected, 32);
+    TEST_ASSERT_MEM_EQ(priv, expected, 32, "SLIP-10 m/0'/1' private key");
+    hex_decode("a320425f77d1b5c2505a6b1b27382b37368ee640e3557c315416801243552f14", expected, 32);
+    TEST_ASSERT_MEM_EQ(chain, expected, 32, "SLIP-10 m/0'/1' chain code");
+
+    path[1] = 1;
+    TEST_ASSERT_FALSE(slip10_ed25519_derive(seed, sizeof(seed), path, 2, priv, chain),
+                      "SLIP-10 rejects non-hardened index");
+}
+
+void test_crypto_host_backend(void) {
+    bip32_path_t path;
+    uint8_t pub[32], expected[32], sig[64], hash[32];
+
+    /* Host seed is SLIP-10 vector 1: m/0' public key */
+    memset(&path, 0, sizeof(path));
+    path.length = 1;
+    path.path[0] = 0x80000000u;
+    TEST_ASSERT_TRUE(crypto_derive_pubkey(&path, pub), "Host crypto derives m/0'");
+    hex_decode("8c8a13df77a28f3445213a0f432fde644acaa215fc72dcdf300d5efaa85d350c", expected, 32);
+    TEST_ASSERT_MEM_EQ(pub, expected, 32, "Host crypto m/0' matches SLIP-10 vector");
+
+    /* Signature over the tx hash verifies against the derived key */
+    path.length = 5;
+    path.path[0] = 0x80000000u | 44;
+    path.path[1] = 0x80000000u | 12345;
+    path.path[2] = 0x80000000u;
+    path.path[3] = 0x80000000u;
+    path.path[4] = 0x80000000u;
+    memset(hash, 0x5A, sizeof(hash));
+    crypto_derive_pubkey(&path, pub);
+    TEST_ASSERT_TRUE(crypto_sign_hash(&path, hash, sig), "Host crypto signs");
+    TEST_ASSERT_TRUE(ed25519_verify(pub, hash, sizeof(hash), sig), "Host signature verifies");
+}
+
+void run_ed25519_tests(void) {
+    TEST_SUITE_START("Ed25519 / SLIP-10 (host)");
+
+    test_sha512_vectors();
+    test_ed25519_rfc8032();
+    test_ed25519_verify_rejects();
+    test_slip10_vector1();
+    test_crypto_host_backend();
+
+    TEST_SUITE_END();
+}
@@ -13,16 +13,42 @@ int g_tests_failed = 0;
 
 /* Test suite declarations */
 extern void run_blake3_tests(void);
+extern void run_blake3_vector_tests(void);
 extern void run_address_tests(void);
 extern void run_tx_parser_tests(void);
+extern void run_tx_encoder_tests(void);
+extern void run_apdu_client_tests(void);
+extern void run_sign_scheduler_tests(void);
+extern void run_app_stats_tests(void);
+extern void run_app_trace_tests(void);
+extern void run_sig_cache_tests(void);
+extern void run_work_area_tests(void);
+extern void run_ed25519_tests(void);
+extern void run_sig_verify_tests(void);
+extern void run_merkle_tests(void);
+extern void run_sign_hash_tests(void);
+extern void run_bip32_ed25519_tests(void);
 
 int main(void) {
     printf("SUM Chain Ledger App - Unit Tests\n");
     printf("========================================\n");
 
     run_blake3_tests();
+    run_blake3_vector_tests();
     run_address_tests();
     run_tx_parser_tests();
+    run_tx_encoder_tests();
+    run_apdu_client_tests();
+    run_sign_scheduler_tests();
+    run_app_stats_tests();
+    run_app_trace_tests();
+    run_sig_cache_tests();
+    run_work_area_tests();
+    run_ed25519_tests();
+    run_sig_verify_tests();
+    run_merkle_tests();
+    run_sign_hash_tests();
+    run_bip32_ed25519_tests();
 
     print_test_summary();
 
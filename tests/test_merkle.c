@@ -0,0 +1,271 @@
+/*
+ * SUM Chain Ledger App - Merkle Batch Signing Tests
+ */
+
+#include "test_utils.h"
+#include "merkle.h"
+#include "merkle_proof.h"
+#include "apdu_handlers.h"
+#include "apdu_client.h"
+#include "apdu_loopback.h"
+#include "tx_encoder.h"
+#include "tx_display.h"
+#include "ed25519.h"
+#include "crypto.h"
+#include "crypto/sum_blake3.h"
+#include <string.h>
+
+#define MAX_LEAVES_TESTED  33
+#define STREAM_TXS         40    /* 3280 bytes: txs straddle APDU boundaries */
+
+static uint8_t g_stream[STREAM_TXS * TX_TRANSFER_ENCODED_LEN];
+static uint8_t g_digests[STREAM_TXS][HASH_LEN];
+static uint8_t g_nodes[2 * STREAM_TXS + MERKLE_MAX_DEPTH][HASH_LEN];
+
+static void make_stream(size_t count, uint64_t odd_chain_at) {
+    tx_parsed_t tx;
+
+    memset(&tx, 0, sizeof(tx));
+    tx.version = 1;
+    memset(tx.sender, 0x11, ADDRESS_LEN);
+    tx.gas_price = 3;
+    tx.gas_limit = 21000;
+
+    for (size_t i = 0; i < count; i++) {
+        uint8_t *out = &g_stream[i * TX_TRANSFER_ENCODED_LEN];
+        tx.chain_id = (i == odd_chain_at) ? 2 : 1;
+        tx.nonce = i;
+        memset(tx.recipient, (int)i, ADDRESS_LEN);
+        tx.amount = 0xFFFFFFFFFFFFFF00ULL + i;     /* Sum overflows 64 bits */
+        tx_encode_transfer(&tx, out, TX_TRANSFER_ENCODED_LEN);
+        sum_blake3_hash(out, TX_TRANSFER_ENCODED_LEN, g_digests[i]);
+    }
+}
+
+/* RFC 6962 MTH, recursive, as an independent reference for the tree shape */
+static sum_blake3_ctx_t g_scratch;
+
+static void reference_root(const uint8_t (*digests)[HASH_LEN], size_t n, uint8_t out[HASH_LEN]) {
+    uint8_t left[HASH_LEN], right[HASH_LEN];
+    size_t k = 1;
+
+    if (n == 1) {
+        merkle_leaf_hash(&g_scratch, digests[0], out);
+        return;
+    }
+    while (k * 2 < n) {
+        k *= 2;
+    }
+    reference_root(digests, k, left);
+    reference_root(digests + k, n - k, right);
+    merkle_node_hash(&g_scratch, left, right, out);
+}
+
+void test_merkle_accumulator_matches_tree(void) {
+    merkle_acc_t acc;
+    merkle_tree_t tree;
+    merkle_proof_t proof;
+    uint8_t acc_root[HASH_LEN], ref_root[HASH_LEN];
+    bool roots_ok = true, proofs_ok = true, tamper_ok = true;
+
+    make_stream(MAX_LEAVES_TESTED, (uint64_t)-1);
+
+    merkle_acc_init(&acc);
+    TEST_ASSERT_FALSE(merkle_acc_root(&acc, &g_scratch, acc_root), "Merkle: empty tree has no root");
+
+    for (size_t n = 1; n <= MAX_LEAVES_TESTED; n++) {
+        merkle_acc_push(&acc, &g_scratch, g_digests[n - 1]);
+        merkle_acc_root(&acc, &g_scratch, acc_root);
+        reference_root((const uint8_t (*)[HASH_LEN])g_digests, n, ref_root);
+
+        if (!merkle_tree_build(&tree, (const uint8_t (*)[HASH_LEN])g_digests, n,
+                               g_nodes, merkle_tree_nodes(n)) ||
+            memcmp(acc_root, ref_root, HASH_LEN) != 0 ||
+            memcmp(tree.root, ref_root, HASH_LEN) != 0) {
+            roots_ok = false;
+        }
+
+        for (size_t i = 0; i < n; i++) {
+            if (!merkle_tree_proof(&tree, i, &proof) ||
+                !merkle_proof_verify(g_digests[i], &proof, ref_root)) {
+                proofs_ok = false;
+            }
+            /* Wrong leaf, wrong position and truncated paths must fail */
+            if (merkle_proof_verify(g_digests[(i + 1) % MAX_LEAVES_TESTED], &proof, ref_root)) {
+                tamper_ok = false;
+            }
+            if (n > 1) {
+                proof.index ^= 1;
+                if (proof.index < n && merkle_proof_verify(g_digests[i], &proof, ref_root)) {
+                    tamper_ok = false;
+                }
+                proof.index ^= 1;
+                proof.length--;
+                if (merkle_proof_verify(g_digests[i], &proof, ref_root)) {
+                    tamper_ok = false;
+                }
+            }
+        }
+    }
+
+    TEST_ASSERT_TRUE(roots_ok, "Merkle: accumulator, level tree and RFC 6962 reference agree (1..33)");
+    TEST_ASSERT_TRUE(proofs_ok, "Merkle: every inclusion proof verifies");
+    TEST_ASSERT_TRUE(tamper_ok, "Merkle: tampered proofs rejected");
+    TEST_ASSERT_TRUE(acc.stack_len == 2, "Merkle: 33 leaves keep two subtree roots");
+    TEST_ASSERT_EQ(merkle_tree_nodes(0), 0, "Merkle: empty tree needs no nodes");
+    TEST_ASSERT_FALSE(merkle_tree_build(&tree, (const uint8_t (*)[HASH_LEN])g_digests, 5,
+                                        g_nodes, merkle_tree_nodes(5) - 1),
+                      "Merkle: short arena rejected");
+}
+
+void test_merkle_device_batch(void) {
+    apdu_transport_loopback_t sim;
+    apdu_device_t dev;
+    apdu_device_t *dev_ptr = &dev;
+    apdu_request_t req;
+    merkle_tree_t tree;
+    bip32_path_t path;
+    uint8_t pubkey[PUBKEY_LEN];
+    uint8_t msg[HASH_LEN];
+
+    make_path(&path, 5, 0);
+    make_stream(STREAM_TXS, (uint64_t)-1);
+    crypto_derive_pubkey(&path, pubkey);
+    TEST_ASSERT_TRUE(merkle_tree_build(&tree, (const uint8_t (*)[HASH_LEN])g_digests, STREAM_TXS,
+                                       g_nodes, sizeof(g_nodes) / sizeof(g_nodes[0])),
+                     "Batch: host tree built");
+
+    apdu_transport_loopback_init(&sim, 0);
+    apdu_device_init(&dev, &sim.base);
+
+    apdu_request_init_sign_merkle(&req, &path, g_stream, sizeof(g_stream), 0, NULL, NULL);
+    TEST_ASSERT_EQ(req.plan.frame_count, 13, "Batch: 3280-byte stream packed in 13 APDUs");
+    apdu_device_submit(&dev, &req);
+    apdu_client_run(&dev_ptr, 1, 1000);
+
+    TEST_ASSERT_TRUE(req.status == APDU_STATUS_OK && req.sw == SW_OK, "Batch: device signs stream");
+    TEST_ASSERT_EQ(req.resp_len, HASH_LEN + SIGNATURE_LEN, "Batch: response is root || signature");
+    TEST_ASSERT_MEM_EQ(req.resp, tree.root, HASH_LEN, "Batch: device root matches host tree");
+
+    merkle_signing_hash(&g_scratch, tree.root, STREAM_TXS, msg);
+    TEST_ASSERT_TRUE(ed25519_verify(pubkey, msg, HASH_LEN, req.resp + HASH_LEN),
+                     "Batch: signature verifies over the signing message");
+    TEST_ASSERT_FALSE(sim.state.sign_session.initialized, "Batch: session closed after signing");
+
+    sim.base.close(&sim.base);
+}
+
+/* Run a whole stream through apdu_dispatch in chunks of chunk_len */
+static uint16_t dispatch_stream(const uint8_t *stream, size_t len, size_t chunk_len) {
+    uint8_t data[APDU_MAX_DATA_LEN];
+    uint8_t out[APDU_MAX_RESP_LEN];
+    uint8_t *tx;
+    bip32_path_t path;
+    size_t off = 0;
+    uint16_t sw;
+
+    make_path(&path, 5, 0);
+    size_t path_len = apdu_serialize_path(&path, data, sizeof(data));
+
+    tx = out;
+    sw = apdu_dispatch(CLA_SUMCHAIN, INS_SIGN_MERKLE, P1_FIRST_CHUNK,
+                       (len == 0) ? P2_LAST_CHUNK : P2_MORE_CHUNKS,
+                       (uint8_t)path_len, data, &tx);
+    while (sw == SW_OK && off < len) {
+        size_t take = (len - off < chunk_len) ? len - off : chunk_len;
+        memcpy(data, stream + off, take);
+        off += take;
+        tx = out;
+        sw = apdu_dispatch(CLA_SUMCHAIN, INS_SIGN_MERKLE, P1_MORE_CHUNK,
+                           (off == len) ? P2_LAST_CHUNK : P2_MORE_CHUNKS,
+                           (uint8_t)take, data, &tx);
+    }
+
+    return sw;
+}
+
+void test_merkle_device_errors(void) {
+    make_stream(4, 2);
+    TEST_ASSERT_EQ(dispatch_stream(g_stream, 4 * TX_TRANSFER_ENCODED_LEN, 100), SW_INVALID_DATA,
+                   "Batch: mixed chain IDs rejected");
+
+    make_stream(4, (uint64_t)-1);
+    TEST_ASSERT_EQ(dispatch_stream(g_stream, 4 * TX_TRANSFER_ENCODED_LEN, 7), SW_OK,
+                   "Batch: 7-byte chunks accepted");
+    TEST_ASSERT_EQ(dispatch_stream(g_stream, 4 * TX_TRANSFER_ENCODED_LEN - 1, 100), SW_TX_PARSE_ERROR,
+                   "Batch: stream ending inside a tx rejected");
+    TEST_ASSERT_EQ(dispatch_stream(g_stream, 0, 100), SW_TX_PARSE_ERROR,
+                   "Batch: empty batch rejected");
+    TEST_ASSERT_EQ(dispatch_stream(g_stream, TX_TRANSFER_ENCODED_LEN, 255), SW_OK,
+                   "Batch: single-tx batch accepted");
+}
+
+void test_merkle_session_isolation(void) {
+    uint8_t data[APDU_MAX_DATA_LEN];
+    uint8_t out[APDU_MAX_RESP_LEN];
+    uint8_t *tx = out;
+    bip32_path_t path;
+
+    make_path(&path, 5, 0);
+    make_stream(1, (uint64_t)-1);
+    size_t path_len = apdu_serialize_path(&path, data, sizeof(data));
+
+    apdu_dispatch(CLA_SUMCHAIN, INS_SIGN_MERKLE, P1_FIRST_CHUNK, P2_MORE_CHUNKS,
+                  (uint8_t)path_len, data, &tx);
+    memcpy(data, g_stream, TX_TRANSFER_ENCODED_LEN);
+    tx = out;
+    TEST_ASSERT_EQ(apdu_dispatch(CLA_SUMCHAIN, INS_SIGN_TX, P1_MORE_CHUNK, P2_LAST_CHUNK,
+                                 TX_TRANSFER_ENCODED_LEN, data, &tx), SW_SESSION_ERROR,
+                   "Batch: SIGN_TX cannot continue a batch session");
+
+    reset_sign_session();
+    path_len = apdu_serialize_path(&path, data, sizeof(data));
+    tx = out;
+    apdu_dispatch(CLA_SUMCHAIN, INS_SIGN_TX, P1_FIRST_CHUNK, P2_MORE_CHUNKS,
+                  (uint8_t)path_len, data, &tx);
+    memcpy(data, g_stream, TX_TRANSFER_ENCODED_LEN);
+    tx = out;
+    TEST_ASSERT_EQ(apdu_dispatch(CLA_SUMCHAIN, INS_SIGN_MERKLE, P1_MORE_CHUNK, P2_LAST_CHUNK,
+                                 TX_TRANSFER_ENCODED_LEN, data, &tx), SW_SESSION_ERROR,
+                   "Batch: SIGN_MERKLE cannot continue a SIGN_TX session");
+    reset_sign_session();
+}
+
+void test_merkle_batch_display(void) {
+    merkle_batch_t batch;
+    tx_batch_display_t display;
+    char buf[TX_DISPLAY_U128_MAX_LEN];
+
+    format_u128_decimal(0, 1, buf, sizeof(buf));
+    TEST_ASSERT_STR_EQ(buf, "18446744073709551616", "u128: 2^64");
+    format_u128_decimal(UINT64_MAX, 1, buf, sizeof(buf));
+    TEST_ASSERT_STR_EQ(buf, "36893488147419103231", "u128: 2^65 - 1");
+    format_u128_decimal(UINT64_MAX, UINT64_MAX, buf, sizeof(buf));
+    TEST_ASSERT_STR_EQ(buf, "340282366920938463463374607431768211455", "u128: 2^128 - 1");
+
+    memset(&batch, 0, sizeof(batch));
+    TEST_ASSERT_FALSE(tx_batch_display_format(&batch, &display), "Batch display: empty batch rejected");
+
+    batch.tree.count = 40;
+    batch.chain_id = 7;
+    batch.amount_lo = 0xFFFFFFFFFFFFFFFFULL;
+    batch.amount_hi = 1;
+    batch.fee_lo = 2520000;
+    TEST_ASSERT_TRUE(tx_batch_display_format(&batch, &display), "Batch display: formatted");
+    TEST_ASSERT_STR_EQ(display.count, "40", "Batch display: count");
+    TEST_ASSERT_STR_EQ(display.chain_id, "7", "Batch display: chain ID");
+    TEST_ASSERT_STR_EQ(display.total_amount, "36893488147419103231", "Batch display: 128-bit total");
+    TEST_ASSERT_STR_EQ(display.total_fee, "2520000", "Batch display: total fee");
+}
+
+void run_merkle_tests(void) {
+    TEST_SUITE_START("Merkle Batch Signing");
+
+    test_merkle_accumulator_matches_tree();
+    test_merkle_device_batch();
+    test_merkle_device_errors();
+    test_merkle_session_isolation();
+    test_merkle_batch_display();
+
+    TEST_SUITE_END();
+}
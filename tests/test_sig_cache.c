@@ -0,0 +1,192 @@
+/*
+ * SUM Chain Ledger App - Last-Signature Cache Tests
+ */
+
+#include "test_utils.h"
+#include "apdu_handlers.h"
+#include "apdu_client.h"
+#include "tx_encoder.h"
+#include "sig_cache.h"
+#include "settings.h"
+#include <string.h>
+
+/* Three-pair multi-transfer; the last amount tells replacements apart */
+static size_t make_multi_tx(uint8_t *tx_bytes, size_t tx_size, uint64_t last_amount) {
+    uint8_t recipients[3][ADDRESS_LEN];
+    uint64_t amounts[3] = {100, 200, last_amount};
+    tx_parsed_t parsed;
+
+    memset(&parsed, 0, sizeof(parsed));
+    parsed.version = 1;
+    parsed.chain_id = 1;
+    parsed.nonce = 9;
+    parsed.gas_price = 1;
+    parsed.gas_limit = 21000;
+    for (size_t i = 0; i < 3; i++) {
+        memset(recipients[i], 0x10 + (int)i, ADDRESS_LEN);
+    }
+    return tx_encode_multi_transfer(&parsed, recipients, amounts, 3, tx_bytes, tx_size);
+}
+
+/* One-APDU SIGN_TX; returns the status word, signature in sig */
+static uint16_t sign_tx_bytes(const bip32_path_t *path, const uint8_t *tx_bytes, size_t tx_len,
+                              uint8_t sig[SIGNATURE_LEN]) {
+    uint8_t data[APDU_MAX_DATA_LEN];
+    uint8_t resp[APDU_MAX_RESP_LEN];
+    size_t resp_len;
+
+    size_t path_len = apdu_serialize_path(path, data, sizeof(data));
+    memcpy(data + path_len, tx_bytes, tx_len);
+    uint16_t sw = dispatch(INS_SIGN_TX, P1_FIRST_CHUNK, P2_LAST_CHUNK, data,
+                           (uint8_t)(path_len + tx_len), resp, &resp_len);
+    if (sw == SW_OK && resp_len == SIGNATURE_LEN) {
+        memcpy(sig, resp, SIGNATURE_LEN);
+    }
+    return sw;
+}
+
+static uint16_t sign_tx(const bip32_path_t *path, const uint8_t *tx_bytes, uint8_t sig[SIGNATURE_LEN]) {
+    return sign_tx_bytes(path, tx_bytes, TX_TRANSFER_ENCODED_LEN, sig);
+}
+
+/* Number of review screens shown since the trace was last cleared */
+static size_t reviews_shown(void) {
+    uint8_t resp[APDU_MAX_RESP_LEN];
+    size_t resp_len;
+    size_t shown = 0;
+
+    dispatch(INS_GET_TRACE, 0, P2_TRACE_CLEAR, NULL, 0, resp, &resp_len);
+    for (size_t off = APP_TRACE_HEADER_LEN; off + APP_TRACE_ENTRY_LEN <= resp_len;
+         off += APP_TRACE_ENTRY_LEN) {
+        shown += (resp[off + 4] == APP_TRACE_UI_SHOW) ? 1 : 0;
+    }
+    return shown;
+}
+
+void test_sig_cache_resend_skips_review(void) {
+    uint8_t tx_bytes[TX_TRANSFER_ENCODED_LEN];
+    uint8_t first[SIGNATURE_LEN];
+    uint8_t again[SIGNATURE_LEN];
+    bip32_path_t path;
+
+    make_path(&path, 3, 0);
+    make_transfer_tx(tx_bytes, 7, 1000);
+    sig_cache_clear();
+    reviews_shown();
+
+    TEST_ASSERT_EQ(sign_tx(&path, tx_bytes, first), SW_OK, "Sig cache: first SIGN_TX signs");
+    TEST_ASSERT_EQ(reviews_shown(), 1, "Sig cache: first SIGN_TX is reviewed");
+    TEST_ASSERT_TRUE(G_state.sig_cache.valid, "Sig cache: approved signature kept");
+
+    /* Response lost: the host re-sends the same transaction */
+    TEST_ASSERT_EQ(sign_tx(&path, tx_bytes, again), SW_OK, "Sig cache: re-sent SIGN_TX signs");
+    TEST_ASSERT_EQ(reviews_shown(), 0, "Sig cache: re-sent SIGN_TX not reviewed again");
+    TEST_ASSERT_MEM_EQ(again, first, SIGNATURE_LEN, "Sig cache: same signature returned");
+    TEST_ASSERT_FALSE(G_state.sign_session.initialized, "Sig cache: session closed on hit");
+}
+
+void test_sig_cache_multi_transfer(void) {
+    uint8_t tx_bytes[TX_MULTI_HEADER_LEN + 3 * TX_MULTI_PAIR_LEN];
+    uint8_t replacement[sizeof(tx_bytes)];
+    uint8_t first[SIGNATURE_LEN];
+    uint8_t again[SIGNATURE_LEN];
+    bip32_path_t path;
+
+    make_path(&path, 3, 0);
+    make_multi_tx(tx_bytes, sizeof(tx_bytes), 300);
+    make_multi_tx(replacement, sizeof(replacement), 301);
+    settings_set_multi_total_only(false);
+    sig_cache_clear();
+    reviews_shown();
+
+    TEST_ASSERT_EQ(sign_tx_bytes(&path, tx_bytes, sizeof(tx_bytes), first), SW_OK,
+                   "Sig cache: multi-transfer signs");
+    TEST_ASSERT_EQ(reviews_shown(), 4, "Sig cache: three pairs and the total reviewed");
+
+    TEST_ASSERT_EQ(sign_tx_bytes(&path, tx_bytes, sizeof(tx_bytes), again), SW_OK,
+                   "Sig cache: re-sent multi-transfer signs");
+    TEST_ASSERT_EQ(reviews_shown(), 0, "Sig cache: re-sent multi-transfer pairs not reviewed");
+    TEST_ASSERT_MEM_EQ(again, first, SIGNATURE_LEN, "Sig cache: same multi-transfer signature");
+
+    /* Same nonce, other content: pairs were skipped, so it must not be signed */
+    TEST_ASSERT_EQ(sign_tx_bytes(&path, replacement, sizeof(replacement), again), SW_SESSION_ERROR,
+                   "Sig cache: unreviewed replacement fails closed");
+    TEST_ASSERT_EQ(reviews_shown(), 0, "Sig cache: nothing shown for the replacement");
+    TEST_ASSERT_FALSE(G_state.sig_cache.valid, "Sig cache: entry dropped on the miss");
+
+    TEST_ASSERT_EQ(sign_tx_bytes(&path, replacement, sizeof(replacement), again), SW_OK,
+                   "Sig cache: replacement signs when sent again");
+    TEST_ASSERT_EQ(reviews_shown(), 4, "Sig cache: replacement reviewed in full");
+}
+
+void test_sig_cache_miss(void) {
+    uint8_t tx_bytes[TX_TRANSFER_ENCODED_LEN];
+    uint8_t other_tx[TX_TRANSFER_ENCODED_LEN];
+    uint8_t sig[SIGNATURE_LEN];
+    bip32_path_t path;
+    bip32_path_t other_path;
+
+    make_path(&path, 3, 0);
+    make_path(&other_path, 3, 1);
+    make_transfer_tx(tx_bytes, 7, 1000);
+    make_transfer_tx(other_tx, 7, 1001);
+    sig_cache_clear();
+
+    sign_tx(&path, tx_bytes, sig);
+    reviews_shown();
+
+    sign_tx(&other_path, tx_bytes, sig);
+    TEST_ASSERT_EQ(reviews_shown(), 1, "Sig cache: other path is reviewed");
+
+    /* The last approval replaced the entry */
+    sign_tx(&path, tx_bytes, sig);
+    TEST_ASSERT_EQ(reviews_shown(), 1, "Sig cache: only the last approval is kept");
+
+    sign_tx(&path, other_tx, sig);
+    TEST_ASSERT_EQ(reviews_shown(), 1, "Sig cache: other digest is reviewed");
+
+    other_path = path;
+    other_path.scheme = PATH_SCHEME_BIP32_ED25519;
+    TEST_ASSERT_FALSE(sig_cache_lookup(&other_path, G_state.sig_cache.hash, sig),
+                      "Sig cache: scheme is part of the path");
+}
+
+void test_sig_cache_timeout(void) {
+    static const uint8_t zero[sizeof(sig_cache_t)];
+    uint8_t tx_bytes[TX_TRANSFER_ENCODED_LEN];
+    uint8_t sig[SIGNATURE_LEN];
+    bip32_path_t path;
+
+    make_path(&path, 3, 0);
+    make_transfer_tx(tx_bytes, 7, 2000);
+    sig_cache_clear();
+
+    sign_tx(&path, tx_bytes, sig);
+    reviews_shown();
+
+    for (int i = 0; i < SIG_CACHE_WINDOW_TICKS - 1; i++) {
+        sig_cache_tick();
+    }
+    sign_tx(&path, tx_bytes, sig);
+    TEST_ASSERT_EQ(reviews_shown(), 0, "Sig cache: hit until the window ends");
+
+    sig_cache_tick();
+    TEST_ASSERT_MEM_EQ(&G_state.sig_cache, zero, sizeof(zero), "Sig cache: zeroized on timeout");
+
+    sign_tx(&path, tx_bytes, sig);
+    TEST_ASSERT_EQ(reviews_shown(), 1, "Sig cache: reviewed again after timeout");
+
+    sig_cache_clear();
+    TEST_ASSERT_MEM_EQ(&G_state.sig_cache, zero, sizeof(zero), "Sig cache: zeroized on clear");
+}
+
+void run_sig_cache_tests(void) {
+    TEST_SUITE_START("Last-Signature Cache");
+
+    test_sig_cache_resend_skips_review();
+    test_sig_cache_multi_transfer();
+    test_sig_cache_miss();
+    test_sig_cache_timeout();
+
+    TEST_SUITE_END();
+}
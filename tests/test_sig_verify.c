@@ -0,0 +1,202 @@
+/*
+ * SUM Chain Ledger App - Batch Signature Verifier Tests
+ */
+
+#include "test_utils.h"
+#include "sig_verify.h"
+#include "ed25519.h"
+#include "tx_encoder.h"
+#include "crypto.h"
+#include "crypto/sum_blake3.h"
+#include <string.h>
+
+#define NUM_SIGNED   70          /* Spans several groups, last one partial */
+#define NUM_KEYS     5
+
+static uint8_t g_txs[NUM_SIGNED][TX_TRANSFER_ENCODED_LEN];
+static uint8_t g_pubkeys[NUM_KEYS][PUBKEY_LEN];
+static uint8_t g_sigs[NUM_SIGNED][SIGNATURE_LEN];
+static sig_verify_item_t g_items[NUM_SIGNED];
+
+/*
+ * Signature with a torsioned nonce point: R = [r]B + T with T of order 8 and
+ * S = r + k a over sum_blake3(TORSION_TX) for the key from seed 00 01 .. 1f.
+ * [S]B - [k]A encodes to R - T, not R, but the cofactored equation holds.
+ */
+#define TORSION_TX "SUM Chain torsioned-R test tx"
+
+static const uint8_t TORSION_PUBKEY[PUBKEY_LEN] = {
+    0x03, 0xa1, 0x07, 0xbf, 0xf3, 0xce, 0x10, 0xbe,
+    0x1d, 0x70, 0xdd, 0x18, 0xe7, 0x4b, 0xc0, 0x99,
+    0x67, 0xe4, 0xd6, 0x30, 0x9b, 0xa5, 0x0d, 0x5f,
+    0x1d, 0xdc, 0x86, 0x64, 0x12, 0x55, 0x31, 0xb8,
+};
+
+static const uint8_t TORSION_SIG[SIGNATURE_LEN] = {
+    0xa2, 0x22, 0x00, 0xad, 0x90, 0x97, 0x12, 0xde,
+    0xdc, 0xf2, 0xb9, 0x58, 0x7d, 0xf2, 0x49, 0x74,
+    0x84, 0xfd, 0x0c, 0x66, 0x00, 0xfe, 0xb0, 0x15,
+    0x0d, 0xd1, 0x1e, 0xee, 0x6b, 0x63, 0x2b, 0x3b,
+    0x36, 0x25, 0xc9, 0xfe, 0xe1, 0xb6, 0x70, 0x8e,
+    0x7e, 0xb5, 0x6c, 0x5a, 0x5d, 0x4b, 0xec, 0xd1,
+    0xcb, 0x8b, 0xf9, 0xea, 0x98, 0xb9, 0x59, 0x78,
+    0x5e, 0xe7, 0x4a, 0x84, 0xc7, 0xae, 0xc1, 0x01,
+};
+
+/* Sign NUM_SIGNED transfers with NUM_KEYS accounts through the app crypto API */
+static void make_signed_batch(void) {
+    bip32_path_t path;
+    uint8_t hash[HASH_LEN];
+
+    for (uint32_t k = 0; k < NUM_KEYS; k++) {
+        make_path(&path, 5, k);
+        crypto_derive_pubkey(&path, g_pubkeys[k]);
+    }
+
+    for (size_t i = 0; i < NUM_SIGNED; i++) {
+        uint32_t k = (uint32_t)(i % NUM_KEYS);
+        make_transfer_tx(g_txs[i], i, 1000 + i);
+
+        make_path(&path, 5, k);
+        sum_blake3_hash(g_txs[i], sizeof(g_txs[i]), hash);
+        crypto_sign_hash(&path, hash, g_sigs[i]);
+
+        g_items[i].tx = g_txs[i];
+        g_items[i].tx_len = sizeof(g_txs[i]);
+        g_items[i].pubkey = g_pubkeys[k];
+        g_items[i].signature = g_sigs[i];
+    }
+}
+
+void test_sig_verify_all_valid(void) {
+    bool valid[NUM_SIGNED];
+    bool all;
+
+    memset(valid, 0, sizeof(valid));
+    TEST_ASSERT_EQ(sig_verify_batch(g_items, NUM_SIGNED, valid, 1), 0,
+                   "Verifier: single thread accepts device signatures");
+    all = true;
+    for (size_t i = 0; i < NUM_SIGNED; i++) {
+        all = all && valid[i];
+    }
+    TEST_ASSERT_TRUE(all, "Verifier: every item marked valid");
+
+    memset(valid, 0, sizeof(valid));
+    TEST_ASSERT_EQ(sig_verify_batch(g_items, NUM_SIGNED, valid, 4), 0,
+                   "Verifier: four threads accept device signatures");
+    all = true;
+    for (size_t i = 0; i < NUM_SIGNED; i++) {
+        all = all && valid[i];
+    }
+    TEST_ASSERT_TRUE(all, "Verifier: every item marked valid (threaded)");
+}
+
+void test_sig_verify_isolates_failures(void) {
+    sig_verify_item_t items[NUM_SIGNED];
+    uint8_t bad_sig[SIGNATURE_LEN];
+    uint8_t bad_tx[TX_TRANSFER_ENCODED_LEN];
+    bool valid[NUM_SIGNED];
+
+    memcpy(items, g_items, sizeof(items));
+
+    /* Flipped signature bit, tampered amount, wrong account key */
+    memcpy(bad_sig, g_sigs[3], sizeof(bad_sig));
+    bad_sig[50] ^= 0x04;
+    items[3].signature = bad_sig;
+
+    memcpy(bad_tx, g_txs[20], sizeof(bad_tx));
+    bad_tx[TX_TRANSFER_ENCODED_LEN - 1] ^= 0x01;
+    items[20].tx = bad_tx;
+
+    items[66].pubkey = g_pubkeys[(66 + 1) % NUM_KEYS];
+
+    TEST_ASSERT_EQ(sig_verify_batch(items, NUM_SIGNED, valid, 3), 3,
+                   "Verifier: counts three bad signatures");
+
+    bool exact = true;
+    for (size_t i = 0; i < NUM_SIGNED; i++) {
+        bool expect_bad = (i == 3 || i == 20 || i == 66);
+        if (valid[i] == expect_bad) {
+            exact = false;
+        }
+    }
+    TEST_ASSERT_TRUE(exact, "Verifier: fallback flags exactly the bad items");
+}
+
+void test_ed25519_batch_matches_single(void) {
+    ed25519_batch_item_t batch[ED25519_BATCH_MAX];
+    uint8_t hashes[ED25519_BATCH_MAX][HASH_LEN];
+    uint8_t bad[SIGNATURE_LEN];
+
+    for (size_t i = 0; i < ED25519_BATCH_MAX; i++) {
+        sum_blake3_hash(g_txs[i], sizeof(g_txs[i]), hashes[i]);
+        batch[i].msg = hashes[i];
+        batch[i].msg_len = HASH_LEN;
+        batch[i].pubkey = g_items[i].pubkey;
+        batch[i].sig = g_sigs[i];
+    }
+
+    TEST_ASSERT_TRUE(ed25519_verify_batch(batch, ED25519_BATCH_MAX), "Batch: full batch valid");
+    TEST_ASSERT_TRUE(ed25519_verify_batch(batch, 1), "Batch: single item valid");
+
+    memcpy(bad, g_sigs[7], sizeof(bad));
+    bad[0] ^= 0x01;
+    batch[7].sig = bad;
+    TEST_ASSERT_FALSE(ed25519_verify_batch(batch, ED25519_BATCH_MAX), "Batch: bad R rejected");
+
+    memcpy(bad, g_sigs[7], sizeof(bad));
+    bad[63] ^= 0x01;
+    TEST_ASSERT_FALSE(ed25519_verify_batch(batch, ED25519_BATCH_MAX), "Batch: bad S rejected");
+
+    TEST_ASSERT_FALSE(ed25519_verify_batch(batch, 0), "Batch: empty batch rejected");
+}
+
+void test_sig_verify_torsioned_r(void) {
+    sig_verify_item_t items[ED25519_BATCH_MAX];
+    uint8_t seed[ED25519_SEED_LEN], pubkey[PUBKEY_LEN], hash[HASH_LEN];
+    uint8_t bad_sig[SIGNATURE_LEN];
+    bool valid[ED25519_BATCH_MAX];
+
+    for (size_t i = 0; i < sizeof(seed); i++) {
+        seed[i] = (uint8_t)i;
+    }
+    ed25519_public_key(seed, pubkey);
+    TEST_ASSERT_MEM_EQ(pubkey, TORSION_PUBKEY, PUBKEY_LEN, "Torsion: vector key matches seed");
+
+    sum_blake3_hash((const uint8_t *)TORSION_TX, strlen(TORSION_TX), hash);
+    TEST_ASSERT_TRUE(ed25519_verify(TORSION_PUBKEY, hash, HASH_LEN, TORSION_SIG),
+                     "Torsion: accepted alone (cofactored)");
+
+    memcpy(items, g_items, sizeof(items));
+    items[5].tx = (const uint8_t *)TORSION_TX;
+    items[5].tx_len = strlen(TORSION_TX);
+    items[5].pubkey = TORSION_PUBKEY;
+    items[5].signature = TORSION_SIG;
+
+    TEST_ASSERT_EQ(sig_verify_batch(&items[5], 1, valid, 1), 0, "Torsion: accepted as a group of one");
+    TEST_ASSERT_TRUE(valid[0], "Torsion: marked valid as a group of one");
+
+    TEST_ASSERT_EQ(sig_verify_batch(items, ED25519_BATCH_MAX, valid, 1), 0,
+                   "Torsion: accepted in a valid batch");
+    TEST_ASSERT_TRUE(valid[5], "Torsion: marked valid in a valid batch");
+
+    /* A bad neighbour forces the per-item fallback; the verdict must not change */
+    memcpy(bad_sig, g_sigs[9], sizeof(bad_sig));
+    bad_sig[40] ^= 0x10;
+    items[9].signature = bad_sig;
+    TEST_ASSERT_EQ(sig_verify_batch(items, ED25519_BATCH_MAX, valid, 1), 1,
+                   "Torsion: mixed batch counts only the bad neighbour");
+    TEST_ASSERT_TRUE(valid[5] && !valid[9], "Torsion: marked valid in a mixed batch");
+}
+
+void run_sig_verify_tests(void) {
+    TEST_SUITE_START("Batch Signature Verifier");
+
+    make_signed_batch();
+    test_sig_verify_all_valid();
+    test_sig_verify_isolates_failures();
+    test_ed25519_batch_matches_single();
+    test_sig_verify_torsioned_r();
+
+    TEST_SUITE_END();
+}
@@ -0,0 +1,104 @@
+/*
+ * SUM Chain Ledger App - Hash-only Signing Tests
+ */
+
+#include "test_utils.h"
+#include "apdu_handlers.h"
+#include "apdu_client.h"
+#include "settings.h"
+#include "tx_display.h"
+#include "ed25519.h"
+#include "crypto.h"
+#include <string.h>
+
+/* [path] [chain_id] [nonce] [fee] [hash]; returns Lc */
+static size_t build_request(uint8_t *data, size_t data_len, const uint8_t hash[HASH_LEN]) {
+    bip32_path_t path;
+    size_t pos;
+
+    make_path(&path, 5, 1);
+    pos = apdu_serialize_path(&path, data, data_len);
+    for (int i = 0; i < 8; i++) {
+        data[pos + i] = (uint8_t)((uint64_t)1 >> (i * 8));           /* chain_id */
+        data[pos + 8 + i] = (uint8_t)((uint64_t)42 >> (i * 8));      /* nonce */
+        data[pos + 16 + i] = (uint8_t)((uint64_t)210000 >> (i * 8)); /* fee */
+    }
+    pos += SIGN_HASH_HEADER_LEN;
+    memcpy(&data[pos], hash, HASH_LEN);
+
+    return pos + HASH_LEN;
+}
+
+void test_sign_hash_gated(void) {
+    uint8_t data[APDU_MAX_DATA_LEN];
+    uint8_t out[APDU_MAX_RESP_LEN];
+    uint8_t *tx = out;
+    uint8_t hash[HASH_LEN];
+
+    memset(hash, 0x5A, sizeof(hash));
+    size_t lc = build_request(data, sizeof(data), hash);
+
+    settings_init();
+    TEST_ASSERT_FALSE(settings_hash_signing_enabled(), "Sign hash: disabled by default");
+    TEST_ASSERT_EQ(apdu_dispatch(CLA_SUMCHAIN, INS_SIGN_HASH, 0, 0, (uint8_t)lc, data, &tx),
+                   SW_SECURITY_STATUS, "Sign hash: refused while disabled");
+    TEST_ASSERT_TRUE(tx == out, "Sign hash: no output while disabled");
+}
+
+void test_sign_hash_signs_digest(void) {
+    uint8_t data[APDU_MAX_DATA_LEN];
+    uint8_t out[APDU_MAX_RESP_LEN];
+    uint8_t *tx = out;
+    uint8_t hash[HASH_LEN];
+    uint8_t pubkey[PUBKEY_LEN];
+    bip32_path_t path;
+
+    for (size_t i = 0; i < sizeof(hash); i++) {
+        hash[i] = (uint8_t)(i * 7 + 1);
+    }
+    size_t lc = build_request(data, sizeof(data), hash);
+
+    settings_set_hash_signing(true);
+    TEST_ASSERT_EQ(apdu_dispatch(CLA_SUMCHAIN, INS_SIGN_HASH, 0, 0, (uint8_t)lc, data, &tx),
+                   SW_OK, "Sign hash: accepted when enabled");
+    TEST_ASSERT_EQ(tx - out, SIGNATURE_LEN, "Sign hash: 64-byte signature returned");
+
+    make_path(&path, 5, 1);
+    crypto_derive_pubkey(&path, pubkey);
+    TEST_ASSERT_TRUE(ed25519_verify(pubkey, hash, HASH_LEN, out),
+                     "Sign hash: signature is over the digest, as SIGN_TX");
+
+    tx = out;
+    TEST_ASSERT_EQ(apdu_dispatch(CLA_SUMCHAIN, INS_SIGN_HASH, 0, 0, (uint8_t)(lc - 1), data, &tx),
+                   SW_WRONG_LENGTH, "Sign hash: short request rejected");
+    TEST_ASSERT_EQ(apdu_dispatch(CLA_SUMCHAIN, INS_SIGN_HASH, 1, 0, (uint8_t)lc, data, &tx),
+                   SW_INVALID_P1P2, "Sign hash: P1 must be zero");
+
+    settings_set_hash_signing(false);
+}
+
+void test_sign_hash_display(void) {
+    tx_hash_display_t display;
+    uint8_t hash[HASH_LEN];
+
+    memset(hash, 0, sizeof(hash));
+    hash[0] = 0xAB;
+    hash[31] = 0x0F;
+
+    TEST_ASSERT_TRUE(tx_hash_display_format(1, 42, 210000, hash, &display), "Hash display: formatted");
+    TEST_ASSERT_STR_EQ(display.nonce, "42", "Hash display: nonce");
+    TEST_ASSERT_STR_EQ(display.fee, "210000", "Hash display: fee");
+    TEST_ASSERT_EQ(strlen(display.hash), 2 * HASH_LEN, "Hash display: full digest in hex");
+    TEST_ASSERT_TRUE(strncmp(display.hash, "ab00", 4) == 0 &&
+                     strcmp(display.hash + 60, "000f") == 0, "Hash display: hex order");
+}
+
+void run_sign_hash_tests(void) {
+    TEST_SUITE_START("Hash-only Signing");
+
+    test_sign_hash_gated();
+    test_sign_hash_signs_digest();
+    test_sign_hash_display();
+
+    TEST_SUITE_END();
+}
@@ -0,0 +1,181 @@
+/*
+ * SUM Chain Ledger App - Signing Scheduler Unit Tests
+ */
+
+#include "test_utils.h"
+#include "sign_scheduler.h"
+#include "apdu_loopback.h"
+#include "tx_encoder.h"
+#include <string.h>
+
+#define NUM_JOBS 12
+
+static void make_coin_path(bip32_path_t *path, uint32_t coin, uint32_t index) {
+    make_path(path, 5, 0);
+    path->path[1] = 0x80000000u | coin;
+    path->path[4] = 0x80000000u | index;
+}
+
+static void make_prefix(bip32_path_t *prefix, uint32_t coin) {
+    make_path(prefix, 2, 0);
+    prefix->path[1] = 0x80000000u | coin;
+}
+
+static uint8_t g_tx[TX_TRANSFER_ENCODED_LEN];
+
+/* Simulated rack: devices 0 and 1 share a seed, device 2 holds another coin */
+typedef struct {
+    apdu_transport_loopback_t sims[3];
+    apdu_device_t             devs[3];
+    sign_worker_t             workers[3];
+    bip32_path_t              prefix_main;
+    bip32_path_t              prefix_other;
+    sign_scheduler_t          sched;
+} rack_t;
+
+static void rack_init(rack_t *r, unsigned slow_latency, unsigned max_attempts) {
+    memset(r, 0, sizeof(*r));
+    make_prefix(&r->prefix_main, 12345);
+    make_prefix(&r->prefix_other, 999);
+
+    apdu_transport_loopback_init(&r->sims[0], slow_latency);
+    apdu_transport_loopback_init(&r->sims[1], 0);
+    apdu_transport_loopback_init(&r->sims[2], 0);
+
+    for (int i = 0; i < 3; i++) {
+        apdu_device_init(&r->devs[i], &r->sims[i].base);
+    }
+    sign_worker_init(&r->workers[0], &r->devs[0], 1, &r->prefix_main, 1);
+    sign_worker_init(&r->workers[1], &r->devs[1], 1, &r->prefix_main, 1);
+    sign_worker_init(&r->workers[2], &r->devs[2], 2, &r->prefix_other, 1);
+    sign_scheduler_init(&r->sched, r->workers, 3, max_attempts);
+}
+
+void test_scheduler_work_stealing(void) {
+    rack_t r;
+    sign_job_t jobs[NUM_JOBS];
+    bip32_path_t path;
+
+    rack_init(&r, 50, 3);
+
+    for (int i = 0; i < NUM_JOBS; i++) {
+        make_coin_path(&path, 12345, (uint32_t)i);
+        sign_job_init(&jobs[i], &path, g_tx, sizeof(g_tx), NULL, NULL);
+        sign_scheduler_submit(&r.sched, &jobs[i]);
+    }
+
+    TEST_ASSERT_EQ(r.workers[0].q_len, NUM_JOBS / 2, "Scheduler: submit balances by load");
+    TEST_ASSERT_EQ(sign_scheduler_run(&r.sched, 1000), 0, "Scheduler: batch completes");
+
+    bool all_signed = true;
+    for (int i = 0; i < NUM_JOBS; i++) {
+        if (jobs[i].status != SIGN_JOB_SIGNED || jobs[i].worker > 1) {
+            all_signed = false;
+        }
+    }
+    TEST_ASSERT_TRUE(all_signed, "Scheduler: every job signed within its seed group");
+    TEST_ASSERT_TRUE(r.workers[1].stolen > 0, "Scheduler: fast device steals from slow device");
+    TEST_ASSERT_TRUE(r.workers[1].completed > r.workers[0].completed,
+                     "Scheduler: slow device does not stall the batch");
+    TEST_ASSERT_EQ(r.workers[2].completed, 0, "Scheduler: other seed group untouched");
+}
+
+void test_scheduler_routing(void) {
+    rack_t r;
+    sign_job_t other, unknown;
+    bip32_path_t path;
+
+    rack_init(&r, 0, 3);
+
+    make_coin_path(&path, 999, 7);
+    sign_job_init(&other, &path, g_tx, sizeof(g_tx), NULL, NULL);
+    TEST_ASSERT_EQ(sign_scheduler_submit(&r.sched, &other), 0, "Scheduler: routed by path");
+
+    make_coin_path(&path, 4242, 0);
+    sign_job_init(&unknown, &path, g_tx, sizeof(g_tx), NULL, NULL);
+    TEST_ASSERT_EQ(sign_scheduler_submit(&r.sched, &unknown), -1, "Scheduler: unknown path refused");
+    TEST_ASSERT_EQ(unknown.status, SIGN_JOB_NO_DEVICE, "Scheduler: unknown path has no device");
+
+    sign_scheduler_run(&r.sched, 1000);
+    TEST_ASSERT_TRUE(other.status == SIGN_JOB_SIGNED && other.worker == 2,
+                     "Scheduler: job signed by the device holding the path");
+}
+
+void test_scheduler_retry(void) {
+    rack_t r;
+    sign_job_t job;
+    bip32_path_t path;
+
+    rack_init(&r, 0, 3);
+    r.workers[1].failed = true;         /* Force everything onto device 0 */
+
+    /* One lost session, then success */
+    r.sims[0].fail_sw = SW_SESSION_ERROR;
+    r.sims[0].fail_count = 1;
+    make_coin_path(&path, 12345, 1);
+    sign_job_init(&job, &path, g_tx, sizeof(g_tx), NULL, NULL);
+    sign_scheduler_submit(&r.sched, &job);
+    sign_scheduler_run(&r.sched, 1000);
+
+    TEST_ASSERT_EQ(job.status, SIGN_JOB_SIGNED, "Scheduler: session error retried");
+    TEST_ASSERT_EQ(job.attempts, 2, "Scheduler: one retry used");
+    TEST_ASSERT_EQ(r.workers[0].retried, 1, "Scheduler: retry counted on device");
+
+    /* Persistent parse errors exhaust the attempts */
+    r.sims[0].fail_sw = SW_TX_PARSE_ERROR;
+    r.sims[0].fail_count = 10;
+    sign_job_init(&job, &path, g_tx, sizeof(g_tx), NULL, NULL);
+    sign_scheduler_submit(&r.sched, &job);
+    sign_scheduler_run(&r.sched, 1000);
+
+    TEST_ASSERT_TRUE(job.status == SIGN_JOB_FAILED && job.sw == SW_TX_PARSE_ERROR,
+                     "Scheduler: retries bounded by max_attempts");
+    TEST_ASSERT_EQ(job.attempts, 3, "Scheduler: all attempts used");
+
+    /* User rejection is final */
+    r.sims[0].fail_sw = SW_USER_REJECTED;
+    r.sims[0].fail_count = 1;
+    sign_job_init(&job, &path, g_tx, sizeof(g_tx), NULL, NULL);
+    sign_scheduler_submit(&r.sched, &job);
+    sign_scheduler_run(&r.sched, 1000);
+
+    TEST_ASSERT_TRUE(job.status == SIGN_JOB_FAILED && job.attempts == 1,
+                     "Scheduler: rejection not retried");
+}
+
+void test_scheduler_device_failure(void) {
+    rack_t r;
+    sign_job_t jobs[4];
+    bip32_path_t path;
+
+    rack_init(&r, 0, 3);
+    r.sims[0].broken = true;
+
+    for (int i = 0; i < 4; i++) {
+        make_coin_path(&path, 12345, (uint32_t)i);
+        sign_job_init(&jobs[i], &path, g_tx, sizeof(g_tx), NULL, NULL);
+        sign_scheduler_submit(&r.sched, &jobs[i]);
+    }
+    sign_scheduler_run(&r.sched, 1000);
+
+    bool all_signed = true;
+    for (int i = 0; i < 4; i++) {
+        if (jobs[i].status != SIGN_JOB_SIGNED || jobs[i].worker != 1) {
+            all_signed = false;
+        }
+    }
+    TEST_ASSERT_TRUE(r.workers[0].failed, "Scheduler: broken device taken out of rotation");
+    TEST_ASSERT_TRUE(all_signed, "Scheduler: broken device's jobs moved to its peer");
+}
+
+void run_sign_scheduler_tests(void) {
+    TEST_SUITE_START("Signing Scheduler");
+
+    make_transfer_tx(g_tx, 0, 42);
+    test_scheduler_work_stealing();
+    test_scheduler_routing();
+    test_scheduler_retry();
+    test_scheduler_device_failure();
+
+    TEST_SUITE_END();
+}
@@ -0,0 +1,210 @@
+/*
+ * SUM Chain Ledger App - Transaction Encoder Unit Tests
+ */
+
+#include "test_utils.h"
+#include "tx_encoder.h"
+#include "tx_parser.h"
+#include "sum_blake3.h"
+#include <string.h>
+
+#define BATCH_SIZE 16
+
+static void fill_template(tx_parsed_t *tx) {
+    memset(tx, 0, sizeof(*tx));
+    tx->version = 1;
+    tx->chain_id = 7;
+    memset(tx->sender, 0x11, ADDRESS_LEN);
+    tx->nonce = 5;
+    tx->gas_price = 1000;
+    tx->gas_limit = 21000;
+    memset(tx->recipient, 0x22, ADDRESS_LEN);
+    tx->amount = 123456789;
+}
+
+/* Parse `len` bytes in chunks of `chunk` and return the parser state */
+static bool parse_in_chunks(const uint8_t *tx, size_t len, size_t chunk, tx_parser_ctx_t *ctx) {
+    tx_parser_init(ctx);
+    size_t offset = 0;
+    while (offset < len) {
+        size_t take = (len - offset < chunk) ? len - offset : chunk;
+        /* Multi-transfers return after each pair; keep feeding the chunk */
+        size_t end = offset + take;
+        while (offset < end) {
+            size_t consumed = tx_parser_consume(ctx, &tx[offset], end - offset);
+            if (consumed == 0) {
+                return false;
+            }
+            offset += consumed;
+        }
+    }
+    return tx_parser_is_done(ctx);
+}
+
+void test_encoder_single_roundtrip(void) {
+    tx_parsed_t in;
+    uint8_t buf[TX_TRANSFER_ENCODED_LEN];
+
+    fill_template(&in);
+    in.amount = 0xFEDCBA9876543210ULL;
+
+    size_t len = tx_encode_transfer(&in, buf, sizeof(buf));
+    TEST_ASSERT_EQ(len, TX_TRANSFER_ENCODED_LEN, "Encoder: transfer is 82 bytes");
+
+    tx_parser_ctx_t ctx;
+    TEST_ASSERT_TRUE(parse_in_chunks(buf, len, len, &ctx), "Encoder: parser accepts output");
+
+    const tx_parsed_t *p = tx_parser_get_parsed(&ctx);
+    TEST_ASSERT_EQ(p->chain_id, in.chain_id, "Encoder: chain_id round-trips");
+    TEST_ASSERT_MEM_EQ(p->sender, in.sender, ADDRESS_LEN, "Encoder: sender round-trips");
+    TEST_ASSERT_EQ(p->nonce, in.nonce, "Encoder: nonce round-trips");
+    TEST_ASSERT_EQ(p->gas_price, in.gas_price, "Encoder: gas_price round-trips");
+    TEST_ASSERT_EQ(p->gas_limit, in.gas_limit, "Encoder: gas_limit round-trips");
+    TEST_ASSERT_MEM_EQ(p->recipient, in.recipient, ADDRESS_LEN, "Encoder: recipient round-trips");
+    TEST_ASSERT_EQ(p->amount, in.amount, "Encoder: amount round-trips");
+}
+
+void test_encoder_small_buffer(void) {
+    tx_parsed_t in;
+    uint8_t buf[TX_TRANSFER_ENCODED_LEN - 1];
+
+    fill_template(&in);
+    TEST_ASSERT_EQ(tx_encode_transfer(&in, buf, sizeof(buf)), 0, "Encoder: rejects short buffer");
+}
+
+void test_encoder_batch_soa(void) {
+    tx_parsed_t defaults;
+    uint64_t nonce[BATCH_SIZE];
+    uint64_t amount[BATCH_SIZE];
+    uint8_t recipient[BATCH_SIZE][ADDRESS_LEN];
+    uint8_t arena_buf[BATCH_SIZE * TX_TRANSFER_ENCODED_LEN];
+    size_t offsets[BATCH_SIZE];
+    uint8_t hashes[BATCH_SIZE][HASH_LEN];
+
+    fill_template(&defaults);
+    for (size_t i = 0; i < BATCH_SIZE; i++) {
+        nonce[i] = 100 + i;
+        amount[i] = 1000 * (i + 1);
+        memset(recipient[i], (int)(0x40 + i), ADDRESS_LEN);
+    }
+
+    tx_transfer_batch_t batch = {
+        .count = BATCH_SIZE,
+        .defaults = &defaults,
+        .nonce = nonce,
+        .recipient = (const uint8_t (*)[ADDRESS_LEN])recipient,
+        .amount = amount,
+    };
+
+    tx_arena_t arena;
+    tx_arena_init(&arena, arena_buf, sizeof(arena_buf));
+
+    size_t n = tx_encode_transfer_batch(&batch, &arena, offsets, hashes);
+    TEST_ASSERT_EQ(n, BATCH_SIZE, "Batch: all transactions encoded");
+    TEST_ASSERT_EQ(arena.used, sizeof(arena_buf), "Batch: arena fully used");
+
+    bool parsed_ok = true;
+    bool fields_ok = true;
+    bool hashes_ok = true;
+    for (size_t i = 0; i < n; i++) {
+        const uint8_t *tx = arena.base + offsets[i];
+        tx_parser_ctx_t ctx;
+
+        /* Alternate chunkings so the round trip covers split fields too */
+        if (!parse_in_chunks(tx, TX_TRANSFER_ENCODED_LEN, 1 + (i % 13), &ctx)) {
+            parsed_ok = false;
+            continue;
+        }
+        const tx_parsed_t *p = tx_parser_get_parsed(&ctx);
+        if (p->nonce != nonce[i] || p->amount != amount[i] ||
+            memcmp(p->recipient, recipient[i], ADDRESS_LEN) != 0 ||
+            p->chain_id != defaults.chain_id ||
+            memcmp(p->sender, defaults.sender, ADDRESS_LEN) != 0 ||
+            p->gas_price != defaults.gas_price || p->gas_limit != defaults.gas_limit) {
+            fields_ok = false;
+        }
+
+        uint8_t expected[HASH_LEN];
+        sum_blake3_hash(tx, TX_TRANSFER_ENCODED_LEN, expected);
+        if (memcmp(expected, hashes[i], HASH_LEN) != 0) {
+            hashes_ok = false;
+        }
+    }
+
+    TEST_ASSERT_TRUE(parsed_ok, "Batch: every tx parses under chunked streaming");
+    TEST_ASSERT_TRUE(fields_ok, "Batch: SoA columns and defaults round-trip");
+    TEST_ASSERT_TRUE(hashes_ok, "Batch: fused hashes match BLAKE3 of encoded bytes");
+}
+
+void test_encoder_batch_arena_full(void) {
+    tx_parsed_t defaults;
+    uint8_t arena_buf[3 * TX_TRANSFER_ENCODED_LEN + 10];
+
+    fill_template(&defaults);
+
+    tx_transfer_batch_t batch = { .count = 5, .defaults = &defaults };
+
+    tx_arena_t arena;
+    tx_arena_init(&arena, arena_buf, sizeof(arena_buf));
+
+    size_t n = tx_encode_transfer_batch(&batch, &arena, NULL, NULL);
+    TEST_ASSERT_EQ(n, 3, "Batch: stops when arena is full");
+    TEST_ASSERT_EQ(arena.used, 3 * TX_TRANSFER_ENCODED_LEN, "Batch: arena accounts whole txs only");
+
+    n = tx_encode_transfer_batch(&batch, &arena, NULL, NULL);
+    TEST_ASSERT_EQ(n, 0, "Batch: full arena encodes nothing");
+}
+
+void test_encoder_batch_missing_defaults(void) {
+    uint64_t nonce[1] = { 1 };
+    uint8_t arena_buf[TX_TRANSFER_ENCODED_LEN];
+
+    tx_transfer_batch_t batch = { .count = 1, .nonce = nonce };
+
+    tx_arena_t arena;
+    tx_arena_init(&arena, arena_buf, sizeof(arena_buf));
+
+    TEST_ASSERT_EQ(tx_encode_transfer_batch(&batch, &arena, NULL, NULL), 0,
+                   "Batch: NULL column without defaults rejected");
+}
+
+void test_encoder_multi_roundtrip(void) {
+    uint8_t recipients[3][ADDRESS_LEN];
+    uint64_t amounts[3] = { 1, UINT64_MAX, 5 };
+    uint8_t buf[TX_MULTI_HEADER_LEN + 3 * TX_MULTI_PAIR_LEN];
+    tx_parsed_t in;
+    tx_parser_ctx_t ctx;
+
+    fill_template(&in);
+    for (int i = 0; i < 3; i++) {
+        memset(recipients[i], 0x40 + i, ADDRESS_LEN);
+    }
+
+    size_t len = tx_encode_multi_transfer(&in, recipients, amounts, 3, buf, sizeof(buf));
+    TEST_ASSERT_EQ(len, sizeof(buf), "Encoder: multi-transfer is 56 + 28 * count bytes");
+    TEST_ASSERT_TRUE(parse_in_chunks(buf, len, 33, &ctx), "Encoder: parser accepts multi-transfer");
+
+    const tx_parsed_t *p = tx_parser_get_parsed(&ctx);
+    TEST_ASSERT_EQ(p->tx_type, TX_TYPE_MULTI_TRANSFER, "Encoder: multi tx_type");
+    TEST_ASSERT_EQ(p->recipient_count, 3, "Encoder: recipient count round-trips");
+    TEST_ASSERT_MEM_EQ(p->recipient, recipients[2], ADDRESS_LEN, "Encoder: last recipient round-trips");
+    TEST_ASSERT_TRUE(p->total_amount_lo == 5 && p->total_amount_hi == 1, "Encoder: 128-bit total");
+
+    TEST_ASSERT_EQ(tx_encode_multi_transfer(&in, recipients, amounts, 0, buf, sizeof(buf)), 0,
+                   "Encoder: empty multi-transfer rejected");
+    TEST_ASSERT_EQ(tx_encode_multi_transfer(&in, recipients, amounts, 3, buf, sizeof(buf) - 1), 0,
+                   "Encoder: multi-transfer needs room for every pair");
+}
+
+void run_tx_encoder_tests(void) {
+    TEST_SUITE_START("Transaction Encoder");
+
+    test_encoder_single_roundtrip();
+    test_encoder_small_buffer();
+    test_encoder_batch_soa();
+    test_encoder_batch_arena_full();
+    test_encoder_batch_missing_defaults();
+    test_encoder_multi_roundtrip();
+
+    TEST_SUITE_END();
+}
@@ -4,7 +4,9 @@
 
 #include "test_utils.h"
 #include "tx_parser.h"
+#include "tx_display.h"
 #include "globals.h"
+#include "crypto/sum_blake3.h"
 #include <string.h>
 #include <stdlib.h>
 #include <time.h>
@@ -338,6 +340,259 @@ void test_parser_large_values(void) {
     TEST_ASSERT_EQ(p->amount, large_amount, "Large amount correct");
 }
 
+/* Turn a Transfer built by build_transfer_tx into a Call with data_len bytes of data */
+static size_t build_call_tx(uint8_t *buf, size_t buf_len, uint32_t data_len) {
+    uint8_t sender[20], recipient[20];
+
+    memset(sender, 0x31, sizeof(sender));
+    memset(recipient, 0x42, sizeof(recipient));
+
+    size_t pos = build_transfer_tx(buf, buf_len, 1, 7, sender, 3, 10, 500000, recipient, 25);
+    if (pos == 0 || buf_len < pos + 4 + data_len) {
+        return 0;
+    }
+
+    buf[53] = TX_TYPE_CALL;
+    for (int i = 0; i < 4; i++) {
+        buf[pos++] = (uint8_t)(data_len >> (i * 8));
+    }
+    for (uint32_t i = 0; i < data_len; i++) {
+        buf[pos++] = (uint8_t)(i * 31 + 7);
+    }
+
+    return pos;
+}
+
+void test_parser_call_large_data(void) {
+    static uint8_t tx[86 + 40000];
+    uint8_t expected[HASH_LEN];
+    tx_display_t display;
+
+    size_t tx_len = build_call_tx(tx, sizeof(tx), 40000);
+    sum_blake3_hash(&tx[86], 40000, expected);
+
+    /* Random chunk sizes spanning field/data boundaries */
+    srand(7);
+    for (int trial = 0; trial < 4; trial++) {
+        tx_parser_ctx_t ctx;
+        tx_parser_init(&ctx);
+
+        size_t offset = 0;
+        while (offset < tx_len && !tx_parser_has_error(&ctx)) {
+            size_t chunk = (size_t)(rand() % 255) + 1;
+            if (chunk > tx_len - offset) chunk = tx_len - offset;
+            offset += tx_parser_consume(&ctx, &tx[offset], chunk);
+        }
+
+        const tx_parsed_t *p = tx_parser_get_parsed(&ctx);
+        TEST_ASSERT_TRUE(tx_parser_is_done(&ctx) && ctx.total_consumed == tx_len,
+                         "Call: 40 KB data parsed in chunks");
+        TEST_ASSERT_EQ(p->data_len, 40000, "Call: data_len correct");
+        TEST_ASSERT_MEM_EQ(p->data_hash, expected, HASH_LEN, "Call: data fingerprint is BLAKE3(data)");
+        TEST_ASSERT_EQ(p->amount, 25, "Call: amount correct");
+    }
+
+    tx_parser_ctx_t ctx;
+    tx_parser_init(&ctx);
+    tx_parser_consume(&ctx, tx, tx_len);
+    TEST_ASSERT_TRUE(tx_display_format(tx_parser_get_parsed(&ctx), &display), "Call: display formatted");
+    TEST_ASSERT_TRUE(display.has_data, "Call: display has data screens");
+    TEST_ASSERT_STR_EQ(display.data_len, "40000 bytes", "Call: data length shown");
+    TEST_ASSERT_EQ(strlen(display.data_hash), 2 * TX_DISPLAY_FINGERPRINT_BYTES, "Call: fingerprint length");
+}
+
+void test_parser_zeroize_partial(void) {
+    static uint8_t tx[86 + 40000];
+    static tx_parser_ctx_t ctx;
+    static const uint8_t zeros[sizeof(sign_session_t)];
+    sign_session_t *session = &G_state.sign_session;
+    uint8_t digest[HASH_LEN];
+
+    size_t tx_len = build_call_tx(tx, sizeof(tx), 40000);
+
+    /* Stopped halfway through the data: the data hasher holds CVs */
+    tx_parser_init(&ctx);
+    tx_parser_consume(&ctx, tx, tx_len / 2);
+    TEST_ASSERT_TRUE(ctx.data_hash_ctx.cv_used > 0, "Zeroize: data hasher in use");
+    tx_parser_zeroize(&ctx);
+    TEST_ASSERT_MEM_EQ(&ctx, zeros, sizeof(ctx), "Zeroize: parser all zero after partial wipe");
+
+    /* A session with both hashers and the Merkle stack in use */
+    sum_blake3_init(&session->tx_hash_ctx);
+    sum_blake3_update(&session->tx_hash_ctx, tx, tx_len);
+    tx_parser_init(&session->parser);
+    tx_parser_consume(&session->parser, tx, tx_len - 100);
+    memset(digest, 0x3C, sizeof(digest));
+    merkle_acc_init(&session->batch.tree);
+    for (int i = 0; i < 7; i++) {
+        merkle_acc_push(&session->batch.tree, &session->tx_hash_ctx, digest);
+    }
+    session->initialized = true;
+    session->is_batch = true;
+    session->total_received = tx_len;
+    session->batch.fee_hi = 1;
+
+    reset_sign_session();
+    TEST_ASSERT_MEM_EQ(session, zeros, sizeof(*session), "Zeroize: sign session all zero after reset");
+}
+
+void test_parser_call_empty_data(void) {
+    uint8_t tx[128];
+    tx_parser_ctx_t ctx;
+
+    size_t tx_len = build_call_tx(tx, sizeof(tx), 0);
+    tx_parser_init(&ctx);
+
+    TEST_ASSERT_EQ(tx_parser_consume(&ctx, tx, tx_len), tx_len, "Call: empty data consumed");
+    TEST_ASSERT_TRUE(tx_parser_is_done(&ctx), "Call: empty data completes");
+}
+
+void test_parser_call_too_large(void) {
+    uint8_t tx[128];
+    tx_parser_ctx_t ctx;
+
+    size_t tx_len = build_call_tx(tx, sizeof(tx), 0);
+
+    /* Header (86 bytes) + data_len must stay within MAX_TX_SIZE */
+    uint32_t data_len = MAX_TX_SIZE - 86 + 1;
+    for (int i = 0; i < 4; i++) {
+        tx[82 + i] = (uint8_t)(data_len >> (i * 8));
+    }
+    tx_parser_init(&ctx);
+    tx_parser_consume(&ctx, tx, tx_len);
+    TEST_ASSERT_TRUE(tx_parser_has_error(&ctx), "Call: data_len past MAX_TX_SIZE rejected");
+
+    data_len = MAX_TX_SIZE - 86;
+    for (int i = 0; i < 4; i++) {
+        tx[82 + i] = (uint8_t)(data_len >> (i * 8));
+    }
+    tx_parser_init(&ctx);
+    tx_parser_consume(&ctx, tx, tx_len);
+    TEST_ASSERT_FALSE(tx_parser_has_error(&ctx), "Call: data_len up to MAX_TX_SIZE accepted");
+    TEST_ASSERT_EQ(ctx.state, TX_PARSE_STATE_DATA, "Call: parser waits for data");
+}
+
+/* Multi-transfer with `count` pairs; amount i is UINT64_MAX - i so the total passes 2^64 */
+static size_t build_multi_tx(uint8_t *buf, size_t buf_len, uint16_t count) {
+    uint8_t sender[20], recipient[20];
+
+    memset(sender, 0x31, sizeof(sender));
+    memset(recipient, 0x00, sizeof(recipient));
+
+    size_t pos = build_transfer_tx(buf, buf_len, 1, 7, sender, 3, 10, 500000, recipient, 0);
+    if (pos == 0 || buf_len < 56 + (size_t)count * 28) {
+        return 0;
+    }
+
+    pos = 53;
+    buf[pos++] = TX_TYPE_MULTI_TRANSFER;
+    buf[pos++] = (uint8_t)count;
+    buf[pos++] = (uint8_t)(count >> 8);
+    for (uint16_t i = 0; i < count; i++) {
+        memset(&buf[pos], 0, 20);
+        buf[pos] = (uint8_t)i;
+        buf[pos + 1] = (uint8_t)(i >> 8);
+        pos += 20;
+        uint64_t amount = UINT64_MAX - i;
+        for (int b = 0; b < 8; b++) {
+            buf[pos++] = (uint8_t)(amount >> (b * 8));
+        }
+    }
+
+    return pos;
+}
+
+void test_parser_multi_transfer(void) {
+    static uint8_t tx[56 + 300 * 28];
+    tx_pair_display_t pair;
+    tx_display_t display;
+    bool pairs_ok = true;
+
+    size_t tx_len = build_multi_tx(tx, sizeof(tx), 300);
+
+    /* Every pair is reported once, in order, whatever the chunking */
+    srand(11);
+    for (int trial = 0; trial < 4; trial++) {
+        tx_parser_ctx_t ctx;
+        uint16_t seen = 0;
+        size_t offset = 0;
+
+        tx_parser_init(&ctx);
+        while (offset < tx_len && !tx_parser_has_error(&ctx)) {
+            size_t chunk = (size_t)(rand() % 255) + 1;
+            if (chunk > tx_len - offset) chunk = tx_len - offset;
+            size_t end = offset + chunk;
+            while (offset < end) {
+                size_t consumed = tx_parser_consume(&ctx, &tx[offset], end - offset);
+                if (consumed == 0) {
+                    break;
+                }
+                offset += consumed;
+                if (tx_parser_pair_ready(&ctx)) {
+                    const tx_parsed_t *p = tx_parser_get_parsed(&ctx);
+                    pairs_ok = pairs_ok && p->recipient_index == seen + 1 &&
+                               p->recipient[0] == (uint8_t)seen && p->amount == UINT64_MAX - seen;
+                    seen++;
+                }
+            }
+        }
+
+        const tx_parsed_t *p = tx_parser_get_parsed(&ctx);
+        TEST_ASSERT_TRUE(tx_parser_is_done(&ctx) && offset == tx_len, "Multi: 300 pairs parsed in chunks");
+        TEST_ASSERT_EQ(seen, 300, "Multi: each pair reported once");
+        /* sum(2^64 - 1 - i) for i < 300 = 300 * 2^64 - 300 - 44850 */
+        TEST_ASSERT_EQ(p->total_amount_hi, 299, "Multi: total high word");
+        TEST_ASSERT_EQ(p->total_amount_lo, (uint64_t)0 - 45150, "Multi: total low word");
+    }
+    TEST_ASSERT_TRUE(pairs_ok, "Multi: pairs reported in order with their amounts");
+
+    /* A pair ends the call even with more input available */
+    tx_parser_ctx_t ctx;
+    tx_parser_init(&ctx);
+    TEST_ASSERT_EQ(tx_parser_consume(&ctx, tx, tx_len), 56 + 28, "Multi: consume stops after first pair");
+    TEST_ASSERT_TRUE(tx_parser_pair_ready(&ctx), "Multi: first pair ready");
+    TEST_ASSERT_TRUE(tx_pair_display_format(tx_parser_get_parsed(&ctx), &pair), "Multi: pair formatted");
+    TEST_ASSERT_STR_EQ(pair.index, "1 of 300", "Multi: pair index shown");
+    TEST_ASSERT_STR_EQ(pair.amount, "18446744073709551615", "Multi: pair amount shown");
+
+    size_t offset = 56 + 28;
+    while (offset < tx_len) {
+        offset += tx_parser_consume(&ctx, &tx[offset], tx_len - offset);
+    }
+    TEST_ASSERT_TRUE(tx_display_format(tx_parser_get_parsed(&ctx), &display), "Multi: display formatted");
+    TEST_ASSERT_TRUE(display.has_recipients, "Multi: display has recipient screens");
+    TEST_ASSERT_STR_EQ(display.recipient_count, "300", "Multi: recipient count shown");
+    TEST_ASSERT_STR_EQ(display.total_amount, "5534023222112865439650", "Multi: 128-bit total shown");
+}
+
+void test_parser_multi_transfer_bad_count(void) {
+    static uint8_t tx[56 + 2 * 28];
+    tx_parser_ctx_t ctx;
+
+    size_t tx_len = build_multi_tx(tx, sizeof(tx), 2);
+
+    tx[54] = 0;
+    tx[55] = 0;
+    tx_parser_init(&ctx);
+    tx_parser_consume(&ctx, tx, tx_len);
+    TEST_ASSERT_TRUE(tx_parser_has_error(&ctx), "Multi: zero recipients rejected");
+
+    /* 56 + 28 * count must stay within MAX_TX_SIZE */
+    uint16_t count = (MAX_TX_SIZE - 56) / 28 + 1;
+    tx[54] = (uint8_t)count;
+    tx[55] = (uint8_t)(count >> 8);
+    tx_parser_init(&ctx);
+    tx_parser_consume(&ctx, tx, tx_len);
+    TEST_ASSERT_TRUE(tx_parser_has_error(&ctx), "Multi: count past MAX_TX_SIZE rejected");
+
+    count--;
+    tx[54] = (uint8_t)count;
+    tx[55] = (uint8_t)(count >> 8);
+    tx_parser_init(&ctx);
+    tx_parser_consume(&ctx, tx, tx_len);
+    TEST_ASSERT_FALSE(tx_parser_has_error(&ctx), "Multi: count up to MAX_TX_SIZE accepted");
+}
+
 void run_tx_parser_tests(void) {
     TEST_SUITE_START("Transaction Parser");
 
@@ -351,6 +606,12 @@ void run_tx_parser_tests(void) {
     test_parser_fee_no_overflow();
     test_parser_zeroize();
     test_parser_large_values();
+    test_parser_call_large_data();
+    test_parser_zeroize_partial();
+    test_parser_call_empty_data();
+    test_parser_call_too_large();
+    test_parser_multi_transfer();
+    test_parser_multi_transfer_bad_count();
 
     TEST_SUITE_END();
 }
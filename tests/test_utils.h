@@ -9,6 +9,10 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdint.h>
+#include "globals.h"
+#include "apdu_handlers.h"
+#include "apdu_client.h"
+#include "tx_encoder.h"
 
 /* Test result tracking - defined in test_main.c */
 extern int g_tests_run;
@@ -69,6 +73,54 @@ static inline void print_hex(const char *label, const uint8_t *data, size_t len)
     printf("\n");
 }
 
+/* m/44'/12345'/account' followed by 0' up to `length` components */
+static inline void make_path(bip32_path_t *path, uint8_t length, uint32_t account) {
+    memset(path, 0, sizeof(*path));
+    path->length = length;
+    for (uint8_t i = 0; i < length; i++) {
+        path->path[i] = 0x80000000u;
+    }
+    if (length > 0) {
+        path->path[0] |= 44;
+    }
+    if (length > 1) {
+        path->path[1] |= 12345;
+    }
+    if (length > 2) {
+        path->path[2] |= account;
+    }
+}
+
+/* Transfer on chain 1 from 0x11.. to 0x22.., gas 10 x 21000 */
+static inline void make_transfer_tx(uint8_t buf[TX_TRANSFER_ENCODED_LEN], uint64_t nonce, uint64_t amount) {
+    tx_parsed_t tx;
+
+    memset(&tx, 0, sizeof(tx));
+    tx.version = 1;
+    tx.chain_id = 1;
+    memset(tx.sender, 0x11, ADDRESS_LEN);
+    tx.nonce = nonce;
+    tx.gas_price = 10;
+    tx.gas_limit = 21000;
+    memset(tx.recipient, 0x22, ADDRESS_LEN);
+    tx.amount = amount;
+    tx_encode_transfer(&tx, buf, TX_TRANSFER_ENCODED_LEN);
+}
+
+/* One APDU through apdu_dispatch; response data in out, its length in out_len */
+static inline uint16_t dispatch(uint8_t ins, uint8_t p1, uint8_t p2, const uint8_t *data, size_t lc,
+                                uint8_t *out, size_t *out_len) {
+    uint8_t buf[APDU_MAX_DATA_LEN];
+    uint8_t *tx = out;
+
+    if (lc > 0) {
+        memcpy(buf, data, lc);
+    }
+    uint16_t sw = apdu_dispatch(CLA_SUMCHAIN, ins, p1, p2, (uint8_t)lc, buf, &tx);
+    *out_len = (size_t)(tx - out);
+    return sw;
+}
+
 static inline void print_test_summary(void) {
     printf("\n========================================\n");
     printf("Tests run: %d, Passed: %d, Failed: %d\n",
@@ -0,0 +1,135 @@
+/*
+ * SUM Chain Ledger App - Per-Command Working Set Tests
+ */
+
+#include "test_utils.h"
+#include "apdu_handlers.h"
+#include "apdu_client.h"
+#include "tx_encoder.h"
+#include "address.h"
+#include "crypto.h"
+#include "settings.h"
+#include "sig_cache.h"
+#include "work_area.h"
+#include <string.h>
+
+static bool work_area_is_clear(void) {
+    const uint8_t *p = (const uint8_t *)&G_state.work;
+
+    for (size_t i = 0; i < sizeof(G_state.work); i++) {
+        if (p[i] != 0) {
+            return false;
+        }
+    }
+    return G_state.work_used == 0;
+}
+
+void test_work_area_claims(void) {
+    work_area_clear();
+    TEST_ASSERT_TRUE(work_area_is_clear(), "Work area: clear when idle");
+
+    work_sign();
+    TEST_ASSERT_EQ(G_state.work_used, offsetof(work_sign_t, display), "Work area: digest and signature claimed");
+
+    work_key();
+    TEST_ASSERT_EQ(G_state.work_used, offsetof(work_sign_t, display), "Work area: claim keeps the high-water mark");
+
+    work_tx_display();
+    TEST_ASSERT_EQ(G_state.work_used, offsetof(work_sign_t, display) + sizeof(tx_display_t),
+                   "Work area: display claim covers digest and strings");
+
+    work_area_clear();
+    TEST_ASSERT_EQ(G_state.work_used, 0, "Work area: claim reset by clear");
+
+    /* Only the claimed prefix is zeroized */
+    const uint8_t *p = (const uint8_t *)&G_state.work;
+    memset(&G_state.work, 0xA5, sizeof(G_state.work));
+    work_address();
+    work_area_clear();
+    TEST_ASSERT_EQ(p[0], 0, "Work area: claimed bytes zeroized");
+    TEST_ASSERT_EQ(p[sizeof(work_address_t) - 1], 0, "Work area: last claimed byte zeroized");
+    TEST_ASSERT_EQ(p[sizeof(work_address_t)], 0xA5, "Work area: unclaimed bytes left alone");
+
+    memset(&G_state.work, 0, sizeof(G_state.work));
+}
+
+void test_work_area_address(void) {
+    uint8_t data[APDU_MAX_DATA_LEN];
+    uint8_t resp[APDU_MAX_RESP_LEN];
+    uint8_t pubkey[PUBKEY_LEN];
+    char expected[ADDRESS_BASE58_MAX_LEN];
+    size_t resp_len;
+    bip32_path_t path;
+
+    make_path(&path, 3, 2);
+    work_area_clear();
+
+    /* Intermediates land in the GET_ADDRESS layout until the command ends */
+    TEST_ASSERT_TRUE(sumchain_get_address_for_path(&path, false, expected, sizeof(expected)),
+                     "Work area: address derived");
+    TEST_ASSERT_TRUE(crypto_derive_pubkey(&path, pubkey), "Work area: pubkey derived");
+    TEST_ASSERT_EQ(G_state.work_used, sizeof(work_address_t), "Work area: address layout claimed");
+    TEST_ASSERT_MEM_EQ(G_state.work.address.pubkey, pubkey, PUBKEY_LEN,
+                       "Work area: pubkey kept in the working set");
+    work_area_clear();
+
+    size_t lc = apdu_serialize_path(&path, data, sizeof(data));
+    TEST_ASSERT_EQ(dispatch(INS_GET_ADDRESS, 0, 0, data, lc, resp, &resp_len), SW_OK,
+                   "Work area: GET_ADDRESS ok");
+    TEST_ASSERT_EQ(resp_len, strlen(expected), "Work area: GET_ADDRESS length");
+    TEST_ASSERT_MEM_EQ(resp, expected, resp_len, "Work area: GET_ADDRESS address");
+    TEST_ASSERT_TRUE(work_area_is_clear(), "Work area: zeroized after GET_ADDRESS");
+
+    TEST_ASSERT_EQ(dispatch(INS_GET_PUBLIC_KEY, 0, 0, data, lc, resp, &resp_len), SW_OK,
+                   "Work area: GET_PUBLIC_KEY ok");
+    TEST_ASSERT_MEM_EQ(resp, pubkey, PUBKEY_LEN, "Work area: GET_PUBLIC_KEY key");
+    TEST_ASSERT_TRUE(work_area_is_clear(), "Work area: zeroized after GET_PUBLIC_KEY");
+}
+
+void test_work_area_signing(void) {
+    uint8_t data[APDU_MAX_DATA_LEN];
+    uint8_t resp[APDU_MAX_RESP_LEN];
+    uint8_t tx_bytes[TX_TRANSFER_ENCODED_LEN];
+    size_t resp_len;
+    bip32_path_t path;
+
+    make_path(&path, 3, 2);
+    make_transfer_tx(tx_bytes, 3, 777);
+    sig_cache_clear();
+    work_area_clear();
+
+    size_t lc = apdu_serialize_path(&path, data, sizeof(data));
+    memcpy(data + lc, tx_bytes, 40);
+    TEST_ASSERT_EQ(dispatch(INS_SIGN_TX, P1_FIRST_CHUNK, P2_MORE_CHUNKS, data, lc + 40, resp, &resp_len),
+                   SW_OK, "Work area: SIGN_TX first chunk");
+    TEST_ASSERT_TRUE(work_area_is_clear(), "Work area: clear between chunks");
+
+    TEST_ASSERT_EQ(dispatch(INS_SIGN_TX, P1_MORE_CHUNK, P2_LAST_CHUNK, tx_bytes + 40,
+                            sizeof(tx_bytes) - 40, resp, &resp_len),
+                   SW_OK, "Work area: SIGN_TX last chunk");
+    TEST_ASSERT_EQ(resp_len, SIGNATURE_LEN, "Work area: SIGN_TX signature returned");
+    TEST_ASSERT_TRUE(work_area_is_clear(), "Work area: zeroized after SIGN_TX");
+
+    /* Rejected and failed commands are covered by the same exit */
+    lc = apdu_serialize_path(&path, data, sizeof(data));
+    memset(data + lc, 0x11, SIGN_HASH_HEADER_LEN + HASH_LEN);
+    settings_set_hash_signing(true);
+    TEST_ASSERT_EQ(dispatch(INS_SIGN_HASH, 0, 0, data, lc + SIGN_HASH_HEADER_LEN + HASH_LEN, resp, &resp_len),
+                   SW_OK, "Work area: SIGN_HASH ok");
+    TEST_ASSERT_TRUE(work_area_is_clear(), "Work area: zeroized after SIGN_HASH");
+    TEST_ASSERT_EQ(dispatch(INS_SIGN_HASH, 0, 0, data, lc + SIGN_HASH_HEADER_LEN, resp, &resp_len),
+                   SW_WRONG_LENGTH, "Work area: short SIGN_HASH refused");
+    TEST_ASSERT_TRUE(work_area_is_clear(), "Work area: clear after a failed command");
+    settings_set_hash_signing(false);
+    sig_cache_clear();
+}
+
+void run_work_area_tests(void) {
+    TEST_SUITE_START("Per-Command Working Set");
+
+    test_work_area_claims();
+    test_work_area_address();
+    test_work_area_signing();
+
+    TEST_SUITE_END();
+}
@@ -0,0 +1,87 @@
+#!/usr/bin/env python3
+"""
+SUM Chain Ledger App - instruction counts per kernel under qemu-arm.
+
+Runs tests/bench/bench_kernels (cross-compiled for ARM) once per operation
+under user-mode qemu with the libinsn TCG plugin, at 0 and at N iterations.
+The difference divided by N is the number of guest instructions one call
+retires; process startup, libc and setup() cancel out. Unlike wall-clock
+numbers on the host, these are deterministic and comparable between
+commits.
+
+Usage (normally through `make bench-arm`):
+  bench_arm.py --bin tests/bench_kernels_arm --plugin /path/libinsn.so
+               [--qemu qemu-arm] [--iterations 1000] [--json out.json]
+"""
+
+import argparse
+import json
+import os
+import re
+import subprocess
+import sys
+import tempfile
+
+INSN_RE = re.compile(r"insns:\s*(\d+)")
+
+
+def list_ops(qemu, binary):
+    out = subprocess.run([qemu, binary, "list"], check=True,
+                         capture_output=True, text=True).stdout
+    return [line.strip() for line in out.splitlines() if line.strip()]
+
+
+def count_insns(qemu, plugin, binary, op, iterations):
+    with tempfile.NamedTemporaryFile(suffix=".log", delete=False) as log:
+        log_path = log.name
+    try:
+        subprocess.run([qemu, "-plugin", plugin, "-d", "plugin", "-D", log_path,
+                        binary, op, str(iterations)],
+                       check=True, capture_output=True)
+        with open(log_path) as f:
+            total = sum(int(m.group(1)) for m in INSN_RE.finditer(f.read()))
+    finally:
+        os.unlink(log_path)
+    if total == 0:
+        raise RuntimeError("no instruction count in plugin output (is %s libinsn?)" % plugin)
+    return total
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__,
+                                 formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("--bin", required=True, help="ARM build of bench_kernels")
+    ap.add_argument("--qemu", default="qemu-arm")
+    ap.add_argument("--plugin", required=True, help="qemu TCG plugin libinsn.so")
+    ap.add_argument("--iterations", type=int, default=1000)
+    ap.add_argument("--json", help="also write {op: insns_per_op} here")
+    ap.add_argument("ops", nargs="*", help="operations to run (default: all)")
+    args = ap.parse_args()
+
+    if args.iterations <= 0:
+        print("--iterations must be positive", file=sys.stderr)
+        return 1
+
+    try:
+        ops = args.ops or list_ops(args.qemu, args.bin)
+        results = {}
+        print("%-18s %14s" % ("operation", "insns/op"))
+        for op in ops:
+            base = count_insns(args.qemu, args.plugin, args.bin, op, 0)
+            loaded = count_insns(args.qemu, args.plugin, args.bin, op, args.iterations)
+            per_op = (loaded - base) / args.iterations
+            results[op] = round(per_op, 1)
+            print("%-18s %14.1f" % (op, per_op))
+    except (OSError, subprocess.CalledProcessError, RuntimeError) as e:
+        print("bench_arm: %s" % e, file=sys.stderr)
+        return 1
+
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump({"iterations": args.iterations, "insns_per_op": results}, f, indent=2)
+            f.write("\n")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
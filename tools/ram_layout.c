@@ -0,0 +1,61 @@
+/*
+ * SUM Chain Ledger App - RAM Layout Probe
+ *
+ * Compiled (never linked) with the same compiler and flags as the app.
+ * Every value is encoded as the size of a symbol, so tools/ram_report.py can
+ * read offsets and sizes for the target ABI with plain `nm -S`.
+ *
+ * Add new app_state_t fields here; anything missing shows up as
+ * "(unlisted/padding)" in the report.
+ */
+
+#include <stddef.h>
+#include "globals.h"
+#include "tx_display.h"
+
+/* Symbol size = value + 1 (zero-sized arrays are not allowed) */
+#define RAM_LAYOUT_SYM(name, value) \
+    const char ram_layout__##name[(value) + 1] = { 0 };
+
+#define RAM_LAYOUT_TYPE(type) \
+    RAM_LAYOUT_SYM(type##__size, sizeof(type))
+
+#define RAM_LAYOUT_FIELD(type, field) \
+    RAM_LAYOUT_SYM(type##__##field##__off, offsetof(type, field)) \
+    RAM_LAYOUT_SYM(type##__##field##__size, sizeof(((type *)0)->field))
+
+RAM_LAYOUT_TYPE(app_state_t)
+RAM_LAYOUT_FIELD(app_state_t, sign_session)
+RAM_LAYOUT_FIELD(app_state_t, sig_cache)
+RAM_LAYOUT_FIELD(app_state_t, ui_result)
+RAM_LAYOUT_FIELD(app_state_t, work)
+RAM_LAYOUT_FIELD(app_state_t, work_used)
+#ifdef HAVE_APP_STATS
+RAM_LAYOUT_FIELD(app_state_t, stats)
+#endif
+#ifdef HAVE_APP_TRACE
+RAM_LAYOUT_FIELD(app_state_t, trace)
+#endif
+
+RAM_LAYOUT_TYPE(sign_session_t)
+RAM_LAYOUT_FIELD(sign_session_t, initialized)
+RAM_LAYOUT_FIELD(sign_session_t, is_batch)
+RAM_LAYOUT_FIELD(sign_session_t, path)
+RAM_LAYOUT_FIELD(sign_session_t, tx_hash_ctx)
+RAM_LAYOUT_FIELD(sign_session_t, parser)
+RAM_LAYOUT_FIELD(sign_session_t, total_received)
+RAM_LAYOUT_FIELD(sign_session_t, last_chunk_received)
+RAM_LAYOUT_FIELD(sign_session_t, batch)
+
+/* Working-set layouts (union members of app_state_t.work) */
+RAM_LAYOUT_TYPE(work_area_t)
+RAM_LAYOUT_TYPE(work_key_t)
+RAM_LAYOUT_TYPE(work_address_t)
+RAM_LAYOUT_TYPE(work_sign_t)
+RAM_LAYOUT_TYPE(tx_display_t)
+RAM_LAYOUT_TYPE(tx_batch_display_t)
+
+/* Large stack objects */
+RAM_LAYOUT_TYPE(sum_blake3_ctx_t)
+RAM_LAYOUT_TYPE(tx_parser_ctx_t)
+RAM_LAYOUT_TYPE(bip32_path_t)
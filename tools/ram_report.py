@@ -0,0 +1,218 @@
+#!/usr/bin/env python3
+"""
+SUM Chain Ledger App - RAM and stack budget report.
+
+Inputs:
+  * per-function stack frames from `-fstack-usage` (.su files),
+  * the call graph, recovered from `objdump -d` of the linked binary
+    (direct calls and tail calls; indirect calls are not followed),
+  * struct layouts from tools/ram_layout.c compiled with the app's flags.
+
+Prints the worst-case call chain for every APDU handler, the field
+breakdown of app_state_t and the largest static RAM symbols, and exits
+with status 1 when a budget is exceeded.
+"""
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+
+FUNC_RE = re.compile(r"^[0-9a-f]+ <([^>]+)>:$")
+BRANCH_RE = re.compile(
+    r"^\s*[0-9a-f]+:\s+(?:[0-9a-f]{2,8}\s+)*"
+    r"(call\w*|jmp\w*|j[a-z]+|bl?x?(?:[a-z]{2})?(?:\.[nw])?|cbn?z(?:\.[nw])?)\s+"
+    r"[0-9a-f]+ <([^>+]+)>\s*$")
+LAYOUT_RE = re.compile(r"^ram_layout__(\w+?)__(?:(\w+?)__)?(off|size)$")
+RAM_SYM_TYPES = set("bBdDsS")
+
+
+def run(cmd):
+    return subprocess.run(cmd, check=True, stdout=subprocess.PIPE,
+                          universal_newlines=True).stdout
+
+
+def load_stack_usage(dirs):
+    """Return {function: (bytes, qualifier)} from all .su files under dirs."""
+    frames = {}
+    for root_dir in dirs:
+        for dirpath, _, files in os.walk(root_dir):
+            for name in files:
+                if not name.endswith(".su"):
+                    continue
+                with open(os.path.join(dirpath, name)) as f:
+                    for line in f:
+                        parts = line.rstrip("\n").split("\t")
+                        if len(parts) != 3:
+                            continue
+                        func = parts[0].rsplit(":", 1)[-1]
+                        size = int(parts[1])
+                        # Same static helper in several units: keep the largest
+                        if func not in frames or frames[func][0] < size:
+                            frames[func] = (size, parts[2])
+    return frames
+
+
+def load_call_graph(objdump, elf):
+    """Return {function: set(callees)} from the disassembly of elf."""
+    graph = {}
+    current = None
+    for line in run([objdump, "-d", "--no-show-raw-insn", elf]).splitlines():
+        m = FUNC_RE.match(line)
+        if m:
+            current = m.group(1)
+            graph.setdefault(current, set())
+            continue
+        if current is None:
+            continue
+        m = BRANCH_RE.match(line)
+        if m and m.group(2) != current:
+            graph[current].add(m.group(2).split("@")[0])
+    return graph
+
+
+def worst_chain(func, frames, graph, memo, visiting):
+    """Return (total_bytes, chain, recursive) for the deepest path from func."""
+    if func in memo:
+        return memo[func]
+    if func in visiting:
+        return (0, [func + " (recursion)"], True)
+
+    visiting.add(func)
+    own = frames.get(func, (0, ""))[0]
+    best = (0, [], False)
+    recursive = False
+    for callee in sorted(graph.get(func, ())):
+        total, chain, rec = worst_chain(callee, frames, graph, memo, visiting)
+        recursive = recursive or rec
+        if total > best[0] or not best[1]:
+            best = (total, chain, rec)
+    visiting.discard(func)
+
+    result = (own + best[0], [func] + best[1], recursive)
+    memo[func] = result
+    return result
+
+
+def load_layout(nm, obj):
+    """Return {type: {"size": n, "fields": [(name, off, size)]}}."""
+    values = {}
+    for line in run([nm, "-S", "--defined-only", obj]).splitlines():
+        parts = line.split()
+        if len(parts) != 4:
+            continue
+        m = LAYOUT_RE.match(parts[3])
+        if m:
+            values[(m.group(1), m.group(2), m.group(3))] = int(parts[1], 16) - 1
+
+    types = {}
+    for (type_name, field, kind), value in values.items():
+        entry = types.setdefault(type_name, {"size": 0, "fields": {}})
+        if field is None:
+            entry["size"] = value
+        else:
+            entry["fields"].setdefault(field, {})[kind] = value
+    for entry in types.values():
+        entry["fields"] = sorted(
+            ((name, v.get("off", 0), v.get("size", 0)) for name, v in entry["fields"].items()),
+            key=lambda f: f[1])
+    return types
+
+
+def load_ram_symbols(nm, elf):
+    """Return [(size, name)] for .data/.bss symbols of elf, largest first."""
+    syms = []
+    for line in run([nm, "-S", "--size-sort", "--defined-only", elf]).splitlines():
+        parts = line.split()
+        if len(parts) == 4 and parts[2] in RAM_SYM_TYPES:
+            syms.append((int(parts[1], 16), parts[3]))
+    syms.sort(reverse=True)
+    return syms
+
+
+def print_layout(name, entry):
+    print("  %-24s %6d bytes" % (name, entry["size"]))
+    listed = 0
+    for field, off, size in entry["fields"]:
+        print("    %-22s @%5d %6d" % (field, off, size))
+        listed += size
+    if entry["fields"] and entry["size"] > listed:
+        print("    %-22s        %6d" % ("(unlisted/padding)", entry["size"] - listed))
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__,
+                                 formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("--elf", required=True, help="linked binary")
+    ap.add_argument("--su-dir", action="append", required=True,
+                    help="directory searched recursively for .su files")
+    ap.add_argument("--layout-obj", required=True, help="compiled tools/ram_layout.c")
+    ap.add_argument("--objdump", default="objdump")
+    ap.add_argument("--nm", default="nm")
+    ap.add_argument("--roots", default=r"^(handle_\w+|apdu_dispatch)$",
+                    help="regex selecting the entry points to report")
+    ap.add_argument("--stack-budget", type=int, default=0,
+                    help="max worst-case stack per entry point (0 = no check)")
+    ap.add_argument("--state-budget", type=int, default=0,
+                    help="max sizeof(app_state_t) (0 = no check)")
+    ap.add_argument("--top", type=int, default=10, help="static RAM symbols to list")
+    args = ap.parse_args()
+
+    frames = load_stack_usage(args.su_dir)
+    graph = load_call_graph(args.objdump, args.elf)
+    layout = load_layout(args.nm, args.layout_obj)
+    ram_syms = load_ram_symbols(args.nm, args.elf)
+    failed = False
+
+    roots = sorted(f for f in graph if re.match(args.roots, f))
+    memo = {}
+
+    print("Worst-case stack per entry point (bytes):")
+    for root in roots:
+        total, chain, recursive = worst_chain(root, frames, graph, memo, set())
+        over = args.stack_budget and total > args.stack_budget
+        failed = failed or over
+        flags = []
+        if recursive:
+            flags.append("recursion")
+        if any("dynamic" in frames.get(f, (0, ""))[1] for f in chain):
+            flags.append("dynamic frame")
+        if over:
+            flags.append("OVER BUDGET %d" % args.stack_budget)
+        print("  %-28s %6d%s" % (root, total, ("  [" + ", ".join(flags) + "]") if flags else ""))
+        print("    " + " -> ".join(
+            "%s(%s)" % (f, frames[f][0] if f in frames else "?") for f in chain))
+
+    unknown = sorted({f for r in roots for f in memo.get(r, (0, [], False))[1]
+                      if f not in frames and "(recursion)" not in f})
+    if unknown:
+        print("  no stack data (SDK/libc, counted as 0): " + ", ".join(unknown))
+
+    print("")
+    print("Struct layout:")
+    for name in ("app_state_t", "sign_session_t"):
+        if name in layout:
+            print_layout(name, layout[name])
+    for name in sorted(layout):
+        if name not in ("app_state_t", "sign_session_t"):
+            print_layout(name, layout[name])
+
+    state_size = layout.get("app_state_t", {"size": 0})["size"]
+    if args.state_budget and state_size > args.state_budget:
+        print("  app_state_t OVER BUDGET %d" % args.state_budget)
+        failed = True
+
+    print("")
+    print("Largest static RAM symbols (total %d bytes):" % sum(s for s, _ in ram_syms))
+    for size, name in ram_syms[:args.top]:
+        print("  %-32s %6d" % (name, size))
+
+    if failed:
+        print("\nRAM report: budget exceeded", file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
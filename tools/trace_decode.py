@@ -0,0 +1,142 @@
+#!/usr/bin/env python3
+"""
+SUM Chain Ledger App - GET_TRACE decoder.
+
+Reads GET_TRACE (INS 0x0A) responses as hex, one page per line (P1 = 0, 1,
+2 in order; a trailing 9000 status word is ignored), and prints the events
+as a timeline. A session starts at the first chunk (P1 = 0x00) of SIGN_TX,
+SIGN_MERKLE or SIGN_HASH; every line shows the time since the session
+started and since the previous event. Events before the first session are
+printed as "pre-session".
+
+Usage:
+  trace_decode.py [pages.txt]      (default: stdin)
+
+Only debug builds (make DEBUG=1) answer GET_TRACE; the response format is
+described in src/app_trace.h.
+"""
+
+import argparse
+import struct
+import sys
+
+FORMAT = 1
+HEADER_LEN = 10
+ENTRY_LEN = 8
+
+INS_NAMES = {
+    0x00: "GET_VERSION", 0x01: "GET_APP_NAME", 0x02: "GET_PUBLIC_KEY",
+    0x03: "GET_ADDRESS", 0x04: "SIGN_TX", 0x05: "GET_STATS",
+    0x06: "SIGN_MERKLE", 0x07: "SIGN_HASH", 0x08: "RESUME", 0x09: "GET_XPUB",
+}
+SESSION_INS = (0x04, 0x06, 0x07)
+
+# tx_parse_state_t (src/globals.h)
+PARSE_STATES = [
+    "INIT", "VERSION", "CHAIN_ID", "SENDER", "NONCE", "GAS_PRICE", "GAS_LIMIT",
+    "TX_TYPE", "RECIPIENT", "AMOUNT", "DATA_LEN", "DATA", "RECIPIENT_COUNT",
+    "DONE", "ERROR",
+]
+UI_KINDS = ["tx", "pair", "batch", "hash"]          # app_trace_ui_t
+UI_RESULTS = ["none", "approved", "rejected"]       # ui_result_t
+SCHEMES = ["slip10", "bip32-ed25519"]               # PATH_SCHEME_*
+
+
+def name(table, i):
+    if isinstance(table, dict):
+        return table.get(i, "0x%02X" % i)
+    return table[i] if i < len(table) else str(i)
+
+
+def describe(event, arg, value):
+    if event == 1:
+        return "APDU_RX      %s p1=0x%02X lc=%d" % (name(INS_NAMES, arg), value >> 8, value & 0xFF)
+    if event == 2:
+        return "APDU_SW      %s sw=%04X" % (name(INS_NAMES, arg), value)
+    if event == 3:
+        return "PARSE_STATE  -> %s at byte %d" % (name(PARSE_STATES, arg), value)
+    if event == 4:
+        return "HASH_UPDATE  %d bytes" % value
+    if event == 5:
+        return "HASH_FINAL"
+    if event == 6:
+        return "DERIVE_BEGIN depth %d, %s" % (arg, name(SCHEMES, value))
+    if event == 7:
+        return "DERIVE_END   %s" % ("ok" if arg else "failed")
+    if event == 8:
+        return "UI_SHOW      %s" % name(UI_KINDS, arg)
+    if event == 9:
+        return "UI_DECISION  %s" % name(UI_RESULTS, arg)
+    return "event %d arg=%d value=%d" % (event, arg, value)
+
+
+def parse_pages(lines):
+    events = []
+    tick_us = total = held = None
+    for line in lines:
+        line = line.strip().replace(" ", "")
+        if not line or line.startswith("#"):
+            continue
+        data = bytes.fromhex(line)
+        if len(data) % ENTRY_LEN != HEADER_LEN % ENTRY_LEN and data[-2:] == b"\x90\x00":
+            data = data[:-2]
+        if len(data) < HEADER_LEN or (len(data) - HEADER_LEN) % ENTRY_LEN:
+            raise ValueError("not a GET_TRACE page: %d bytes" % len(data))
+        fmt, held, tick_us, total = struct.unpack(">BBII", data[:HEADER_LEN])
+        if fmt != FORMAT:
+            raise ValueError("unsupported trace format %d" % fmt)
+        for off in range(HEADER_LEN, len(data), ENTRY_LEN):
+            events.append(struct.unpack(">IBBH", data[off:off + ENTRY_LEN]))
+    if tick_us is None:
+        raise ValueError("no pages")
+    if len(events) != held:
+        raise ValueError("pages hold %d events, header says %d (missing pages?)"
+                         % (len(events), held))
+    return tick_us, total, events
+
+
+def render(tick_us, total, events, out):
+    if total > len(events):
+        out.write("(%d older events overwritten)\n" % (total - len(events)))
+
+    def starts_session(event, arg, value):
+        return event == 1 and arg in SESSION_INS and (value >> 8) == 0x00
+
+    session = 0
+    start = prev = events[0][0] if events else 0
+    if events and not starts_session(*events[0][1:]):
+        out.write("== pre-session ==\n")
+    for time, event, arg, value in events:
+        if starts_session(event, arg, value):
+            session += 1
+            start = time
+            out.write("\n== session %d: %s ==\n" % (session, name(INS_NAMES, arg)))
+        rel = ((time - start) & 0xFFFFFFFF) * tick_us / 1000.0
+        delta = ((time - prev) & 0xFFFFFFFF) * tick_us / 1000.0
+        out.write("%10.3f ms  +%9.3f  %s\n" % (rel, delta, describe(event, arg, value)))
+        prev = time
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__,
+                                 formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("pages", nargs="?", help="file with one hex page per line (default: stdin)")
+    args = ap.parse_args()
+
+    try:
+        if args.pages:
+            with open(args.pages) as f:
+                lines = f.readlines()
+        else:
+            lines = sys.stdin.readlines()
+        tick_us, total, events = parse_pages(lines)
+    except (OSError, ValueError) as e:
+        print("trace_decode: %s" % e, file=sys.stderr)
+        return 1
+
+    render(tick_us, total, events, sys.stdout)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())